@@ -0,0 +1,38 @@
+#pragma once
+
+// 主机端基准测试框架：用例通过 BENCH_CASE 在静态初始化阶段注册，
+// 由 bench_main.cpp 中的运行器按名称过滤后依次执行
+
+#include <stdint.h>
+
+typedef void (*BenchFunction)();
+
+struct BenchCase {
+    const char *name;
+    BenchFunction function;
+    BenchCase *next;
+
+    BenchCase(const char *name, BenchFunction function);
+};
+
+#define BENCH_CASE(id)                                  \
+    static void bench_##id();                           \
+    static BenchCase benchCase_##id(#id, bench_##id);   \
+    static void bench_##id()
+
+// 真实（墙钟）单调时间，与固件使用的虚拟时钟无关
+uint64_t benchNowNs();
+
+// CPU 周期计数（x86 为 TSC，其他架构退化为纳秒）
+uint64_t benchNowCycles();
+
+// 输出一行结果：平均每个 unit 的耗时；结果同时由运行器记录，用于 --json 输出和 --baseline 比较
+void benchReport(const char *name, const char *unit, uint64_t count, uint64_t elapsedNs);
+void benchReportCycles(const char *name, const char *unit, uint64_t count, uint64_t cycles);
+
+// 防止编译器把被测结果优化掉
+template <typename T>
+inline void benchKeep(T const &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
@@ -0,0 +1,183 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <NimBLEDevice.h>
+#include "../src/state_machine.h"
+#include "../include/advertising_controller.h"
+#include "../include/advertising_schedule.h"
+#include "../include/app_tasks.h"
+#include "../include/button_engine.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+
+extern NimBLEServer *pServer;
+
+// 改造前 Pairing::entry() 和 startPairing() 中的广播重启序列，仅用于对比
+static void legacyPairingRestart(NimBLEAdvertising *advertising)
+{
+    if (advertising->isAdvertising())
+    {
+        advertising->stop();
+        delay(100);
+    }
+    advertising->start();
+    advertising->stop();
+    delay(1000);
+    advertising->start();
+}
+
+// 以 10ms 为步长推进虚拟时间并由后台任务分发，记录单次分发占用的最长虚拟时间（即阻塞时间）
+static uint64_t maxStepUs = 0;
+
+static void runForMs(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += 10)
+    {
+        hostsim::advanceMillis(10);
+        uint64_t startUs = hostsim::nowMicros();
+        AppTasks::housekeepingStep(0);
+        uint64_t stepUs = hostsim::nowMicros() - startUs;
+        if (stepUs > maxStepUs)
+        {
+            maxStepUs = stepUs;
+        }
+    }
+    Logger::drain();
+}
+
+static void report(const char *name, uint64_t latencyUs, uint32_t starts, uint32_t retries)
+{
+    printf("%-36s %8.3f ms to advertising, %u starts, %u retries, max blocking %6.3f ms\n", name,
+           latencyUs / 1000.0, starts, retries, maxStepUs / 1000.0);
+}
+
+// 从按键长按判定（或断开事件）到广播重新启动的时间，以及状态机分发期间的阻塞时间；
+// 主机端 NimBLE 替身在 start() 成功时即视为发出第一个广播包
+BENCH_CASE(pairing_advertise)
+{
+    hostsim::reset();
+    setup(); // InitComplete -> Reconnect
+    Logger::drain();
+    NimBLEAdvertising *advertising = pServer->getAdvertising();
+
+    // 改造前：一次进入配对要阻塞 1.1s，重启两次广播
+    maxStepUs = 0;
+    uint32_t startsBefore = hostsim::advertisingStartCount();
+    uint64_t legacyStartUs = hostsim::nowMicros();
+    legacyPairingRestart(advertising);
+    maxStepUs = hostsim::nowMicros() - legacyStartUs;
+    report("pairing_advertise.legacy", hostsim::lastAdvertisingStartUs() - legacyStartUs,
+           hostsim::advertisingStartCount() - startsBefore, 0);
+
+    // 按住按键：到达长按阈值时投递事件，进入 Pairing 时立即重新启动广播
+    maxStepUs = 0;
+    AdvertisingController::resetStats();
+    startsBefore = hostsim::advertisingStartCount();
+    uint64_t pressUs = hostsim::nowMicros();
+    hostsim::setPinLevel(BOOT_BUTTON_PIN, LOW);
+    runForMs(ButtonEngine::HOLD_LEVELS_MS[0] + 100);
+    hostsim::setPinLevel(BOOT_BUTTON_PIN, HIGH);
+    runForMs(100);
+    uint64_t thresholdUs = pressUs + ButtonEngine::HOLD_LEVELS_MS[0] * 1000ull;
+    AdvertisingController::Stats stats = AdvertisingController::stats();
+    if (!BleMouseState::is_in_state<Pairing>() || !advertising->isAdvertising())
+    {
+        printf("pairing_advertise.button: 未进入配对广播\n");
+    }
+    report("pairing_advertise.button", hostsim::lastAdvertisingStartUs() - thresholdUs,
+           hostsim::advertisingStartCount() - startsBefore, stats.retries);
+
+    // 协议栈忙：前 3 次启动失败，由重试定时器完成启动，期间不阻塞分发
+    EventQueue::post(EventQueue::EventId::PAIRING_TIMEOUT);
+    runForMs(10);
+    maxStepUs = 0;
+    AdvertisingController::resetStats();
+    startsBefore = hostsim::advertisingStartCount();
+    hostsim::failAdvertisingStarts(3);
+    uint64_t busyUs = hostsim::nowMicros();
+    EventQueue::post(EventQueue::EventId::BOOT_LONG_PRESS);
+    runForMs(200);
+    stats = AdvertisingController::stats();
+    if (!advertising->isAdvertising() || stats.retries != 3)
+    {
+        printf("pairing_advertise.busy: 广播 %d，重试 %u 次（期望 3 次）\n", advertising->isAdvertising(),
+               stats.retries);
+    }
+    report("pairing_advertise.busy", hostsim::lastAdvertisingStartUs() - busyUs,
+           hostsim::advertisingStartCount() - startsBefore, stats.retries);
+
+    // 连接后停止广播，断开后进入 Reconnect 重新开始广播
+    hostsim::connect();
+    runForMs(20);
+    if (advertising->isAdvertising())
+    {
+        printf("pairing_advertise.disconnect: 连接后仍在广播\n");
+    }
+    maxStepUs = 0;
+    AdvertisingController::resetStats();
+    startsBefore = hostsim::advertisingStartCount();
+    uint64_t disconnectUs = hostsim::nowMicros();
+    hostsim::disconnect();
+    runForMs(20);
+    stats = AdvertisingController::stats();
+    report("pairing_advertise.disconnect", hostsim::lastAdvertisingStartUs() - disconnectUs,
+           hostsim::advertisingStartCount() - startsBefore, stats.retries);
+}
+
+// 各广播计划在没有主机连接时持续运行：每个阶段的广播时间和估算的广播事件数，
+// 与改造前始终以 30~60ms 广播（平均 45ms 加上平均 5ms 的 advDelay，约 20 次/s）对比
+BENCH_CASE(advertising_schedules)
+{
+    const double legacyEventsPerS = 1000.0 / 50.0;
+
+    for (int id = 0; id < (int)AdvertisingSchedule::ScheduleId::COUNT; id++)
+    {
+        AdvertisingSchedule::ScheduleId schedule = (AdvertisingSchedule::ScheduleId)id;
+        // 配对在 60s 后超时，其他计划运行 10 分钟
+        const uint32_t runMs = schedule == AdvertisingSchedule::ScheduleId::PAIRING ? 60000 : 600000;
+        hostsim::reset();
+        hostsim::setBonded(schedule == AdvertisingSchedule::ScheduleId::RECONNECT_BONDED);
+        setup(); // InitComplete -> Reconnect
+        Logger::drain();
+        if (schedule == AdvertisingSchedule::ScheduleId::RECONNECT_BONDED)
+        {
+            AdvertisingSchedule::setPeer(NimBLEDevice::getBondedAddress(0));
+        }
+        AdvertisingSchedule::resetStats();
+        uint64_t wallStart = benchNowNs();
+        AdvertisingSchedule::start(schedule, micros());
+        runForMs(runMs);
+        uint64_t wallNs = benchNowNs() - wallStart;
+
+        // 除最后一个阶段外，每个阶段的广播时间应与计划一致（允许一个 10ms 分发步长的误差）
+        uint32_t events = 0;
+        uint32_t mismatches = 0;
+        uint32_t stageStartMs = 0;
+        char name[64];
+        for (uint8_t i = 0; i < AdvertisingSchedule::stageCount(schedule); i++)
+        {
+            AdvertisingSchedule::StageStats stats = AdvertisingSchedule::stageStats(schedule, i);
+            events += stats.events;
+            snprintf(name, sizeof(name), "  %s", AdvertisingSchedule::stageName(schedule, i));
+            printf("%-40s %u entries, %7.1f s, %6u events, %5.1f events/s\n", name, stats.entries,
+                   stats.activeMs / 1000.0, stats.events, stats.activeMs ? stats.events * 1000.0 / stats.activeMs : 0.0);
+            uint32_t untilMs = AdvertisingSchedule::stages(schedule)[i].untilMs;
+            uint32_t expectedMs = (untilMs && untilMs < runMs ? untilMs : runMs) - stageStartMs;
+            if (stats.entries != 1 || stats.activeMs + 20 < expectedMs || stats.activeMs > expectedMs + 20)
+            {
+                mismatches++;
+            }
+            stageStartMs += expectedMs;
+        }
+        if (!pServer->getAdvertising()->isAdvertising())
+        {
+            mismatches++;
+        }
+        snprintf(name, sizeof(name), "advertising_schedules.%s", AdvertisingSchedule::name(schedule));
+        printf("%-40s %6u events in %u s, %5.1f events/s (legacy %4.1f, %5.1f%%), %u mismatches, %.0f ms wall\n", name,
+               events, runMs / 1000, events * 1000.0 / runMs, legacyEventsPerS,
+               events * 100000.0 / runMs / legacyEventsPerS, mismatches, wallNs / 1e6);
+        AdvertisingSchedule::stop();
+    }
+}
@@ -0,0 +1,124 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <vector>
+#include "../include/app_tasks.h"
+#include "../include/button_engine.h"
+
+typedef ButtonEngine::Gesture Gesture;
+
+// 按键脚本：按时间排列的电平变化，以及期望识别出的手势序列
+struct ButtonScript {
+    const char *name;
+    std::vector<uint32_t> edgesMs;   // 依次为按下、松开、按下……的时刻
+    std::vector<Gesture> expected;
+};
+
+// 抖动档位：每个边沿回弹的次数和持续时间
+struct BounceProfile {
+    const char *name;
+    uint8_t bounces;
+    uint32_t spanUs;
+};
+
+struct Captured {
+    Gesture gesture;
+    uint32_t delayUs;   // 接收时刻相对 originUs 的延迟
+};
+
+static std::vector<Captured> captured;
+
+static void captureEvent(const ButtonEngine::Event &event, void *)
+{
+    Captured entry = {event.gesture, (uint32_t)esp_timer_get_time() - event.originUs};
+    captured.push_back(entry);
+}
+
+// 每个脚本在每种抖动下运行一次，逐个比对识别结果；噪声尖峰不应产生任何事件
+BENCH_CASE(button_gestures)
+{
+    const ButtonScript scripts[] = {
+        {"click", {0, 120}, {Gesture::SHORT_PRESS}},
+        {"double", {0, 100, 250, 350}, {Gesture::DOUBLE_CLICK}},
+        {"triple", {0, 100, 250, 350, 500, 600}, {Gesture::TRIPLE_CLICK}},
+        {"two_clicks", {0, 100, 500, 600}, {Gesture::SHORT_PRESS, Gesture::SHORT_PRESS}},
+        {"medium", {0, 1500}, {}},
+        {"long", {0, 4000}, {Gesture::LONG_PRESS}},
+        {"very_long", {0, 9000}, {Gesture::LONG_PRESS, Gesture::VERY_LONG_PRESS}},
+        {"click_then_hold", {0, 100, 250, 3500}, {Gesture::LONG_PRESS}},
+    };
+    const BounceProfile profiles[] = {
+        {"clean", 0, 0},
+        {"light", 3, 1500},
+        {"heavy", 10, 6000},
+    };
+
+    for (const BounceProfile &profile : profiles)
+    {
+        uint32_t mismatches = 0;
+        uint32_t maxDelayUs = 0;
+        hostsim::reset();
+        ButtonEngine::begin(BOOT_BUTTON_PIN, captureEvent, nullptr);
+        ButtonEngine::resetStats();
+
+        uint64_t wallStart = benchNowNs();
+        for (const ButtonScript &script : scripts)
+        {
+            captured.clear();
+            uint64_t startUs = hostsim::nowMicros();
+            for (size_t i = 0; i < script.edgesMs.size(); i++)
+            {
+                uint64_t edgeUs = startUs + script.edgesMs[i] * 1000ull;
+                hostsim::advanceMicros(edgeUs - hostsim::nowMicros());
+                hostsim::bouncePin(BOOT_BUTTON_PIN, i % 2 == 0 ? LOW : HIGH, profile.bounces, profile.spanUs);
+            }
+            hostsim::advanceMillis(2000); // 等待最后一个手势判定
+
+            bool match = captured.size() == script.expected.size();
+            for (size_t i = 0; match && i < captured.size(); i++)
+            {
+                match = captured[i].gesture == script.expected[i];
+            }
+            for (const Captured &entry : captured)
+            {
+                if (entry.delayUs > maxDelayUs)
+                {
+                    maxDelayUs = entry.delayUs;
+                }
+            }
+            if (!match)
+            {
+                mismatches++;
+                printf("button_gestures.%s.%s: 期望 %u 个手势，识别出 %u 个:", profile.name, script.name,
+                       (unsigned)script.expected.size(), (unsigned)captured.size());
+                for (const Captured &entry : captured)
+                {
+                    printf(" %s", ButtonEngine::name(entry.gesture));
+                }
+                printf("\n");
+            }
+        }
+
+        // 空闲时的 200us 干扰脉冲
+        captured.clear();
+        hostsim::schedulePinLevel(BOOT_BUTTON_PIN, LOW, 0);
+        hostsim::schedulePinLevel(BOOT_BUTTON_PIN, HIGH, 200);
+        hostsim::advanceMillis(1000);
+        if (!captured.empty())
+        {
+            mismatches++;
+            printf("button_gestures.%s.spike: 干扰脉冲产生了 %u 个手势\n", profile.name, (unsigned)captured.size());
+        }
+        uint64_t wallNs = benchNowNs() - wallStart;
+
+        ButtonEngine::Stats stats = ButtonEngine::stats();
+        char name[64];
+        snprintf(name, sizeof(name), "button_gestures.%s", profile.name);
+        printf("%-32s %u scripts, %u mismatches, %5u edges, %3u transitions, %2u glitches, "
+               "max decision delay %5u us, %.1f ms wall\n",
+               name, (unsigned)(sizeof(scripts) / sizeof(scripts[0]) + 1), mismatches, stats.edges,
+               stats.transitions, stats.glitches, maxDelayUs, wallNs / 1e6);
+    }
+}
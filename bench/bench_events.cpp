@@ -0,0 +1,79 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/state_machine.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+
+// 多线程压力：4 个生产者线程各投递一种事件，队列满时让出 CPU 后重试，测试线程作为唯一消费者持续分发。
+// 选用的事件在 Reconnect 状态下都不引起状态转换，只测量队列本身的吞吐和延迟；
+// 分发数与投递数一致的断言在 test/test_event_queue 中
+BENCH_CASE(event_queue_stress)
+{
+    hostsim::reset();
+    setup();
+    if (!BleMouseState::is_in_state<Reconnect>())
+    {
+        printf("event_queue_stress: 未能进入 Reconnect 状态\n");
+        return;
+    }
+    Logger::drain();
+
+    const EventQueue::EventId ids[] = {
+        EventQueue::EventId::BOOT_SHORT_PRESS,
+        EventQueue::EventId::DEVICE_DISCONNECTED,
+        EventQueue::EventId::PAIRING_TIMEOUT,
+        EventQueue::EventId::INIT_COMPLETE,
+    };
+    const int producers = sizeof(ids) / sizeof(ids[0]);
+    const uint32_t perProducer = 50000;
+
+    hostsim::setRealTime(true);
+    EventQueue::resetStats();
+    std::atomic<int> running(producers);
+    std::vector<uint32_t> accepted(producers, 0);
+    std::vector<std::thread> threads;
+
+    uint64_t start = benchNowNs();
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+                             {
+                                 for (uint32_t i = 0; i < perProducer; i++)
+                                 {
+                                     while (!EventQueue::post(ids[p]))
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                     accepted[p]++;
+                                 }
+                                 running--; });
+    }
+    while (running.load() > 0)
+    {
+        EventQueue::dispatchAll();
+    }
+    EventQueue::dispatchAll();
+    uint64_t elapsed = benchNowNs() - start;
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    hostsim::setRealTime(false);
+
+    EventQueue::Stats stats = EventQueue::stats();
+
+    benchReport("event_queue_stress", "event", stats.dispatched, elapsed);
+    printf("%-32s posted %u, full %u, dispatched %u, max depth %u/%u, max latency %u us, "
+           "mean %.1f us, state %s\n",
+           "event_queue_stress.stats", stats.posted, stats.dropped, stats.dispatched, stats.maxDepth,
+           (unsigned)EventQueue::QUEUE_SIZE, stats.maxLatencyUs,
+           stats.dispatched ? (double)stats.totalLatencyUs / stats.dispatched : 0.0,
+           BleMouseState::is_in_state<Reconnect>() ? "Reconnect" : "changed");
+    Logger::resetStats();
+    Logger::drain();
+}
@@ -0,0 +1,187 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/conn_params.h"
+#include "../include/logger.h"
+#include "../include/event_queue.h"
+
+// 虚拟时间中的一次仿真迭代：各任务（含日志任务）的执行体依次运行一次，然后推进 10ms
+// （按键消抖和手势定时器在推进虚拟时钟时执行）
+static void runTicks(unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        AppTasks::housekeepingStep(0);
+        AppTasks::motionStep();
+        Logger::drain();
+        delay(10);
+    }
+}
+
+// 上电、连接并在需要时短按 BOOT 键，使固件进入 MouseMotionEnable 状态
+// （之前的用例可能已让状态机记住鼠标移动为启用）
+static bool bringUpMotion()
+{
+    hostsim::reset();
+    setup();
+    hostsim::connect();
+    runTicks(10); // 后台任务分发连接回调投递的事件
+
+    if (!BleMouseState::is_in_state<MouseMotionEnable>())
+    {
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, LOW);
+        runTicks(20); // 按住 200ms
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, HIGH);
+        runTicks(30); // 等待双击间隔结束后判定为短按
+    }
+
+    return BleMouseState::is_in_state<MouseMotionEnable>();
+}
+
+// 完整的一次迭代：事件分发、连接检查、运动计算和 notify()
+BENCH_CASE(firmware_loop)
+{
+    if (!bringUpMotion())
+    {
+        printf("firmware_loop: 未能进入 MouseMotionEnable 状态\n");
+        return;
+    }
+
+    const unsigned int iterations = 200000;
+    uint32_t reportsBefore = hostsim::notifyCount();
+    uint64_t start = benchNowNs();
+    runTicks(iterations);
+    uint64_t elapsed = benchNowNs() - start;
+    uint32_t reports = hostsim::notifyCount() - reportsBefore;
+
+    benchReport("firmware_loop", "iter", iterations, elapsed);
+    benchReport("firmware_loop", "report", reports, elapsed);
+
+    const ReportPipeline::Stats &stats = AppTasks::reportStats();
+    printf("%-32s submitted %u, coalesced %u, dropped %u, sent %u, failed %u\n", "firmware_loop.reports",
+           stats.submitted, stats.coalesced, stats.dropped, stats.sent, stats.failed);
+
+    const ConnParams::Diagnostics &conn = ConnParams::diagnostics();
+    printf("%-32s profile %d, interval %.2f ms, latency %u, timeout %u ms, %u requests, %u updates\n",
+           "firmware_loop.conn", (int)conn.profile, conn.interval * 1.25, conn.latency,
+           conn.timeout * 10, conn.requests, conn.updates);
+}
+
+// 按速率档位的周期运行运动任务，后台任务保持 10ms，虚拟时钟以 500us 推进
+static void runFor(uint32_t durationMs)
+{
+    uint64_t endUs = hostsim::nowMicros() + durationMs * 1000ull;
+    uint64_t nextMotionUs = hostsim::nowMicros();
+    uint64_t nextTickUs = hostsim::nowMicros();
+    while (hostsim::nowMicros() < endUs)
+    {
+        uint64_t nowUs = hostsim::nowMicros();
+        if (nowUs >= nextTickUs)
+        {
+            AppTasks::housekeepingStep(0);
+            Logger::drain();
+            nextTickUs += 10000;
+        }
+        if (nowUs >= nextMotionUs)
+        {
+            AppTasks::motionStep();
+            nextMotionUs += ReportPipeline::rateIntervalUs(AppTasks::reportRate());
+        }
+        hostsim::advanceMicros(500);
+    }
+}
+
+// 每个速率档位依次经历通畅、拥塞（协议栈 4 个缓冲，每 25ms 才发出一份）、恢复三个阶段
+BENCH_CASE(report_rate_modes)
+{
+    static const char *const names[] = {"25Hz", "50Hz", "100Hz", "133Hz"};
+    static const char *const phases[] = {"clear", "congested", "recovered"};
+    for (int mode = 0; mode < (int)ReportPipeline::RateMode::COUNT; mode++)
+    {
+        AppTasks::setReportRate((ReportPipeline::RateMode)mode);
+        if (!bringUpMotion())
+        {
+            printf("report_rate_modes: 未能进入 MouseMotionEnable 状态\n");
+            return;
+        }
+
+        for (int phase = 0; phase < 3; phase++)
+        {
+            hostsim::setNotifyBuffers(phase == 1 ? 4 : 0, 25000);
+            ReportPipeline::Stats before = AppTasks::reportStats();
+            uint32_t failuresBefore = hostsim::notifyFailureCount();
+            const uint32_t phaseMs = 10000;
+            runFor(phaseMs);
+            const ReportPipeline::Stats &after = AppTasks::reportStats();
+
+            char name[64];
+            snprintf(name, sizeof(name), "report_rate_modes.%s.%s", names[mode], phases[phase]);
+            printf("%-40s %6.1f reports/s, failed %4u, backoffs %3u, ramp-ups %3u, level %u, interval %5.1f ms\n",
+                   name, (after.sent - before.sent) * 1000.0 / phaseMs,
+                   hostsim::notifyFailureCount() - failuresBefore, after.backoffs - before.backoffs,
+                   after.rampUps - before.rampUps, AppTasks::reportBackoffLevel(),
+                   AppTasks::reportIntervalUs() / 1000.0);
+        }
+    }
+    AppTasks::setReportRate(ReportPipeline::RateMode::HZ_100);
+}
+
+static void printTaskStats(const char *name, AppTasks::TaskId id)
+{
+    const AppTasks::TaskStats &stats = AppTasks::stats(id);
+    printf("%-32s %8u runs, max late %6u us, max run %6u us\n", name,
+           stats.iterations, stats.maxLateUs, stats.maxRunUs);
+}
+
+// 在真实时钟下以线程运行各任务，测量调度延迟和报告速率
+BENCH_CASE(tasks_schedule)
+{
+    hostsim::reset();
+    hostsim::setRealTime(true);
+    setup();
+    hostsim::connect();
+    delay(100); // 后台任务分发连接回调投递的事件
+
+    if (!BleMouseState::is_in_state<MouseMotionEnable>())
+    {
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, LOW);
+        delay(200);
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, HIGH);
+        delay(400);
+    }
+
+    const unsigned long runMs = 3000;
+    AppTasks::resetStats();
+    EventQueue::resetStats();
+    uint32_t reportsBefore = hostsim::notifyCount();
+    delay(runMs / 2);
+    // 运行中三击（恢复默认速率），测量手势判定到状态机分发的延迟
+    for (int i = 0; i < 3; i++)
+    {
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, LOW);
+        delay(60);
+        hostsim::setPinLevel(BOOT_BUTTON_PIN, HIGH);
+        delay(60);
+    }
+    delay(runMs / 2 - 360);
+    uint32_t reports = hostsim::notifyCount() - reportsBefore;
+    hostsim::stopTasks();
+    hostsim::setRealTime(false);
+
+    if (!BleMouseState::is_in_state<MouseMotionEnable>())
+    {
+        printf("tasks_schedule: 未能进入 MouseMotionEnable 状态\n");
+        return;
+    }
+    printf("%-32s %8.1f reports/s\n", "tasks_schedule", reports * 1000.0 / runMs);
+    printTaskStats("tasks_schedule.motion", AppTasks::TaskId::MOTION);
+    printTaskStats("tasks_schedule.housekeeping", AppTasks::TaskId::HOUSEKEEPING);
+
+    EventQueue::Stats events = EventQueue::stats();
+    const EventQueue::EventStats &triple = events.events[(int)EventQueue::EventId::BOOT_TRIPLE_CLICK];
+    printf("%-32s %8u gestures, max latency %6u us\n", "tasks_schedule.button", triple.dispatched,
+           triple.maxLatencyUs);
+}
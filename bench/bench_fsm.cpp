@@ -0,0 +1,152 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <NimBLEDevice.h>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+#include "../include/settings_store.h"
+
+extern NimBLEServer *pServer;
+extern bool deviceConnected;
+
+// 改造前 loop() 每次迭代（10ms）都执行的状态轮询链：连接检查和三个 is_in_state<> 分支各自的
+// LED 闪烁计时（运动计算已移到运动任务，不计入），仅用于对比每次迭代的开销
+static unsigned long legacyLastConnectionCheck = 0;
+static unsigned long legacyLastBlinkTime = 0;
+static bool legacyLedState = false;
+
+static void legacyBlink(unsigned long intervalMs, bool alternate)
+{
+    unsigned long currentTime = millis();
+    if (currentTime - legacyLastBlinkTime >= intervalMs)
+    {
+        legacyLedState = !legacyLedState;
+        digitalWrite(12, legacyLedState ? HIGH : LOW);
+        digitalWrite(13, (legacyLedState != alternate) ? HIGH : LOW);
+        legacyLastBlinkTime = currentTime;
+    }
+}
+
+static void legacyStatePolling()
+{
+    if (millis() - legacyLastConnectionCheck > 1000)
+    {
+        int connectedCount = pServer ? pServer->getConnectedCount() : 0;
+        benchKeep(connectedCount);
+        legacyLastConnectionCheck = millis();
+    }
+    if (BleMouseState::is_in_state<Pairing>())
+    {
+        legacyBlink(333, false);
+    }
+    if (BleMouseState::is_in_state<Reconnect>())
+    {
+        legacyBlink(1000, false);
+    }
+    if (BleMouseState::is_in_state<MouseMotionEnable>())
+    {
+        legacyBlink(250, true);
+    }
+}
+
+// 新的后台任务一次唤醒中与状态相关的工作：计算休眠时间、分发（空）事件队列；
+// 状态超时由 TimerService 投递事件，没有逐状态的轮询
+static void tickIteration()
+{
+    uint32_t waitMs = AppTasks::msUntilHousekeeping(millis());
+    benchKeep(waitMs);
+    EventQueue::dispatchAll();
+}
+
+static bool enterState(int index)
+{
+    hostsim::reset();
+    setup(); // InitComplete -> Reconnect
+    if (index >= 1)
+    {
+        EventQueue::post(EventQueue::EventId::BOOT_LONG_PRESS);
+        EventQueue::dispatchAll();
+    }
+    if (index >= 2)
+    {
+        hostsim::connect();
+        EventQueue::dispatchAll();
+        if (!BleMouseState::is_in_state<MouseMotionEnable>())
+        {
+            EventQueue::post(EventQueue::EventId::BOOT_SHORT_PRESS);
+            EventQueue::dispatchAll();
+        }
+    }
+    Logger::drain();
+    switch (index)
+    {
+    case 0:
+        return BleMouseState::is_in_state<Reconnect>();
+    case 1:
+        return BleMouseState::is_in_state<Pairing>();
+    default:
+        return BleMouseState::is_in_state<MouseMotionEnable>();
+    }
+}
+
+// 每种状态下对比两种方式每次迭代的耗时，并在虚拟时间中统计 60s 内后台任务的唤醒次数：
+// 改造前固定 10ms 一次，改造后只在事件（状态超时由 TimerService 投递）或最长休眠时间到达时唤醒
+BENCH_CASE(fsm_tick)
+{
+    static const char *const names[] = {"Reconnect", "Pairing", "MouseMotionEnable"};
+    const unsigned int iterations = 1000000;
+
+    for (int index = 0; index < 3; index++)
+    {
+        if (!enterState(index))
+        {
+            printf("fsm_tick: 未能进入 %s 状态\n", names[index]);
+            continue;
+        }
+
+        char name[64];
+        uint64_t start = benchNowNs();
+        for (unsigned int i = 0; i < iterations; i++)
+        {
+            legacyStatePolling();
+        }
+        snprintf(name, sizeof(name), "fsm_tick.%s.polling", names[index]);
+        benchReport(name, "iter", iterations, benchNowNs() - start);
+
+        start = benchNowNs();
+        for (unsigned int i = 0; i < iterations; i++)
+        {
+            tickIteration();
+        }
+        snprintf(name, sizeof(name), "fsm_tick.%s.tick", names[index]);
+        benchReport(name, "iter", iterations, benchNowNs() - start);
+
+        // 唤醒次数：虚拟时钟以 1ms 推进，只在有事件投递（含到期的状态超时）或设置的写入时间到达时唤醒
+        const uint32_t runMs = 60000;
+        uint32_t endMs = millis() + runMs;
+        uint32_t wakeups = 0;
+        uint32_t posted = EventQueue::stats().posted;
+        uint32_t waitMs = AppTasks::msUntilHousekeeping(millis());
+        uint32_t sleepStartMs = millis();
+        while ((int32_t)(endMs - millis()) > 0)
+        {
+            hostsim::advanceMillis(1);
+            if (EventQueue::stats().posted == posted &&
+                (waitMs == AppTasks::NO_DEADLINE || millis() - sleepStartMs < waitMs))
+            {
+                continue;
+            }
+            AppTasks::housekeepingStep(0);
+            wakeups++;
+            posted = EventQueue::stats().posted;
+            waitMs = AppTasks::msUntilHousekeeping(millis());
+            sleepStartMs = millis();
+        }
+        Logger::drain();
+        snprintf(name, sizeof(name), "fsm_tick.%s.wakeups", names[index]);
+        printf("%-40s polling %u / tick %u per %us\n", name, runMs / 10, wakeups, runMs / 1000);
+    }
+}
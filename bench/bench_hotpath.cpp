@@ -0,0 +1,262 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "../src/state_machine.h"
+#include "../include/event_queue.h"
+#include "../include/led_controller.h"
+#include "../include/logger.h"
+#include "../include/motion_engine.h"
+#include "../include/report_pipeline.h"
+
+// 热路径微基准：每个操作单独计时，名称以 hot_ 开头。
+// 运行 program hot_ --baseline bench/baseline.json 与基线比较，超过阈值时返回非零；
+// 改动运动或状态机代码前后各运行一次，或用 --json 重新生成基线（基线与机器相关）
+
+static const int RUNS = 5;   // 每项重复 RUNS 次取最快的一次，减少主机调度带来的噪声
+
+// 一对 benchNowCycles() 本身的开销，单次计时的结果中扣除
+static uint64_t timerOverhead()
+{
+    uint64_t best = ~0ull;
+    for (int i = 0; i < 10000; i++)
+    {
+        uint64_t start = benchNowCycles();
+        uint64_t cycles = benchNowCycles() - start;
+        best = cycles < best ? cycles : best;
+    }
+    return best;
+}
+
+// ---- 运动计算：每个模式（只保留该模式的权重）以及只用规划器时的一次 step() ----
+
+static uint64_t runMotion(MotionEngine &engine, unsigned int steps)
+{
+    engine.seed(12345);
+    engine.reset(0);
+    uint32_t nowUs = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        sum += report.dx + report.dy;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+    return cycles;
+}
+
+static void reportMotion(const char *pattern, MotionEngine &engine)
+{
+    const unsigned int steps = 200000;
+    uint64_t best = ~0ull;
+    for (int run = 0; run < RUNS; run++)
+    {
+        uint64_t cycles = runMotion(engine, steps);
+        best = cycles < best ? cycles : best;
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "hot_motion_step.%s", pattern);
+    benchReportCycles(name, "step", steps, best);
+}
+
+BENCH_CASE(hot_motion_step)
+{
+    static const char *const names[] = {"random_walk", "circle", "figure_eight", "spiral", "lissajous",
+                                        "line_sweep"};
+    hostsim::reset();
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        MotionEngine engine(config);
+        MotionEngine::Pattern only = engine.patterns().id(i);
+        for (size_t k = 0; k < ActivePatterns::COUNT; k++)
+        {
+            engine.setPatternWeight(engine.patterns().id(k), k == i ? 1 : 0);
+        }
+        reportMotion(names[(int)only], engine);
+    }
+    MotionEngine planned;
+    for (size_t k = 0; k < ActivePatterns::COUNT; k++)
+    {
+        planned.setPatternWeight(planned.patterns().id(k), 0);   // 只用规划器
+    }
+    reportMotion("planned", planned);
+}
+
+// ---- 状态机：每个状态下分发每种事件的耗时（含状态切换时的 exit()/entry()） ----
+
+// 直接切换到指定状态（基准专用），调用 exit()/entry() 与正常转换相同
+struct StateAccess : BleMouseState {
+    template <typename S>
+    static void force()
+    {
+        StateAccess access;
+        access.transit<S>();
+    }
+};
+
+template <typename S, typename E>
+static void timeDispatch(const char *state, const char *event, uint64_t overhead)
+{
+    // 每次分发之前都要重新进入状态 S，只能逐次计时：取全部样本的中位数，不受偶发的调度和缓存抖动影响
+    const int iterations = 200;
+    std::vector<uint64_t> samples;
+    samples.reserve(RUNS * iterations);
+    for (int i = 0; i < RUNS * iterations; i++)
+    {
+        StateAccess::force<S>();
+        EventQueue::clear();   // entry() 投递的后续事件不在这里分发，保持在状态 S 中计时
+        Logger::drain();
+        uint64_t start = benchNowCycles();
+        BleMouseState::dispatch(E());
+        uint64_t cycles = benchNowCycles() - start;
+        samples.push_back(cycles > overhead ? cycles - overhead : 0);
+        EventQueue::clear();
+        Logger::drain();
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    char name[96];
+    snprintf(name, sizeof(name), "hot_fsm_dispatch.%s.%s", state, event);
+    benchReportCycles(name, "dispatch", 1, samples[samples.size() / 2]);
+}
+
+template <typename S>
+static void timeState(const char *state, uint64_t overhead)
+{
+    timeDispatch<S, BootButtonShortPress>(state, "ShortPress", overhead);
+    timeDispatch<S, BootButtonDoubleClick>(state, "DoubleClick", overhead);
+    timeDispatch<S, BootButtonTripleClick>(state, "TripleClick", overhead);
+    timeDispatch<S, BootButtonLongPress>(state, "LongPress", overhead);
+    timeDispatch<S, BootButtonVeryLongPress>(state, "VeryLongPress", overhead);
+    timeDispatch<S, DeviceConnected>(state, "DeviceConnected", overhead);
+    timeDispatch<S, DeviceDisconnected>(state, "DeviceDisconnected", overhead);
+    timeDispatch<S, ConnectionTimeout>(state, "ConnectionTimeout", overhead);
+    timeDispatch<S, PairingTimeout>(state, "PairingTimeout", overhead);
+    timeDispatch<S, ConnectionFailed>(state, "ConnectionFailed", overhead);
+    timeDispatch<S, InitComplete>(state, "InitComplete", overhead);
+    timeDispatch<S, RestoreMouseMotionState>(state, "RestoreMotion", overhead);
+    timeDispatch<S, AdvertisingStageTimeout>(state, "AdvertisingStage", overhead);
+    timeDispatch<S, AdvertisingRetry>(state, "AdvertisingRetry", overhead);
+}
+
+BENCH_CASE(hot_fsm_dispatch)
+{
+    hostsim::reset();
+    setup();
+    uint64_t overhead = timerOverhead();
+    timeState<Init>("Init", overhead);
+    timeState<Idle>("Idle", overhead);
+    timeState<Reconnect>("Reconnect", overhead);
+    timeState<Pairing>("Pairing", overhead);
+    timeState<Connected>("Connected", overhead);
+    timeState<MouseMotionDisable>("MouseMotionDisable", overhead);
+    timeState<MouseMotionEnable>("MouseMotionEnable", overhead);
+    EventQueue::clear();
+    Logger::drain();
+    hostsim::reset();
+}
+
+// ---- LED：每种模式的 setMode() 以及定时器推进图案一步 ----
+// LEDController 没有轮询的 update()：图案由 esp_timer 回调逐步切换，这里测量一次回调（含虚拟时钟的分派）
+
+BENCH_CASE(hot_led_update)
+{
+    static const char *const names[] = {"OFF",       "ON",        "SLOW_BLINK", "FAST_BLINK",
+                                        "ALTERNATE", "HEARTBEAT", "CUSTOM"};
+    hostsim::reset();
+    LEDController::init();
+    uint64_t overhead = timerOverhead();
+    for (int mode = 0; mode < (int)LEDController::Mode::COUNT; mode++)
+    {
+        const int iterations = 2000;
+        LEDController::Mode other = mode == 0 ? LEDController::Mode::ON : LEDController::Mode::OFF;
+        uint64_t best = ~0ull;
+        for (int run = 0; run < RUNS; run++)
+        {
+            uint64_t total = 0;
+            for (int i = 0; i < iterations; i++)
+            {
+                LEDController::setMode(other);
+                uint64_t start = benchNowCycles();
+                LEDController::setMode((LEDController::Mode)mode);
+                uint64_t cycles = benchNowCycles() - start;
+                total += cycles > overhead ? cycles - overhead : 0;
+            }
+            best = total < best ? total : best;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "hot_led_update.%s.set_mode", names[mode]);
+        benchReportCycles(name, "call", iterations, best);
+
+        // 按步骤时长推进虚拟时钟，每次正好触发一次步骤回调；静态图案没有回调
+        const LEDController::Pattern &pattern = LEDController::pattern((LEDController::Mode)mode);
+        if (pattern.count <= 1)
+        {
+            continue;
+        }
+        best = ~0ull;
+        for (int run = 0; run < RUNS; run++)
+        {
+            LEDController::setMode((LEDController::Mode)mode);
+            uint64_t total = 0;
+            for (int i = 0; i < iterations; i++)
+            {
+                uint32_t durationMs = pattern.steps[i % pattern.count].durationMs;
+                uint64_t start = benchNowCycles();
+                hostsim::advanceMillis(durationMs);
+                total += benchNowCycles() - start;
+            }
+            best = total < best ? total : best;
+        }
+        snprintf(name, sizeof(name), "hot_led_update.%s.step", names[mode]);
+        benchReportCycles(name, "step", iterations, best);
+    }
+    hostsim::reset();
+}
+
+// ---- HID 报告：位移提交到 ReportPipeline 并构造 4 字节报告交给发送函数 ----
+
+static bool copyReport(const uint8_t *report, size_t length, void *context)
+{
+    uint8_t *out = (uint8_t *)context;
+    for (size_t i = 0; i < length; i++)
+    {
+        out[i] = report[i];
+    }
+    return true;
+}
+
+BENCH_CASE(hot_report_build)
+{
+    hostsim::reset();
+    uint8_t last[4] = {0, 0, 0, 0};
+    ReportPipeline pipeline(copyReport, last);
+    pipeline.setMinInterval(0);   // 每次提交都立即发送
+    const unsigned int reports = 1000000;
+    uint64_t best = ~0ull;
+    for (int run = 0; run < RUNS; run++)
+    {
+        uint32_t nowUs = 0;
+        uint64_t start = benchNowCycles();
+        for (unsigned int i = 0; i < reports; i++)
+        {
+            nowUs += 10000;
+            pipeline.submit((int8_t)((i & 15) - 8), (int8_t)(7 - (i & 7)), nowUs);
+        }
+        uint64_t cycles = benchNowCycles() - start;
+        best = cycles < best ? cycles : best;
+    }
+    benchKeep(last);
+    benchReportCycles("hot_report_build.submit", "report", reports, best);
+    if (pipeline.stats().sent != pipeline.stats().submitted)
+    {
+        printf("%-32s %u of %u submits sent\n", "hot_report_build", pipeline.stats().sent,
+               pipeline.stats().submitted);
+    }
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include "../include/led_controller.h"
+
+static const char *const MODE_NAMES[] = {"OFF", "ON", "SLOW_BLINK", "FAST_BLINK", "ALTERNATE", "HEARTBEAT", "CUSTOM"};
+
+// 每种模式播放 10s：一次性推进虚拟时钟（相当于期间没有任何任务运行），统计每步的主机耗时；
+// 时间线与图案表的逐步比对在 test/test_led_patterns 中
+BENCH_CASE(led_patterns)
+{
+    const uint32_t runMs = 10000;
+    for (int mode = 0; mode < (int)LEDController::Mode::COUNT; mode++)
+    {
+        hostsim::reset();
+        LEDController::init();
+        hostsim::clearLedcTimeline();
+
+        LEDController::setMode((LEDController::Mode)mode);
+
+        uint64_t wallStart = benchNowNs();
+        hostsim::advanceMillis(runMs);
+        uint64_t wallNs = benchNowNs() - wallStart;
+
+        uint32_t steps = 0;
+        for (size_t i = 0; i < hostsim::ledcEventCount(); i++)
+        {
+            steps += hostsim::ledcEvent(i).pin == LED_D4_PIN;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "led_patterns.%s", MODE_NAMES[mode]);
+        printf("%-32s %4u steps in %u ms, %6.0f ns/step host\n", name, steps, runMs,
+               steps ? (double)wallNs / steps : 0.0);
+    }
+}
@@ -0,0 +1,64 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include "../include/logger.h"
+
+// 同一条运动日志在两种路径下的调用方耗时：
+// - 原实现：String 拼接（多次堆分配）后同步 Serial.println()
+// - Logger：只写入一条定长记录，格式化和串口输出在日志任务中完成
+// 主机端串口不产生真实的 UART 等待，设备上 115200 波特率每字节还要约 87us
+BENCH_CASE(log_call)
+{
+    hostsim::reset();
+    const unsigned int calls = 200000;
+    uint8_t pattern = 2;
+    float radius = 12.5f;
+
+    size_t bytesBefore = hostsim::serialBytes();
+    uint64_t start = benchNowNs();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        Serial.println("切换到移动模式: " + String(pattern) + ", 幅度: " + String(radius));
+    }
+    uint64_t elapsed = benchNowNs() - start;
+    size_t lineBytes = (hostsim::serialBytes() - bytesBefore) / calls;
+    benchReport("log_call_string", "call", calls, elapsed);
+
+    // 队列容量有限：每满一批就取出，只计入写入本身的耗时
+    Logger::resetStats();
+    Logger::drain();
+    uint64_t writeNs = 0;
+    uint64_t drainNs = 0;
+    for (unsigned int done = 0; done < calls; done += Logger::RING_SIZE)
+    {
+        start = benchNowNs();
+        for (unsigned int i = 0; i < Logger::RING_SIZE; i++)
+        {
+            LOG_INFO("切换到移动模式: %u, 幅度: %.2f", pattern, radius);
+        }
+        writeNs += benchNowNs() - start;
+
+        start = benchNowNs();
+        Logger::drain();
+        drainNs += benchNowNs() - start;
+    }
+    unsigned int written = (calls + Logger::RING_SIZE - 1) / Logger::RING_SIZE * Logger::RING_SIZE;
+    benchReport("log_call_logger", "call", written, writeNs);
+    benchReport("log_call_logger.drain", "record", written, drainNs);
+
+    // 默认 LOG_LEVEL 下 DEBUG 级别在编译期被裁剪，宏展开为空语句
+    start = benchNowNs();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        LOG_DEBUG("切换到移动模式: %u, 幅度: %.2f", pattern, radius);
+        benchKeep(i);
+    }
+    elapsed = benchNowNs() - start;
+    benchReport("log_call_debug", "call", calls, elapsed);
+
+    Logger::Stats stats = Logger::stats();
+    printf("%-32s written %u, dropped %u, drained %u, max depth %u, %u bytes/line (%.0f us UART at 115200)\n",
+           "log_call.stats", stats.written, stats.dropped, stats.drained, stats.maxDepth,
+           (unsigned)lineBytes, lineBytes * 10 * 1000000.0 / 115200);
+}
@@ -0,0 +1,215 @@
+#include "bench.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static BenchCase *firstCase = nullptr;
+static BenchCase *lastCase = nullptr;
+
+// benchReport()/benchReportCycles() 输出的每一行，供 JSON 输出和基线比较
+struct BenchResult {
+    std::string name;
+    std::string unit;
+    std::string metric;   // "ns" 或 "cyc"
+    double value;
+};
+
+static std::vector<BenchResult> results;
+
+BenchCase::BenchCase(const char *name, BenchFunction function)
+    : name(name), function(function), next(nullptr)
+{
+    // 按注册顺序串成链表
+    if (lastCase)
+    {
+        lastCase->next = this;
+    }
+    else
+    {
+        firstCase = this;
+    }
+    lastCase = this;
+}
+
+uint64_t benchNowNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t benchNowCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return benchNowNs();
+#endif
+}
+
+void benchReport(const char *name, const char *unit, uint64_t count, uint64_t elapsedNs)
+{
+    double nsPerUnit = count ? (double)elapsedNs / (double)count : 0.0;
+    printf("%-32s %12.1f ns/%-8s (%llu %s)\n", name, nsPerUnit, unit,
+           (unsigned long long)count, unit);
+    results.push_back(BenchResult{name, unit, "ns", nsPerUnit});
+}
+
+void benchReportCycles(const char *name, const char *unit, uint64_t count, uint64_t cycles)
+{
+    double cyclesPerUnit = count ? (double)cycles / (double)count : 0.0;
+    printf("%-32s %12.1f cyc/%-7s (%llu %s)\n", name, cyclesPerUnit, unit,
+           (unsigned long long)count, unit);
+    results.push_back(BenchResult{name, unit, "cyc", cyclesPerUnit});
+}
+
+// 单元测试构建（platformio test）同样编译 bench/，main() 由 test/ 中的测试程序提供
+#ifndef PIO_UNIT_TESTING
+
+// 每个结果一行，基线文件就是这种格式的输出，readBaseline() 按行解析
+static bool writeJson(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("无法写入 %s\n", path);
+        return false;
+    }
+    fprintf(file, "{\n  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"unit\": \"%s\", \"metric\": \"%s\", \"value\": %.1f}%s\n",
+                r.name.c_str(), r.unit.c_str(), r.metric.c_str(), r.value, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+static bool readBaseline(const char *path, std::vector<BenchResult> &baseline)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        printf("无法读取基线 %s\n", path);
+        return false;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        char name[128], unit[32], metric[8];
+        double value;
+        if (sscanf(line, " {\"name\": \"%127[^\"]\", \"unit\": \"%31[^\"]\", \"metric\": \"%7[^\"]\", \"value\": %lf",
+                   name, unit, metric, &value) == 4)
+        {
+            baseline.push_back(BenchResult{name, unit, metric, value});
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// 本次运行中与基线同名（名称、单位和度量都相同）的结果超过基线 threshold 比例、且差值不小于
+// MIN_REGRESSION 时算作退步：只有十几个周期的操作在主机上的抖动就有几个周期；
+// 基线中有而本次未运行的结果（被过滤掉的用例）不比较；本次运行中基线没有的结果（新增的用例）
+// 逐项列出，同样算作失败，提醒重新生成基线
+static const double MIN_REGRESSION = 5.0;
+
+// 返回退步和缺少基线的项数
+static unsigned int compareBaseline(const std::vector<BenchResult> &baseline, double threshold)
+{
+    unsigned int compared = 0, regressions = 0, missing = 0;
+    for (const BenchResult &r : results)
+    {
+        const BenchResult *base = nullptr;
+        for (const BenchResult &candidate : baseline)
+        {
+            if (r.name == candidate.name && r.unit == candidate.unit && r.metric == candidate.metric)
+            {
+                base = &candidate;
+                break;
+            }
+        }
+        if (!base)
+        {
+            missing++;
+            printf("缺少基线: %-32s %10.1f %s/%s\n", r.name.c_str(), r.value, r.metric.c_str(), r.unit.c_str());
+            continue;
+        }
+        compared++;
+        double change = base->value > 0 ? r.value / base->value - 1.0 : 0.0;
+        if (change > threshold && r.value - base->value >= MIN_REGRESSION)
+        {
+            regressions++;
+            printf("退步: %-32s %10.1f %s/%s，基线 %10.1f（%+.1f%%）\n", r.name.c_str(), r.value,
+                   r.metric.c_str(), r.unit.c_str(), base->value, change * 100);
+        }
+    }
+    printf("基线比较: %u 项，%u 项超过阈值 %.0f%%，%u 项缺少基线\n", compared, regressions, threshold * 100, missing);
+    return regressions + missing;
+}
+
+// 用法：program [名称子串] [--json 文件] [--baseline 文件] [--threshold 百分比]
+// 不带名称时运行全部用例；--json 把结果写成 JSON，--baseline 与之前写出的 JSON 比较，
+// 有结果比基线慢超过阈值（默认 25%）或没有基线时返回 1
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *jsonPath = nullptr;
+    const char *baselinePath = nullptr;
+    double threshold = 0.25;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold = atof(argv[++i]) / 100.0;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    // 先读基线：--json 和 --baseline 可以是同一个文件（比较后更新）
+    std::vector<BenchResult> baseline;
+    if (baselinePath && !readBaseline(baselinePath, baseline))
+    {
+        return 2;
+    }
+
+    for (BenchCase *c = firstCase; c; c = c->next)
+    {
+        if (filter && !strstr(c->name, filter))
+        {
+            continue;
+        }
+        c->function();
+    }
+
+    if (jsonPath && !writeJson(jsonPath))
+    {
+        return 2;
+    }
+    if (baselinePath && compareBaseline(baseline, threshold) > 0)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
@@ -0,0 +1,141 @@
+#include "bench.h"
+#include <host_sim.h>
+#include "../include/motion_engine.h"
+#include "motion_float_reference.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+// 单独推进 MotionEngine，每步 10ms，与固件的 loop() 节奏一致
+BENCH_CASE(motion_step)
+{
+    hostsim::reset();
+    MotionEngine engine;
+    engine.reset(0);
+
+    const unsigned int steps = 1000000;
+    uint32_t nowUs = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowNs();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        sum += report.dx + report.dy;
+    }
+    uint64_t elapsed = benchNowNs() - start;
+    benchKeep(sum);
+
+    benchReport("motion_step", "step", steps, elapsed);
+}
+
+// 定点路径与浮点参考路径的对比：每步周期数，以及相同随机序列下的输出差异
+template <typename Engine>
+static uint64_t runCycles(Engine &engine, unsigned int steps)
+{
+    uint32_t nowUs = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        sum += report.dx + report.dy;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+    return cycles;
+}
+
+BENCH_CASE(motion_fixed_vs_float)
+{
+    const unsigned int steps = 1000000;
+
+    hostsim::reset();
+    // 浮点参考只有逐步计算的模式，且只有原来的三种、等概率选择：其余模式的权重置 0
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    MotionEngine fixedEngine(config);
+    const MotionEngine::Pattern legacy[] = {MotionEngine::Pattern::RANDOM_WALK, MotionEngine::Pattern::CIRCLE,
+                                            MotionEngine::Pattern::FIGURE_EIGHT};
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        fixedEngine.setPatternWeight(fixedEngine.patterns().id(i), 0);
+    }
+    for (MotionEngine::Pattern pattern : legacy)
+    {
+        fixedEngine.setPatternWeight(pattern, 1);
+    }
+    fixedEngine.reset(0);
+    benchReportCycles("motion_step_fixed", "step", steps, runCycles(fixedEngine, steps));
+
+    hostsim::reset();
+    FloatMotionReference floatEngine;
+    floatEngine.reset(0);
+    benchReportCycles("motion_step_float", "step", steps, runCycles(floatEngine, steps));
+
+    // 两条路径消耗随机数的顺序相同：用同一种子分别运行，逐步比较输出
+    const unsigned int compareSteps = 100000;
+    std::vector<MotionEngine::Report> fixedReports(compareSteps);
+    fixedEngine.seed(12345);
+    fixedEngine.reset(0);
+    for (unsigned int i = 0; i < compareSteps; i++)
+    {
+        fixedReports[i] = fixedEngine.step((i + 1) * 10000);
+    }
+
+    floatEngine.seed(12345);
+    floatEngine.reset(0);
+    double fixedSpeed = 0, floatSpeed = 0;
+    int maxDiff = 0;
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < compareSteps; i++)
+    {
+        MotionEngine::Report f = floatEngine.step((i + 1) * 10000);
+        const MotionEngine::Report &q = fixedReports[i];
+        int diff = std::max(abs(f.dx - q.dx), abs(f.dy - q.dy));
+        maxDiff = std::max(maxDiff, diff);
+        mismatches += diff != 0;
+        fixedSpeed += sqrt((double)(q.dx * q.dx + q.dy * q.dy));
+        floatSpeed += sqrt((double)(f.dx * f.dx + f.dy * f.dy));
+    }
+    printf("%-32s mean speed fixed %.3f / float %.3f, %u/%u steps differ, max |diff| %d\n",
+           "motion_fixed_vs_float", fixedSpeed / compareSteps, floatSpeed / compareSteps,
+           mismatches, compareSteps, maxDiff);
+}
+
+// 不同 step 周期下运行同样长的虚拟时间，比较每秒移动距离：
+// MotionEngine 按时间积分，应与周期基本无关；浮点参考仍按步计算，距离随调用频率成比例变化
+template <typename Engine>
+static double distancePerSecond(Engine &engine, uint32_t periodUs, uint32_t seconds)
+{
+    engine.seed(12345);
+    engine.reset(0);
+    double distance = 0;
+    uint32_t steps = (uint32_t)((uint64_t)seconds * 1000000 / periodUs);
+    for (uint32_t i = 1; i <= steps; i++)
+    {
+        MotionEngine::Report report = engine.step(i * periodUs);
+        distance += sqrt((double)(report.dx * report.dx + report.dy * report.dy));
+    }
+    return distance / seconds;
+}
+
+BENCH_CASE(motion_step_rate)
+{
+    const uint32_t periods[] = {2500, 5000, 10000, 20000, 40000};
+    const uint32_t seconds = 600;
+
+    hostsim::reset();
+    MotionEngine fixedEngine;
+    FloatMotionReference floatEngine;
+    for (uint32_t periodUs : periods)
+    {
+        double fixedRate = distancePerSecond(fixedEngine, periodUs, seconds);
+        double floatRate = distancePerSecond(floatEngine, periodUs, seconds);
+        printf("%-32s period %5.1f ms: engine %8.1f counts/s, per-step reference %8.1f counts/s\n",
+               "motion_step_rate", periodUs / 1000.0, fixedRate, floatRate);
+    }
+}
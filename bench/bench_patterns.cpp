@@ -0,0 +1,203 @@
+#include "bench.h"
+#include <host_sim.h>
+#include <math.h>
+#include <stdio.h>
+#include "../include/motion_engine.h"
+#include "../include/motion_patterns.h"
+#include "../include/prng.h"
+
+static const char *patternName(MotionPattern pattern)
+{
+    switch (pattern)
+    {
+    case MotionPattern::RANDOM_WALK:
+        return "random_walk";
+    case MotionPattern::CIRCLE:
+        return "circle";
+    case MotionPattern::FIGURE_EIGHT:
+        return "figure_eight";
+    case MotionPattern::SPIRAL:
+        return "spiral";
+    case MotionPattern::LISSAJOUS:
+        return "lissajous";
+    case MotionPattern::LINE_SWEEP:
+        return "line_sweep";
+    }
+    return "?";
+}
+
+// 直接调用一个模式策略的 step()（编译期绑定）
+template <typename P>
+static void benchPolicy(unsigned int steps)
+{
+    P pattern;
+    Prng rng;
+    uint32_t angle = 0;
+    pattern.begin(rng);
+    PatternContext ctx = {1000 * fixed::Q16_ONE, 0, 167772, angle, rng, 0, 0};   // 10ms
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        ctx.nowMs += 10;
+        pattern.step(ctx);
+        sum += ctx.targetX ^ ctx.targetY;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+    char name[64];
+    snprintf(name, sizeof(name), "pattern_step.%s", patternName(P::ID));
+    benchReportCycles(name, "step", steps, cycles);
+}
+
+// 整个 step()（逐步模式），只保留一个模式的权重；同时统计移动阶段的平均速度
+static void benchEngine(MotionPattern only, unsigned int steps)
+{
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    MotionEngine engine(config);
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        MotionPattern id = engine.patterns().id(i);
+        engine.setPatternWeight(id, id == only ? 1 : 0);
+    }
+    engine.reset(0);
+    uint32_t nowUs = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        sum += report.dx + report.dy;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+
+    // 再运行一遍（不计时）统计速度
+    engine.reset(0);
+    nowUs = 0;
+    double distance = 0;
+    unsigned int moving = 0;
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        if (engine.state().inMovePhase && engine.state().pattern == only)
+        {
+            distance += sqrt((double)(report.dx * report.dx + report.dy * report.dy));
+            moving++;
+        }
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "pattern_engine.%s", patternName(only));
+    benchReportCycles(name, "step", steps, cycles);
+    printf("%-32s mean speed while moving %6.1f counts/s\n", name, moving ? distance * 100.0 / moving : 0.0);
+}
+
+// 每个模式单独 step() 的耗时，以及经注册表按下标分派的平均耗时
+BENCH_CASE(pattern_step)
+{
+    const unsigned int steps = 1000000;
+    hostsim::reset();
+    benchPolicy<RandomWalkPattern>(steps);
+    benchPolicy<CirclePattern>(steps);
+    benchPolicy<FigureEightPattern>(steps);
+    benchPolicy<SpiralPattern>(steps);
+    benchPolicy<LissajousPattern>(steps);
+    benchPolicy<LineSweepPattern>(steps);
+
+    // 每 300 步（3 秒）换一个模式，与调度的节奏相近
+    ActivePatterns registry;
+    Prng rng;
+    uint32_t angle = 0;
+    PatternContext ctx = {1000 * fixed::Q16_ONE, 0, 167772, angle, rng, 0, 0};
+    size_t index = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        if (i % 300 == 0)
+        {
+            index = registry.pick(rng);
+            registry.begin(index, rng);
+        }
+        ctx.nowMs += 10;
+        registry.step(index, ctx);
+        sum += ctx.targetX ^ ctx.targetY;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+    benchReportCycles("pattern_step.registry", "step", steps, cycles);
+
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        benchEngine(registry.id(i), steps);
+    }
+}
+
+// 加权调度：抽取次数的比例与权重之比一致；运行一小时统计各模式实际占用的移动时间
+BENCH_CASE(pattern_schedule)
+{
+    hostsim::reset();
+    ActivePatterns registry;
+    Prng rng;
+    const unsigned int picks = 1000000;
+    unsigned int counts[ActivePatterns::COUNT] = {};
+    for (unsigned int i = 0; i < picks; i++)
+    {
+        counts[registry.pick(rng)]++;
+    }
+
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    MotionEngine engine(config);
+    engine.reset(0);
+    unsigned int moveSteps[ActivePatterns::COUNT] = {};
+    unsigned int changes = 0;
+    unsigned int totalMoving = 0;
+    for (uint32_t i = 1; i <= 360000; i++)
+    {
+        MotionEngine::Report report = engine.step(i * 10000);
+        changes += (report.events & MotionEngine::EVENT_PATTERN_CHANGED) != 0;
+        if (engine.state().inMovePhase)
+        {
+            moveSteps[registry.indexOf(engine.state().pattern)]++;
+            totalMoving++;
+        }
+    }
+
+    double worst = 0;
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        double expected = (double)registry.weight(i) / registry.totalWeight();
+        double share = (double)counts[i] / picks;
+        worst = fabs(share - expected) > worst ? fabs(share - expected) : worst;
+        char name[64];
+        snprintf(name, sizeof(name), "pattern_schedule.%s", patternName(registry.id(i)));
+        printf("%-32s weight %u, expected %5.1f%%, picked %5.1f%%, moving time in 1 h %5.1f%%\n", name,
+               registry.weight(i), expected * 100, share * 100, moveSteps[i] * 100.0 / totalMoving);
+    }
+    printf("%-32s %u patterns, %u changes in 1 h, max pick share error %.2f%%\n", "pattern_schedule",
+           (unsigned int)ActivePatterns::COUNT, changes, worst * 100);
+
+    // 默认配置：规划器与模式按权重分享移动段
+    MotionEngine mixed;
+    mixed.reset(0);
+    unsigned int segments[2] = {};
+    unsigned int movingSteps[2] = {};
+    segments[(int)mixed.state().source]++;
+    for (uint32_t i = 1; i <= 360000; i++)
+    {
+        MotionEngine::Report report = mixed.step(i * 10000);
+        int source = (int)mixed.state().source;
+        segments[source] += (report.events & MotionEngine::EVENT_MOVE_STARTED) != 0;
+        movingSteps[source] += mixed.state().inMovePhase;
+    }
+    double plannerExpected = (double)mixed.config().plannerWeight /
+                             (mixed.config().plannerWeight + mixed.patterns().totalWeight());
+    printf("%-32s planner weight %u, expected %5.1f%%, segments %5.1f%% (%u of %u), moving time %5.1f%%\n",
+           "pattern_schedule.planner", mixed.config().plannerWeight, plannerExpected * 100,
+           segments[1] * 100.0 / (segments[0] + segments[1]), segments[1], segments[0] + segments[1],
+           movingSteps[1] * 100.0 / (movingSteps[0] + movingSteps[1]));
+}
@@ -0,0 +1,137 @@
+#include "bench.h"
+#include <host_sim.h>
+#include <math.h>
+#include <stdio.h>
+#include "../include/motion_engine.h"
+#include "../include/motion_planner.h"
+#include "../include/prng.h"
+
+// 规划一段的耗时：与段长和条目间隔成正比，在停顿开始时发生一次
+BENCH_CASE(planner_plan)
+{
+    const uint32_t durations[] = {1000, 2500, 4000};
+    const uint32_t periods[] = {7500, 10000, 20000};
+    hostsim::reset();
+    for (uint32_t durationMs : durations)
+    {
+        for (uint32_t periodUs : periods)
+        {
+            MotionPlanner planner;
+            Prng rng;
+            const unsigned int segments = 2000;
+            uint64_t start = benchNowCycles();
+            for (unsigned int i = 0; i < segments; i++)
+            {
+                planner.plan(rng, durationMs, periodUs, 2000);
+            }
+            uint64_t cycles = benchNowCycles() - start;
+            benchKeep(planner);
+            char name[64];
+            snprintf(name, sizeof(name), "planner_plan.%ums@%.1fms", durationMs, periodUs / 1000.0);
+            benchReportCycles(name, "segment", segments, cycles);
+            printf("%-32s %zu entries, %.1f cycles/entry\n", name, planner.available(),
+                   (double)cycles / segments / planner.available());
+        }
+    }
+}
+
+// 移动阶段每次 step() 的耗时：规划模式只弹出一个条目，与逐步计算速度的模式对比
+static uint64_t runSteps(MotionEngine &engine, unsigned int steps)
+{
+    engine.reset(0);
+    uint32_t nowUs = 0;
+    int32_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        MotionEngine::Report report = engine.step(nowUs);
+        sum += report.dx + report.dy;
+    }
+    uint64_t cycles = benchNowCycles() - start;
+    benchKeep(sum);
+    return cycles;
+}
+
+BENCH_CASE(planner_pop)
+{
+    hostsim::reset();
+    MotionPlanner planner;
+    Prng rng;
+    const unsigned int pops = 1000000;
+    int32_t sum = 0;
+    uint64_t cycles = 0;
+    unsigned int done = 0;
+    while (done < pops)
+    {
+        planner.plan(rng, 4000, 10000, 2000);
+        size_t entries = planner.available();
+        uint64_t start = benchNowCycles();
+        for (size_t i = 0; i < entries; i++)
+        {
+            MotionPlanner::Delta delta = planner.pop(10000);
+            sum += delta.dx + delta.dy;
+        }
+        cycles += benchNowCycles() - start;
+        done += entries;
+    }
+    benchKeep(sum);
+    benchReportCycles("planner_pop", "pop", done, cycles);
+
+    // 整个 step()（含移动/停顿切换和停顿时的规划），约 60% 的时间处于移动阶段
+    const unsigned int steps = 1000000;
+    MotionEngine planned;
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        planned.setPatternWeight(planned.patterns().id(i), 0);   // 只用规划器
+    }
+    benchReportCycles("planner_pop.engine_planned", "step", steps, runSteps(planned, steps));
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    MotionEngine perStep(config);
+    benchReportCycles("planner_pop.engine_per_step", "step", steps, runSteps(perStep, steps));
+}
+
+// 规划出的轨迹：峰值速度不超过上限、每段起止速度为零、弹出位移之和正好到达终点、离起点的最远距离
+BENCH_CASE(planner_profile)
+{
+    const uint32_t periods[] = {7500, 10000, 40000};
+    hostsim::reset();
+    for (uint32_t periodUs : periods)
+    {
+        MotionPlanner planner;
+        Prng rng;
+        const int segments = 2000;
+        const int32_t maxSpeed = 2000;
+        double peakSpeed = 0, edgeSpeed = 0, maxDistance = 0;
+        uint32_t endpointErrors = 0;
+        for (int i = 0; i < segments; i++)
+        {
+            uint32_t durationMs = rng.range(MIN_MOVE_DURATION, MAX_MOVE_DURATION);
+            int32_t startX = planner.positionX(), startY = planner.positionY();
+            planner.plan(rng, durationMs, periodUs, maxSpeed);
+            size_t entries = planner.available();
+            for (size_t k = 0; k < entries; k++)
+            {
+                MotionPlanner::Delta delta = planner.pop(periodUs);
+                double speed = sqrt((double)(delta.dx * delta.dx + delta.dy * delta.dy)) * 1e6 / periodUs;
+                peakSpeed = speed > peakSpeed ? speed : peakSpeed;
+                if (k == 0 || k + 1 == entries)
+                {
+                    edgeSpeed = speed > edgeSpeed ? speed : edgeSpeed;
+                }
+            }
+            double distance = sqrt((double)planner.positionX() * planner.positionX() +
+                                   (double)planner.positionY() * planner.positionY());
+            maxDistance = distance > maxDistance ? distance : maxDistance;
+            const MotionPlanner::Segment &segment = planner.segment();
+            endpointErrors += planner.positionX() - startX != segment.x3 || planner.positionY() - startY != segment.y3;
+        }
+        const MotionPlanner::Stats &stats = planner.stats();
+        char name[64];
+        snprintf(name, sizeof(name), "planner_profile.%.1fms", periodUs / 1000.0);
+        printf("%-32s peak %6.1f counts/s (limit %d), first/last entry %5.1f counts/s, max distance %6.0f, "
+               "%u scaled, %u clipped, %u endpoint errors\n",
+               name, peakSpeed, maxSpeed, edgeSpeed, maxDistance, stats.scaled, stats.clipped, endpointErrors);
+    }
+}
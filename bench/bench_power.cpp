@@ -0,0 +1,145 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <esp_pm.h>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+#include "../include/power_manager.h"
+#include "../include/conn_params.h"
+#include "../include/settings_store.h"
+
+// 按设备上的调度方式运行：后台任务只在有事件投递或设置的写入时间到达时运行，
+// 运动任务只在移动启用时按报告周期运行（停止时再运行一次以取出命令），虚拟时钟以 1ms 推进
+static void runDevice(uint32_t durationMs, uint32_t &lockMismatches)
+{
+    uint64_t endUs = hostsim::nowMicros() + durationMs * 1000ull;
+    uint64_t nextHousekeepingUs = hostsim::nowMicros();
+    uint64_t nextMotionUs = hostsim::nowMicros();
+    uint32_t posted = EventQueue::stats().posted;
+    bool motionRunning = false;
+    while (hostsim::nowMicros() < endUs)
+    {
+        uint64_t nowUs = hostsim::nowMicros();
+        uint32_t postedNow = EventQueue::stats().posted;
+        if (postedNow != posted || nowUs >= nextHousekeepingUs)
+        {
+            posted = postedNow;
+            AppTasks::housekeepingStep(0);
+            Logger::drain();
+            posted = EventQueue::stats().posted;
+            uint32_t waitMs = AppTasks::msUntilHousekeeping(millis());
+            nextHousekeepingUs = waitMs == AppTasks::NO_DEADLINE ? UINT64_MAX : hostsim::nowMicros() + waitMs * 1000ull;
+
+            bool motion = BleMouseState::is_in_state<MouseMotionEnable>();
+            bool fullSpeed = motion || PowerManager::mode() == PowerManager::Mode::PERFORMANCE;
+            if (PowerManager::dfsEnabled() && (hostsim::pmLockCount(ESP_PM_CPU_FREQ_MAX) == 1) != fullSpeed)
+            {
+                lockMismatches++;
+            }
+            if (motion && !motionRunning)
+            {
+                nextMotionUs = hostsim::nowMicros();
+            }
+            if (!motion && motionRunning)
+            {
+                AppTasks::motionStep(); // 取出停止命令后阻塞
+            }
+            motionRunning = motion;
+        }
+        if (motionRunning && nowUs >= nextMotionUs)
+        {
+            AppTasks::motionStep();
+            nextMotionUs += ReportPipeline::rateIntervalUs(AppTasks::reportRate());
+        }
+        hostsim::advanceMicros(1000);
+    }
+    // 后台任务可能很久没有唤醒：把统计结算到当前时间
+    PowerManager::update();
+}
+
+struct Workload {
+    const char *name;
+    bool connect;
+    bool motion;
+};
+
+struct PowerConfig {
+    const char *name;
+    PowerManager::Mode mode;
+    bool lightSleep;
+};
+
+// 各工作负载在三种电源配置下的平均电流：始终全速（与改造前相同，也是充电宝模式）、
+// 只调频（构建未启用 tickless idle）、调频加自动浅睡眠；电流由 PowerManager 的默认模型估算
+BENCH_CASE(power_budget)
+{
+    const Workload workloads[] = {
+        {"advertising", false, false},   // 未绑定，没有主机连接，执行重连广播计划
+        {"connected_idle", true, false}, // 已连接，鼠标移动禁用
+        {"connected_motion", true, true} // 已连接，100Hz 报告
+    };
+    const PowerConfig configs[] = {
+        {"performance", PowerManager::Mode::PERFORMANCE, true},
+        {"dfs", PowerManager::Mode::BALANCED, false},
+        {"light_sleep", PowerManager::Mode::BALANCED, true},
+    };
+    const uint32_t runMs = 600000;
+
+    for (const Workload &workload : workloads)
+    {
+        for (const PowerConfig &config : configs)
+        {
+            // 之前的用例可能在连接状态下重置了仿真：连接参数回到未连接（相当于设备重新上电）
+            hostsim::disconnect();
+            ConnParams::onDisconnected();
+            hostsim::reset();
+            hostsim::setLightSleepSupported(config.lightSleep);
+            PowerManager::setMode(config.mode);
+            AppTasks::setReportRate(ReportPipeline::RateMode::HZ_100);
+            setup();
+            SettingsStore::setMotionEnabled(workload.motion);
+            uint32_t lockMismatches = 0;
+            if (workload.connect)
+            {
+                hostsim::connect();
+            }
+            runDevice(1000, lockMismatches);
+            PowerManager::resetStats();
+
+            uint64_t wallStart = benchNowNs();
+            runDevice(runMs, lockMismatches);
+            uint64_t wallNs = benchNowNs() - wallStart;
+
+            PowerManager::Model model = PowerManager::defaultModel();
+            PowerManager::PhaseStats total = PowerManager::total();
+            PowerManager::Estimate estimate = PowerManager::estimate(total, model);
+            char name[64];
+            snprintf(name, sizeof(name), "power_budget.%s.%s", workload.name, config.name);
+            printf("%-44s %6.2f mA, %6.3f mAh/10min, sleep %5.1f%%, radio %5.2f%%, %6.1f wakeups/s, "
+                   "%u lock mismatches, %.0f ms wall\n",
+                   name, estimate.averageMa, estimate.mAh, estimate.sleepFraction * 100.0,
+                   total.radioUs * 100.0 / total.totalUs, total.wakeups * 1e6 / total.totalUs, lockMismatches,
+                   wallNs / 1e6);
+            if (config.mode == PowerManager::Mode::BALANCED && config.lightSleep)
+            {
+                for (int phase = 0; phase < (int)PowerManager::Phase::COUNT; phase++)
+                {
+                    PowerManager::PhaseStats stats = PowerManager::stats((PowerManager::Phase)phase);
+                    if (stats.totalUs == 0)
+                    {
+                        continue;
+                    }
+                    PowerManager::Estimate phaseEstimate = PowerManager::estimate(stats, model);
+                    snprintf(name, sizeof(name), "  %s", PowerManager::name((PowerManager::Phase)phase));
+                    printf("%-44s %6.2f mA, %7.1f s, awake %7.1f s, full speed %7.1f s, radio %6.2f s, %u wakeups\n",
+                           name, phaseEstimate.averageMa, stats.totalUs / 1e6, stats.noSleepUs / 1e6,
+                           stats.fullSpeedUs / 1e6, stats.radioUs / 1e6, stats.wakeups);
+                }
+            }
+        }
+    }
+    PowerManager::setMode(PowerManager::Mode::BALANCED);
+}
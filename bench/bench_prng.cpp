@@ -0,0 +1,127 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <math.h>
+#include <set>
+#include <stdio.h>
+#include "../include/motion_engine.h"
+#include "../include/prng.h"
+
+// 调用路径对比：运动代码原先每步调用 Arduino random(min, max)；主机替身为线性同余加取模，
+// 设备上每次还要读取硬件随机数寄存器，实际差距更大
+BENCH_CASE(prng_call_path)
+{
+    const unsigned int calls = 10000000;
+    hostsim::reset();
+
+    int64_t sum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        sum += random(-100, 100);
+    }
+    benchReportCycles("prng_call_path.arduino_random", "call", calls, benchNowCycles() - start);
+
+    Prng rng;
+    start = benchNowCycles();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        sum += rng.range(-100, 100);
+    }
+    benchReportCycles("prng_call_path.range", "call", calls, benchNowCycles() - start);
+
+    start = benchNowCycles();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        sum += rng.next();
+    }
+    benchReportCycles("prng_call_path.next", "call", calls, benchNowCycles() - start);
+
+    float total = 0;
+    start = benchNowCycles();
+    for (unsigned int i = 0; i < calls; i++)
+    {
+        total += rng.uniform(-0.3f, 0.3f);
+    }
+    benchReportCycles("prng_call_path.uniform", "call", calls, benchNowCycles() - start);
+    benchKeep(sum);
+    benchKeep(total);
+}
+
+// 浮点范围：random(-0.3, 0.3) 和 random(5.0, 15.0) 的参数被截断为 long，对比 uniform() 的取值
+BENCH_CASE(prng_ranges)
+{
+    const unsigned int samples = 1000000;
+    hostsim::reset();
+    Prng rng;
+
+    unsigned int arduinoTurns = 0, prngTurns = 0;
+    std::set<long> arduinoRadii;
+    double turnMin = 0, turnMax = 0, radiusMin = 100, radiusMax = 0, radiusSum = 0;
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        arduinoTurns += random(-0.3, 0.3) != 0;
+        arduinoRadii.insert(random(5.0, 15.0));
+
+        float turn = rng.uniform(-0.3f, 0.3f);
+        prngTurns += turn != 0.0f;
+        turnMin = turn < turnMin ? turn : turnMin;
+        turnMax = turn > turnMax ? turn : turnMax;
+        float radius = rng.uniform(5.0f, 15.0f);
+        radiusMin = radius < radiusMin ? radius : radiusMin;
+        radiusMax = radius > radiusMax ? radius : radiusMax;
+        radiusSum += radius;
+    }
+    printf("%-32s random(-0.3, 0.3) non-zero %u/%u, uniform %u/%u in [%.4f, %.4f]\n", "prng_ranges.turn",
+           arduinoTurns, samples, prngTurns, samples, turnMin, turnMax);
+    printf("%-32s random(5.0, 15.0) %zu distinct values, uniform in [%.4f, %.4f] mean %.4f\n", "prng_ranges.radius",
+           arduinoRadii.size(), radiusMin, radiusMax, radiusSum / samples);
+
+    // range() 的均匀性：100 个桶的卡方（自由度 99，99% 分位约 135）
+    const int buckets = 100;
+    unsigned int counts[buckets] = {0};
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        counts[rng.range(0, buckets)]++;
+    }
+    double expected = (double)samples / buckets, chiSquare = 0;
+    for (int i = 0; i < buckets; i++)
+    {
+        chiSquare += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+    printf("%-32s range(0, 100) chi-square %.1f (99 dof)\n", "prng_ranges.uniformity", chiSquare);
+}
+
+// 固定种子可复现：同一种子的两个引擎逐步输出相同；hostsim::reset() 后硬件种子序列从头开始
+BENCH_CASE(prng_seed)
+{
+    const unsigned int steps = 100000;
+    hostsim::reset();
+    uint32_t firstSeed = Prng::hardwareSeed();
+    hostsim::reset();
+    uint32_t againSeed = Prng::hardwareSeed();
+
+    MotionEngine::Config perStep;
+    perStep.plannerWeight = 0;
+    const MotionEngine::Config configs[] = {MotionEngine::Config(), perStep};
+    for (const MotionEngine::Config &config : configs)
+    {
+        MotionEngine a(config), b(config), c(config);
+        a.seed(firstSeed);
+        b.seed(againSeed);
+        c.seed(firstSeed + 1);
+        a.reset(0);
+        b.reset(0);
+        c.reset(0);
+        unsigned int mismatches = 0, differentSeed = 0;
+        for (unsigned int i = 1; i <= steps; i++)
+        {
+            MotionEngine::Report ra = a.step(i * 10000), rb = b.step(i * 10000), rc = c.step(i * 10000);
+            mismatches += ra.dx != rb.dx || ra.dy != rb.dy;
+            differentSeed += ra.dx != rc.dx || ra.dy != rc.dy;
+        }
+        printf("%-32s %s: same seed %u/%u steps differ, next seed %u/%u steps differ\n", "prng_seed.engine",
+               config.plannerWeight ? "mixed   " : "per-step", mismatches, steps, differentSeed, steps);
+    }
+    printf("%-32s hardware seed after reset %s\n", "prng_seed.host", firstSeed == againSeed ? "repeats" : "differs");
+}
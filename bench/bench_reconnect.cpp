@@ -0,0 +1,190 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <NimBLEDevice.h>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/logger.h"
+#include "../include/reconnect_strategy.h"
+#include "../include/advertising_schedule.h"
+
+extern NimBLEServer *pServer;
+
+// 主机扫描模型：主机醒来后每 scanIntervalUs 扫描 scanWindowUs，落在窗口内的第一个广播包即建立连接
+struct HostProfile {
+    const char *name;
+    uint32_t scanIntervalUs;
+    uint32_t scanWindowUs;
+};
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t nextRandom()
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint32_t randomBelow(uint32_t bound)
+{
+    return bound ? nextRandom() % bound : 0;
+}
+
+// 推进虚拟时间到 targetUs，每 10ms 由后台任务分发一次（阶段定时器等事件）
+static void advanceTo(uint64_t targetUs)
+{
+    while (hostsim::nowMicros() < targetUs)
+    {
+        uint64_t stepUs = targetUs - hostsim::nowMicros();
+        hostsim::advanceMicros(stepUs < 10000 ? stepUs : 10000);
+        AppTasks::housekeepingStep(0);
+    }
+}
+
+// 下一个广播事件的间隔：控制器在 [min, max] 内取值并加上 0~10ms 的随机 advDelay；
+// 间隔为 0 时为协议栈默认的 30~60ms
+static uint64_t advertisingGapUs(const NimBLEAdvertising *advertising)
+{
+    uint32_t minUs = advertising->minInterval ? advertising->minInterval * 625u : 30000;
+    uint32_t maxUs = advertising->maxInterval ? advertising->maxInterval * 625u : 60000;
+    return minUs + randomBelow(maxUs - minUs + 1) + randomBelow(10001);
+}
+
+// 一次断开后的重连：主机在断开 wakeMs 之后开始扫描，返回期间发出的广播包数
+static uint32_t runReconnect(const HostProfile &host, uint32_t wakeMs, uint64_t &elapsedUs)
+{
+    NimBLEAdvertising *advertising = pServer->getAdvertising();
+    uint64_t disconnectUs = hostsim::nowMicros();
+    uint64_t wakeUs = disconnectUs + wakeMs * 1000ull;
+    uint32_t phaseUs = randomBelow(host.scanIntervalUs);
+    hostsim::disconnect();
+    AppTasks::housekeepingStep(0);
+
+    uint32_t starts = hostsim::advertisingStartCount();
+    uint64_t eventUs = hostsim::lastAdvertisingStartUs();
+    uint32_t events = 0;
+    for (;;)
+    {
+        advanceTo(eventUs);
+        if (hostsim::advertisingStartCount() != starts)
+        {
+            // 阶段切换时重新启动了广播，第一个广播包在启动时刻发出
+            starts = hostsim::advertisingStartCount();
+            eventUs = hostsim::lastAdvertisingStartUs();
+        }
+        if (!advertising->isAdvertising())
+        {
+            eventUs = hostsim::nowMicros() + 1000;
+            continue;
+        }
+        events++;
+        if (eventUs >= wakeUs && (eventUs + phaseUs) % host.scanIntervalUs < host.scanWindowUs)
+        {
+            break;
+        }
+        eventUs += advertisingGapUs(advertising);
+    }
+
+    hostsim::connect();
+    advanceTo(hostsim::nowMicros() + 20000);
+    Logger::drain();
+    elapsedUs = hostsim::nowMicros() - disconnectUs;
+    return events;
+}
+
+static void printHistogram(const char *label, const uint32_t *histogram)
+{
+    printf("%-40s", label);
+    for (uint8_t i = 0; i < ReconnectStrategy::HISTOGRAM_BUCKETS; i++)
+    {
+        if (i < ReconnectStrategy::HISTOGRAM_BUCKETS - 1)
+        {
+            printf(" <%u:%u", ReconnectStrategy::HISTOGRAM_LIMITS_MS[i], histogram[i]);
+        }
+        else
+        {
+            printf(" >=%u:%u", ReconnectStrategy::HISTOGRAM_LIMITS_MS[i - 1], histogram[i]);
+        }
+    }
+    printf("\n");
+}
+
+// 已绑定主机睡眠后醒来时的重连时间：对比有绑定时的定向/过滤广播计划与没有绑定时的公开广播计划；
+// 主机分别以持续扫描和后台低占空比扫描两种方式寻找设备
+BENCH_CASE(reconnect_latency)
+{
+    const HostProfile hosts[] = {
+        {"active", 30000, 30000},        // 醒来后持续扫描
+        {"background", 1280000, 11250}, // 后台低占空比扫描
+    };
+    const uint32_t wakeDelaysMs[] = {0, 500, 2000, 5000, 15000, 45000, 120000, 600000};
+    const int trials = 16;
+
+    for (const HostProfile &host : hosts)
+    {
+        for (int bonded = 1; bonded >= 0; bonded--)
+        {
+            rngState = 0x12345678;
+            hostsim::reset();
+            hostsim::setBonded(bonded != 0);
+            setup(); // InitComplete -> Reconnect
+            hostsim::connect();
+            advanceTo(hostsim::nowMicros() + 20000);
+            Logger::drain();
+            ReconnectStrategy::resetStats();
+            AdvertisingSchedule::resetStats();
+
+            uint64_t advertisingUs = 0;
+            uint32_t events = 0;
+            // 主机醒来之后才算损失的时间：固件侧的直方图从断开算起，包含主机睡眠的时间
+            uint32_t afterWake[ReconnectStrategy::HISTOGRAM_BUCKETS] = {0};
+            uint64_t afterWakeTotalMs[2] = {0, 0};   // 主机在断开 30s 内 / 30s 后醒来
+            uint32_t afterWakeCount[2] = {0, 0};
+            uint32_t afterWakeMaxMs = 0;
+            uint64_t wallStart = benchNowNs();
+            for (uint32_t wakeMs : wakeDelaysMs)
+            {
+                for (int trial = 0; trial < trials; trial++)
+                {
+                    uint64_t elapsedUs = 0;
+                    events += runReconnect(host, wakeMs, elapsedUs);
+                    advertisingUs += elapsedUs;
+                    uint32_t lostMs = (uint32_t)(elapsedUs / 1000) - wakeMs;
+                    afterWake[ReconnectStrategy::bucket(lostMs)]++;
+                    afterWakeTotalMs[wakeMs >= 30000]+= lostMs;
+                    afterWakeCount[wakeMs >= 30000]++;
+                    if (lostMs > afterWakeMaxMs)
+                    {
+                        afterWakeMaxMs = lostMs;
+                    }
+                    advanceTo(hostsim::nowMicros() + 1000000);
+                }
+            }
+            uint64_t wallNs = benchNowNs() - wallStart;
+
+            ReconnectStrategy::Stats stats = ReconnectStrategy::stats();
+            char name[64];
+            snprintf(name, sizeof(name), "reconnect_latency.%s.%s", host.name, bonded ? "bonded" : "open");
+            printf("%-40s %3u reconnects, mean %6.0f ms, max %6u ms, %5.1f adv events/s, %.0f ms wall\n", name,
+                   stats.reconnects, stats.reconnects ? (double)stats.totalMs / stats.reconnects : 0.0, stats.maxMs,
+                   advertisingUs ? events * 1e6 / advertisingUs : 0.0, wallNs / 1e6);
+            printHistogram("  since disconnect (ms)", stats.histogram);
+            printHistogram("  after host wake (ms)", afterWake);
+            printf("%-40s mean %6.0f ms (wake <30s) / %6.0f ms (wake >=30s), max %6u ms\n", "  after host wake",
+                   (double)afterWakeTotalMs[0] / afterWakeCount[0], (double)afterWakeTotalMs[1] / afterWakeCount[1],
+                   afterWakeMaxMs);
+            AdvertisingSchedule::ScheduleId schedule = bonded ? AdvertisingSchedule::ScheduleId::RECONNECT_BONDED
+                                                              : AdvertisingSchedule::ScheduleId::RECONNECT_OPEN;
+            printf("%-40s", "  stage at reconnect");
+            for (uint8_t i = 0; i < AdvertisingSchedule::stageCount(schedule); i++)
+            {
+                printf(" %s:%u", AdvertisingSchedule::stageName(schedule, i),
+                       AdvertisingSchedule::stageStats(schedule, i).connects);
+            }
+            printf("\n");
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#include "bench.h"
+#include <host_sim.h>
+#include <stdio.h>
+#include "../include/motion_engine.h"
+#include "../include/report_pipeline.h"
+
+static bool countReport(const uint8_t *report, size_t length, void *context)
+{
+    (*(uint32_t *)context)++;
+    return true;
+}
+
+static void printPipelineStats(const char *name, const ReportPipeline::Stats &stats)
+{
+    printf("%-32s submitted %u, coalesced %u, dropped %u, discarded %u, sent %u, failed %u\n", name,
+           stats.submitted, stats.coalesced, stats.dropped, stats.discarded, stats.sent, stats.failed);
+}
+
+// 10ms 运动节拍下，不同连接间隔的报告合并效果和每次提交的耗时
+static void runPipeline(const char *name, uint32_t connIntervalUs)
+{
+    hostsim::reset();
+    MotionEngine engine;
+    engine.reset(0);
+    uint32_t notifies = 0;
+    ReportPipeline pipeline(countReport, &notifies);
+    pipeline.setMinInterval(connIntervalUs);
+
+    const unsigned int steps = 1000000;
+    MotionEngine::Report *reports = new MotionEngine::Report[steps];
+    uint32_t nowUs = 0;
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        reports[i] = engine.step(nowUs);
+    }
+
+    nowUs = 0;
+    uint64_t start = benchNowNs();
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        pipeline.submit(reports[i].dx, reports[i].dy, nowUs);
+    }
+    uint64_t elapsed = benchNowNs() - start;
+    delete[] reports;
+
+    benchReport(name, "submit", steps, elapsed);
+    printPipelineStats(name, pipeline.stats());
+}
+
+BENCH_CASE(report_pipeline)
+{
+    runPipeline("report_pipeline_7.5ms", 7500);
+    runPipeline("report_pipeline_30ms", 30000);
+    runPipeline("report_pipeline_50ms", 50000);
+}
@@ -0,0 +1,226 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+#include "../include/settings_store.h"
+
+// NVS 替身的后备文件，每个用例结束时删除
+static std::string nvsFilePath()
+{
+    const char *dir = getenv("TMPDIR");
+    return std::string(dir && *dir ? dir : "/tmp") + "/ble_mouse_bench_nvs.bin";
+}
+
+static void useNvsFile(const std::string &path)
+{
+    remove(path.c_str());
+    hostsim::setNvsFile(path.c_str());
+    hostsim::reset();
+}
+
+static void releaseNvsFile(const std::string &path)
+{
+    hostsim::setNvsFile(nullptr);
+    hostsim::reset();
+    remove(path.c_str());
+}
+
+// 按后台任务的节奏写入待写入的修改：推进到最后一次修改 COMMIT_DELAY_MS 之后再调用 update()
+static void commitPending()
+{
+    hostsim::advanceMillis(SettingsStore::COMMIT_DELAY_MS);
+    SettingsStore::update(millis());
+}
+
+// 上电读取：冷启动（断电后从文件加载 NVS）和 NVS 已初始化时重新读取
+BENCH_CASE(settings_load)
+{
+    std::string path = nvsFilePath();
+    useNvsFile(path);
+    SettingsStore::begin();
+    SettingsStore::setMotionEnabled(true);
+    SettingsStore::setReportRate(ReportPipeline::RateMode::HZ_50);
+    commitPending();
+
+    const int iterations = 2000;
+    uint64_t coldNs = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        hostsim::reset();
+        uint64_t start = benchNowNs();
+        bool loaded = SettingsStore::begin();
+        coldNs += benchNowNs() - start;
+        benchKeep(loaded);
+        Logger::drain();
+    }
+    benchReport("settings_load.cold", "load", iterations, coldNs);
+
+    uint64_t start = benchNowNs();
+    for (int i = 0; i < iterations; i++)
+    {
+        bool loaded = SettingsStore::begin();
+        benchKeep(loaded);
+        Logger::drain();
+    }
+    benchReport("settings_load.warm", "load", iterations, benchNowNs() - start);
+    printf("%-32s record %u bytes, %u loads, %u rejected\n", "settings_load.stats",
+           (unsigned)sizeof(SettingsStore::Record), SettingsStore::stats().loads, SettingsStore::stats().rejected);
+    releaseNvsFile(path);
+}
+
+// 写入：每次修改后都写入（改造前按键每次切换都写入的开销）和内容未变时跳过的写入；
+// 两者都包含推进虚拟时钟的开销
+BENCH_CASE(settings_commit)
+{
+    std::string path = nvsFilePath();
+    useNvsFile(path);
+    SettingsStore::begin();
+    SettingsStore::resetStats();
+
+    const int iterations = 2000;
+    uint32_t writesBefore = hostsim::nvsWriteCount();
+    uint64_t start = benchNowNs();
+    for (int i = 1; i <= iterations; i++)
+    {
+        SettingsStore::setMotionEnabled(i & 1);
+        commitPending();
+    }
+    benchReport("settings_commit.changed", "commit", iterations, benchNowNs() - start);
+    uint32_t writes = hostsim::nvsWriteCount() - writesBefore;
+
+    start = benchNowNs();
+    for (int i = 0; i < iterations; i++)
+    {
+        SettingsStore::setMotionEnabled(true);
+        SettingsStore::setMotionEnabled(false);
+        commitPending();
+    }
+    benchReport("settings_commit.unchanged", "update", iterations, benchNowNs() - start);
+    Logger::drain();
+
+    SettingsStore::Stats stats = SettingsStore::stats();
+    printf("%-32s %u commits, %u skipped, %u failures, %u NVS writes, %u bytes\n", "settings_commit.stats",
+           stats.commits, stats.skipped, stats.failures, writes, hostsim::nvsBytesWritten());
+    releaseNvsFile(path);
+}
+
+struct ToggleScript {
+    const char *name;
+    uint32_t burstIntervalMs;   // 每轮开始的间隔
+    uint8_t presses;            // 每轮的短按次数
+    uint16_t pressGapMs;        // 同一轮内两次短按的间隔
+    uint8_t rateCycles;         // 每轮之后的双击次数（切换报告速率）
+};
+
+// 按设备上的调度方式运行固件：后台任务休眠到截止时间或写入时间，运动任务每 10ms 运行，虚拟时钟以 1ms 推进；
+// 按脚本投递按键事件，统计写入次数和修改到写入之间的最长时间（此期间断电会丢失修改）
+static void runScript(const ToggleScript &script, uint32_t durationMs, uint32_t &maxUnsavedMs)
+{
+    uint64_t startUs = hostsim::nowMicros();
+    uint64_t endUs = startUs + durationMs * 1000ull;
+    uint64_t nextHousekeepingUs = startUs;
+    uint64_t nextBurstUs = startUs;
+    uint64_t pendingSinceUs = 0;
+    uint32_t posted = EventQueue::stats().posted;
+    uint8_t pressesLeft = 0;
+    uint8_t cyclesLeft = 0;
+    uint64_t nextPressUs = 0;
+    while (hostsim::nowMicros() < endUs)
+    {
+        uint64_t nowUs = hostsim::nowMicros();
+        if (nowUs >= nextBurstUs)
+        {
+            pressesLeft = script.presses;
+            cyclesLeft = script.rateCycles;
+            nextPressUs = nowUs;
+            nextBurstUs += script.burstIntervalMs * 1000ull;
+        }
+        if ((pressesLeft || cyclesLeft) && nowUs >= nextPressUs)
+        {
+            if (pressesLeft)
+            {
+                EventQueue::post(EventQueue::EventId::BOOT_SHORT_PRESS);
+                pressesLeft--;
+            }
+            else
+            {
+                EventQueue::post(EventQueue::EventId::BOOT_DOUBLE_CLICK);
+                cyclesLeft--;
+            }
+            nextPressUs = nowUs + script.pressGapMs * 1000ull;
+        }
+
+        uint32_t postedNow = EventQueue::stats().posted;
+        if (postedNow != posted || nowUs >= nextHousekeepingUs)
+        {
+            AppTasks::housekeepingStep(0);
+            Logger::drain();
+            posted = EventQueue::stats().posted;
+            uint32_t waitMs = AppTasks::msUntilHousekeeping(millis());
+            nextHousekeepingUs = waitMs == AppTasks::NO_DEADLINE ? UINT64_MAX : hostsim::nowMicros() + waitMs * 1000ull;
+        }
+        if ((nowUs - startUs) % 10000 == 0)
+        {
+            AppTasks::motionStep();
+        }
+
+        if (SettingsStore::pending() && !pendingSinceUs)
+        {
+            pendingSinceUs = nowUs;
+        }
+        else if (!SettingsStore::pending() && pendingSinceUs)
+        {
+            uint32_t unsavedMs = (uint32_t)((nowUs - pendingSinceUs) / 1000);
+            maxUnsavedMs = unsavedMs > maxUnsavedMs ? unsavedMs : maxUnsavedMs;
+            pendingSinceUs = 0;
+        }
+        hostsim::advanceMicros(1000);
+    }
+}
+
+// 已连接时按脚本切换鼠标移动和报告速率 10 分钟，与每次切换都写入（改造前若直接持久化）对比写入次数；
+// 断电重启后恢复状态的断言在 test/test_settings 中
+BENCH_CASE(settings_coalescing)
+{
+    const ToggleScript scripts[] = {
+        {"single", 60000, 1, 0, 0},        // 每分钟切换一次
+        {"burst", 60000, 5, 400, 0},       // 每分钟连按 5 次
+        {"fidget", 2000, 1, 0, 0},         // 每 2 秒切换一次
+        {"rate_cycle", 60000, 1, 600, 3}   // 每分钟切换一次并连续双击 3 次
+    };
+    const uint32_t runMs = 600000;
+    std::string path = nvsFilePath();
+
+    for (const ToggleScript &script : scripts)
+    {
+        useNvsFile(path);
+        AppTasks::setReportRate(ReportPipeline::RateMode::HZ_100);
+        setup();
+        hostsim::connect();
+        AppTasks::housekeepingStep(0);
+        SettingsStore::resetStats();
+        uint32_t writesBefore = hostsim::nvsWriteCount();
+
+        uint32_t maxUnsavedMs = 0;
+        runScript(script, runMs, maxUnsavedMs);
+        ToggleScript idle = {script.name, runMs, 0, 0, 0};
+        runScript(idle, SettingsStore::MAX_COMMIT_DELAY_MS + 1000, maxUnsavedMs);
+
+        SettingsStore::Stats stats = SettingsStore::stats();
+        uint32_t writes = hostsim::nvsWriteCount() - writesBefore;
+        char name[64];
+        snprintf(name, sizeof(name), "settings_coalescing.%s", script.name);
+        printf("%-36s %4u changes, %3u NVS writes (%5.1f%%), %3u skipped, max unsaved %5u ms\n",
+               name, stats.changes, writes, stats.changes ? writes * 100.0 / stats.changes : 0.0, stats.skipped,
+               maxUnsavedMs);
+    }
+    hostsim::disconnect();
+    AppTasks::setReportRate(ReportPipeline::RateMode::HZ_100);
+    releaseNvsFile(path);
+}
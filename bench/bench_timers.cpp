@@ -0,0 +1,26 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include "../src/state_machine.h"
+#include "../include/logger.h"
+#include "../include/timer_service.h"
+
+typedef TimerService::TimerId TimerId;
+
+// 一次 arm()/cancel() 的开销；超时转换的检查在 test/test_timeouts 中
+BENCH_CASE(fsm_timeouts)
+{
+    hostsim::reset();
+    setup();
+    TimerService::resetStats();
+    Logger::drain();
+
+    const unsigned int iterations = 1000000;
+    uint64_t start = benchNowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        TimerService::arm(TimerId::PAIRING_TIMEOUT, 60000);
+        TimerService::cancel(TimerId::PAIRING_TIMEOUT);
+    }
+    benchReport("fsm_timeouts.arm_cancel", "pair", iterations, benchNowNs() - start);
+}
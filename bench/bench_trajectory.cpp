@@ -0,0 +1,284 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "../src/state_machine.h"
+#include "../include/app_tasks.h"
+#include "../include/event_queue.h"
+#include "../include/logger.h"
+#include "../include/motion_engine.h"
+#include "../include/trajectory.h"
+#include "../include/trajectory_player.h"
+
+struct Sample {
+    uint32_t timeUs;
+    int8_t dx;
+    int8_t dy;
+};
+
+// 录制 MotionEngine 按 periodUs 输出的报告（含停顿中的全零报告）
+static std::vector<Sample> recordEngine(uint32_t periodUs, uint32_t durationMs)
+{
+    hostsim::reset();
+    MotionEngine engine;
+    engine.reset(0);
+    std::vector<Sample> samples;
+    for (uint32_t nowUs = periodUs; nowUs <= durationMs * 1000u; nowUs += periodUs)
+    {
+        MotionEngine::Report report = engine.step(nowUs);
+        Sample sample = {nowUs, report.dx, report.dy};
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+static std::vector<uint8_t> encode(const std::vector<Sample> &samples, uint32_t endUs,
+                                   Trajectory::Encoder::Stats *stats = nullptr)
+{
+    std::vector<uint8_t> buffer(Trajectory::HEADER_SIZE + samples.size() * 4 + 16);
+    Trajectory::Encoder encoder(buffer.data(), buffer.size());
+    for (const Sample &sample : samples)
+    {
+        encoder.add(sample.timeUs, sample.dx, sample.dy);
+    }
+    buffer.resize(encoder.finish(endUs));
+    if (stats)
+    {
+        *stats = encoder.stats();
+    }
+    return buffer;
+}
+
+// 顺序解码为带绝对时间的非零位移（REPEAT 展开），返回记录数；格式错误时返回 0
+static uint32_t decodeAll(const std::vector<uint8_t> &file, std::vector<Sample> *out)
+{
+    Trajectory::Header header;
+    if (!Trajectory::parseHeader(file.data(), file.size(), header))
+    {
+        return 0;
+    }
+    const uint8_t *data = file.data() + Trajectory::HEADER_SIZE;
+    size_t length = header.length;
+    size_t pos = 0;
+    uint32_t units = 0;
+    uint32_t records = 0;
+    Sample last = {0, 0, 0};
+    while (pos < length)
+    {
+        Trajectory::Record record;
+        int used = Trajectory::decodeRecord(data + pos, length - pos, record);
+        if (used <= 0)
+        {
+            return 0;
+        }
+        pos += used;
+        records++;
+        if (record.kind == Trajectory::END)
+        {
+            break;
+        }
+        uint32_t repeats = record.kind == Trajectory::DELTA ? 1 : record.count;
+        if (record.kind == Trajectory::DELTA)
+        {
+            last.dx = record.dx;
+            last.dy = record.dy;
+        }
+        for (uint32_t i = 0; i < repeats; i++)
+        {
+            units += record.dt;
+            last.timeUs = units * header.unitUs;
+            if (out)
+            {
+                out->push_back(last);
+            }
+        }
+    }
+    return records;
+}
+
+// 编码 MotionEngine 10 分钟的输出：每秒移动占用的字节数、与不压缩的 6 字节/报告（32 位时间戳 + dx/dy）对比，
+// 并检查解码结果与原始报告逐份一致
+BENCH_CASE(trajectory_encode)
+{
+    const uint32_t periods[] = {10000, 7500, 20000};
+    const uint32_t durationMs = 600000;
+    for (uint32_t periodUs : periods)
+    {
+        std::vector<Sample> samples = recordEngine(periodUs, durationMs);
+        Trajectory::Encoder::Stats stats;
+        uint64_t start = benchNowNs();
+        std::vector<uint8_t> file = encode(samples, durationMs * 1000u, &stats);
+        uint64_t encodeNs = benchNowNs() - start;
+
+        std::vector<Sample> decoded;
+        decodeAll(file, &decoded);
+        uint32_t mismatches = 0;
+        size_t index = 0;
+        for (const Sample &sample : samples)
+        {
+            if (sample.dx == 0 && sample.dy == 0)
+            {
+                continue;
+            }
+            if (index >= decoded.size() || decoded[index].timeUs != sample.timeUs ||
+                decoded[index].dx != sample.dx || decoded[index].dy != sample.dy)
+            {
+                mismatches++;
+            }
+            index++;
+        }
+        mismatches += (uint32_t)(decoded.size() > index ? decoded.size() - index : 0);
+
+        size_t rawBytes = samples.size() * 6;
+        char name[64];
+        snprintf(name, sizeof(name), "trajectory_encode.%.1fms", periodUs / 1000.0);
+        printf("%-32s %6zu reports (%5u moving), %6zu bytes, %6.1f B/s (raw %6.1f B/s, %4.1f%%), "
+               "%u deltas, %u repeats, %.1f ns/report encode, %u mismatches\n",
+               name, samples.size(), stats.samples, file.size(), file.size() * 1000.0 / durationMs,
+               rawBytes * 1000.0 / durationMs, file.size() * 100.0 / rawBytes, stats.deltas, stats.repeats,
+               (double)encodeNs / samples.size(), mismatches);
+    }
+}
+
+// 解码吞吐：内存中的整段记录逐条解码，以及经播放器（双缓冲、跨块拼接）解码
+struct MemorySource {
+    const std::vector<uint8_t> *file;
+    uint32_t reads;
+};
+
+static size_t readMemory(uint32_t offset, uint8_t *buffer, size_t length, void *context)
+{
+    MemorySource *source = (MemorySource *)context;
+    if (offset + length > source->file->size())
+    {
+        return 0;
+    }
+    memcpy(buffer, source->file->data() + offset, length);
+    source->reads++;
+    return length;
+}
+
+BENCH_CASE(trajectory_decode)
+{
+    std::vector<Sample> samples = recordEngine(10000, 600000);
+    std::vector<uint8_t> file = encode(samples, 600000000u);
+
+    const int passes = 50;
+    uint64_t records = 0;
+    uint64_t start = benchNowNs();
+    for (int i = 0; i < passes; i++)
+    {
+        records += decodeAll(file, nullptr);
+    }
+    uint64_t elapsed = benchNowNs() - start;
+    benchReport("trajectory_decode.records", "record", records, elapsed);
+    printf("%-32s %.1f MB/s\n", "trajectory_decode.throughput", file.size() * (double)passes * 1e3 / elapsed);
+
+    // 播放器每次 step() 推进 10ms，数据总是就绪
+    MemorySource source = {&file, 0};
+    TrajectoryPlayer player;
+    player.open(readMemory, &source, (uint32_t)file.size());
+    player.resume(0);
+    uint32_t nowUs = 0;
+    const uint32_t steps = 600000 / 10 * 5;
+    int32_t sum = 0;
+    start = benchNowNs();
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        nowUs += 10000;
+        TrajectoryPlayer::Output output = player.step(nowUs);
+        sum += output.dx + output.dy;
+        if (player.needsFill())
+        {
+            player.fill();
+        }
+    }
+    elapsed = benchNowNs() - start;
+    benchKeep(sum);
+    benchReport("trajectory_decode.player_step", "step", steps, elapsed);
+    printf("%-32s %u loops, %u blocks, %u underruns, %u format errors, %zu bytes RAM\n",
+           "trajectory_decode.player", player.stats().loops, player.stats().blocks, player.stats().underruns,
+           player.stats().formatErrors, sizeof(TrajectoryPlayer));
+}
+
+// 流式播放：运动任务每 10ms step()，后台任务在收到通知 fillDelayMs 之后才读入块；
+// 与原始报告逐步比对（每步正好输出该 10ms 内到期的位移），统计 underrun
+BENCH_CASE(trajectory_stream)
+{
+    std::vector<Sample> samples = recordEngine(10000, 600000);
+    std::vector<uint8_t> file = encode(samples, 600000000u);
+    const uint32_t delays[] = {0, 10, 100, 500, 2000};
+
+    for (uint32_t fillDelayMs : delays)
+    {
+        MemorySource source = {&file, 0};
+        TrajectoryPlayer player;
+        player.open(readMemory, &source, (uint32_t)file.size());
+        player.resume(0);
+
+        uint32_t mismatches = 0;
+        uint32_t fillAtMs = 0;
+        bool fillPending = false;
+        for (uint32_t i = 0; i < samples.size(); i++)
+        {
+            uint32_t nowMs = (i + 1) * 10;
+            if (fillPending && nowMs >= fillAtMs)
+            {
+                player.fill();
+                fillPending = false;
+            }
+            TrajectoryPlayer::Output output = player.step(nowMs * 1000);
+            if (output.dx != samples[i].dx || output.dy != samples[i].dy)
+            {
+                mismatches++;
+            }
+            if (player.needsFill() && !fillPending)
+            {
+                fillPending = true;
+                fillAtMs = nowMs + fillDelayMs;
+                if (fillDelayMs == 0)
+                {
+                    player.fill();
+                    fillPending = false;
+                }
+            }
+        }
+        const TrajectoryPlayer::Stats &stats = player.stats();
+        char name[64];
+        snprintf(name, sizeof(name), "trajectory_stream.fill_%ums", fillDelayMs);
+        printf("%-32s %5u blocks (%4.2f/s), %5u underruns, %5u step mismatches of %zu\n", name, stats.blocks,
+               stats.blocks / 600.0, stats.underruns, mismatches, samples.size());
+    }
+
+    // 固件中播放 motion 分区的轨迹：后台任务读块，运动任务按 100Hz 报告
+    hostsim::setPartition("motion", 0x01, 0x40, file.data(), file.size(), 0x160000);
+    hostsim::reset();
+    setup();
+    hostsim::connect();
+    AppTasks::housekeepingStep(0);
+    if (!BleMouseState::is_in_state<MouseMotionEnable>())
+    {
+        EventQueue::post(EventQueue::EventId::BOOT_SHORT_PRESS);
+        AppTasks::housekeepingStep(0);
+    }
+    uint32_t notifiesBefore = hostsim::notifyCount();
+    uint32_t readsBefore = hostsim::partitionReadCount();
+    for (uint32_t ms = 0; ms < 60000; ms += 10)
+    {
+        AppTasks::motionStep();
+        AppTasks::housekeepingStep(0);
+        Logger::drain();
+        hostsim::advanceMillis(10);
+    }
+    const TrajectoryPlayer::Stats &stats = AppTasks::trajectoryStats();
+    printf("%-32s playing %s, %u reports in 60 s, %u records, %u partition reads, %u underruns\n",
+           "trajectory_stream.firmware", AppTasks::playingTrajectory() ? "yes" : "no",
+           hostsim::notifyCount() - notifiesBefore, stats.records, hostsim::partitionReadCount() - readsBefore,
+           stats.underruns);
+
+    hostsim::disconnect();
+    hostsim::removePartition("motion");
+    hostsim::reset();
+}
@@ -0,0 +1,136 @@
+#include "bench.h"
+#include <Arduino.h>
+#include <host_sim.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "../include/fixed_point.h"
+#include "../include/prng.h"
+#include "../include/tremor.h"
+
+// 每个采样（两个轴）的耗时：原先每步两次 random() 和两次浮点除法，以及改用 Prng 后的定点写法
+BENCH_CASE(tremor_cost)
+{
+    const unsigned int samples = 10000000;
+    hostsim::reset();
+
+    float floatSum = 0;
+    uint64_t start = benchNowCycles();
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        floatSum += random(-100, 100) / 1000.0;
+        floatSum += random(-100, 100) / 1000.0;
+    }
+    benchReportCycles("tremor_cost.random_divide", "sample", samples, benchNowCycles() - start);
+    benchKeep(floatSum);
+
+    Prng rng;
+    int32_t sum = 0;
+    start = benchNowCycles();
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        sum += rng.range(-100, 100) * fixed::Q16_ONE / 10;
+        sum += rng.range(-100, 100) * fixed::Q16_ONE / 10;
+    }
+    benchReportCycles("tremor_cost.prng_white", "sample", samples, benchNowCycles() - start);
+
+    Tremor tremor;
+    start = benchNowCycles();
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        Tremor::Sample sample = tremor.step(10000);
+        sum += sample.x + sample.y;
+    }
+    benchReportCycles("tremor_cost.tremor", "sample", samples, benchNowCycles() - start);
+    benchKeep(sum);
+}
+
+static double autocorrelation(const std::vector<double> &x, size_t lag)
+{
+    double sum = 0, energy = 0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        energy += x[i] * x[i];
+        if (i + lag < x.size())
+        {
+            sum += x[i] * x[i + lag];
+        }
+    }
+    return energy > 0 ? sum / energy : 0;
+}
+
+// 按 100Hz 采样 10 分钟：自相关（白噪声在滞后 1 步时约为 0）、两轴互相关、幅度，
+// 以及一段 4096 点的 DFT 中高于 2 倍晶格频率的能量占比（只输出数值，断言在 test/test_tremor 中）
+BENCH_CASE(tremor_spectrum)
+{
+    const uint32_t periodUs = 10000;
+    const size_t count = 60000;
+    const float frequencies[] = {3.0f, 6.0f, 12.0f};
+    hostsim::reset();
+
+    std::vector<double> white(count);
+    Prng rng;
+    for (size_t i = 0; i < count; i++)
+    {
+        white[i] = rng.range(-100, 100);
+    }
+    printf("%-32s white noise r(1) %+.3f, r(5) %+.3f\n", "tremor_spectrum.white", autocorrelation(white, 1),
+           autocorrelation(white, 5));
+
+    for (float frequency : frequencies)
+    {
+        Tremor::Config config;
+        config.frequency = frequency;
+        Tremor tremor(config);
+        tremor.seed(12345);
+        std::vector<double> x(count), y(count);
+        double peak = 0, cross = 0, energyX = 0, energyY = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            Tremor::Sample sample = tremor.step(periodUs);
+            x[i] = fixed::q16ToFloat(sample.x);
+            y[i] = fixed::q16ToFloat(sample.y);
+            peak = fabs(x[i]) > peak ? fabs(x[i]) : peak;
+            cross += x[i] * y[i];
+            energyX += x[i] * x[i];
+            energyY += y[i] * y[i];
+        }
+        cross /= sqrt(energyX * energyY);
+
+        // 自相关第一次降到 0 以下的滞后（约半个晶格间距）
+        size_t zeroLag = 0;
+        for (size_t lag = 1; lag < 200; lag++)
+        {
+            if (autocorrelation(x, lag) < 0)
+            {
+                zeroLag = lag;
+                break;
+            }
+        }
+
+        const size_t window = 4096;
+        const double sampleRate = 1e6 / periodUs;
+        double low = 0, high = 0;
+        for (size_t k = 1; k < window / 2; k++)
+        {
+            double re = 0, im = 0;
+            for (size_t n = 0; n < window; n++)
+            {
+                double angle = 2 * M_PI * k * n / window;
+                re += x[n] * cos(angle);
+                im -= x[n] * sin(angle);
+            }
+            double power = re * re + im * im;
+            (k * sampleRate / window > 2 * frequency ? high : low) += power;
+        }
+
+        double r1 = autocorrelation(x, 1);
+        double highShare = high / (low + high);
+        char name[64];
+        snprintf(name, sizeof(name), "tremor_spectrum.%.0fHz", frequency);
+        printf("%-32s r(1) %+.3f, first r<0 at lag %3zu (%5.1f ms), x/y %+.3f, rms %5.1f, peak %5.1f/%.0f counts/s, "
+               "%4.1f%% power above %.0f Hz\n",
+               name, r1, zeroLag, zeroLag * periodUs / 1000.0, cross, sqrt(energyX / count), peak, config.amplitude,
+               highShare * 100, 2 * frequency);
+    }
+}
@@ -0,0 +1,137 @@
+#include "motion_float_reference.h"
+#include <Arduino.h>
+#include <math.h>
+
+void FloatMotionReference::reset(uint32_t nowUs)
+{
+    velocityX = 0.0f;
+    velocityY = 0.0f;
+    targetVelocityX = 0.0f;
+    targetVelocityY = 0.0f;
+    angle = 0.0f;
+    radius = 10.0f; // 初始移动幅度
+    patternChangeUs = nowUs;
+    phaseStartUs = nowUs;
+    pattern = MotionEngine::Pattern::RANDOM_WALK;
+    inMovePhase = true; // 从移动阶段开始
+    tremor.reset();
+    moveDurationMs = rng.range(cfg.minMoveMs, cfg.maxMoveMs);    // 随机移动时间
+    pauseDurationMs = rng.range(cfg.minPauseMs, cfg.maxPauseMs); // 随机停顿时间
+}
+
+MotionEngine::Report FloatMotionReference::step(uint32_t nowUs)
+{
+    MotionEngine::Report report = {0, 0, MotionEngine::EVENT_NONE};
+
+    // 管理移动和停顿周期
+    uint32_t phaseElapsedMs = (nowUs - phaseStartUs) / 1000;
+    if (inMovePhase)
+    {
+        if (phaseElapsedMs > moveDurationMs)
+        {
+            // 切换到停顿阶段，随机设置停顿时间并停止移动
+            inMovePhase = false;
+            phaseStartUs = nowUs;
+            pauseDurationMs = rng.range(cfg.minPauseMs, cfg.maxPauseMs);
+            velocityX = 0.0f;
+            velocityY = 0.0f;
+            targetVelocityX = 0.0f;
+            targetVelocityY = 0.0f;
+            report.events |= MotionEngine::EVENT_PAUSE_STARTED;
+        }
+    }
+    else
+    {
+        if (phaseElapsedMs > pauseDurationMs)
+        {
+            // 切换到移动阶段，随机设置移动时间
+            inMovePhase = true;
+            phaseStartUs = nowUs;
+            moveDurationMs = rng.range(cfg.minMoveMs, cfg.maxMoveMs);
+            report.events |= MotionEngine::EVENT_MOVE_STARTED;
+
+            // 30%概率改变模式
+            if (rng.below(100) < 30)
+            {
+                pickPattern();
+                report.events |= MotionEngine::EVENT_PATTERN_CHANGED;
+            }
+        }
+    }
+
+    if (inMovePhase)
+    {
+        // 每隔一段时间改变移动模式
+        if ((nowUs - patternChangeUs) / 1000 > cfg.patternChangeIntervalMs)
+        {
+            pickPattern();
+            patternChangeUs = nowUs;
+            report.events |= MotionEngine::EVENT_PATTERN_CHANGED;
+        }
+
+        computeTargetVelocity(nowUs / 1000);
+
+        // 叠加平滑的抖动速度（计数/秒换算为每步计数），模拟手部微小抖动
+        Tremor::Sample jitter = tremor.step(10000);
+        targetVelocityX += jitter.x / 6553600.0f;
+        targetVelocityY += jitter.y / 6553600.0f;
+
+        // 平滑过渡到目标速度（模拟人体动作的惯性）
+        velocityX += (targetVelocityX - velocityX) * SMOOTH_FACTOR;
+        velocityY += (targetVelocityY - velocityY) * SMOOTH_FACTOR;
+
+        // 限制最大速度
+        float speed = sqrt(velocityX * velocityX + velocityY * velocityY);
+        if (speed > MAX_SPEED)
+        {
+            velocityX = (velocityX / speed) * MAX_SPEED;
+            velocityY = (velocityY / speed) * MAX_SPEED;
+        }
+    }
+    else
+    {
+        // 停顿阶段，逐渐减速到0
+        velocityX *= PAUSE_DECAY;
+        velocityY *= PAUSE_DECAY;
+        targetVelocityX = 0.0f;
+        targetVelocityY = 0.0f;
+    }
+
+    // 转换为整数移动值
+    report.dx = (int8_t)constrain(velocityX, -127, 127);
+    report.dy = (int8_t)constrain(velocityY, -127, 127);
+    return report;
+}
+
+void FloatMotionReference::computeTargetVelocity(uint32_t nowMs)
+{
+    float randomSpeed;
+    switch (pattern)
+    {
+    default:                              // 参考实现没有规划模式和后来加入的模式
+    case MotionEngine::Pattern::RANDOM_WALK:
+        angle += rng.uniform(-0.3f, 0.3f); // 随机转向
+        randomSpeed = radius * (0.5 + 0.5 * sin(nowMs * 0.001));
+        targetVelocityX = randomSpeed * cos(angle);
+        targetVelocityY = randomSpeed * sin(angle);
+        break;
+
+    case MotionEngine::Pattern::CIRCLE:
+        angle += 0.05; // 缓慢旋转
+        targetVelocityX = radius * cos(angle);
+        targetVelocityY = radius * sin(angle);
+        break;
+
+    case MotionEngine::Pattern::FIGURE_EIGHT:
+        angle += 0.03;
+        targetVelocityX = radius * sin(angle);
+        targetVelocityY = radius * sin(angle * 2) * 0.5;
+        break;
+    }
+}
+
+void FloatMotionReference::pickPattern()
+{
+    pattern = (MotionEngine::Pattern)rng.below(3); // 随机选择移动模式
+    radius = rng.uniform(5.0f, 15.0f); // 随机移动幅度
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// 浮点版运动生成器：定点化之前 MotionEngine 的原始实现，仅用于主机端对比
+// 周期、事件和随机数消耗顺序与 MotionEngine 一致，用同一种子可逐步比较输出
+// 速度、平滑和衰减仍按每步计算（原 10ms 节拍下的参数），不随调用频率缩放
+
+#include "../include/motion_engine.h"
+#include "../include/prng.h"
+
+class FloatMotionReference {
+public:
+    void seed(uint32_t value)
+    {
+        rng.seed(value);
+        tremor.seed(value);
+    }
+    void reset(uint32_t nowUs);
+    MotionEngine::Report step(uint32_t nowUs);
+
+private:
+    void computeTargetVelocity(uint32_t nowMs);
+    void pickPattern();
+
+    static constexpr float MAX_SPEED = 20.0f;     // 每步的计数
+    static constexpr float SMOOTH_FACTOR = 0.1f;
+    static constexpr float PAUSE_DECAY = 0.9f;
+
+    MotionEngine::Config cfg;
+    Prng rng;
+    Tremor tremor;   // 与 MotionEngine 共用整数实现，按每步 10ms 推进
+    float velocityX;
+    float velocityY;
+    float targetVelocityX;
+    float targetVelocityY;
+    float angle;
+    float radius;
+    uint32_t patternChangeUs;
+    uint32_t phaseStartUs;
+    uint16_t moveDurationMs;
+    uint16_t pauseDurationMs;
+    MotionEngine::Pattern pattern;
+    bool inMovePhase;
+};
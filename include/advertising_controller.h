@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+#include <atomic>
+
+// 广播控制器：状态机只表达“需要广播/需要重新开始广播/停止广播”，不等待、不延时
+// - NimBLE 的 stop() 同步结束广播，restart() 停止后立即以当前配置重新启动
+// - start() 失败（协议栈忙）时由 TimerService 的 ADVERTISING_RETRY 定时器在 RETRY_MS 后投递 AdvertisingRetry，不阻塞调用方
+// - 需要广播期间广播意外结束（广播结束回调）且没有连接时投递 AdvertisingRetry 重新启动
+// 广播的启动和停止只在状态机（后台任务）中进行：ensure()/restart()/stop()/retry() 都只能在那里调用，
+// 定时器和 NimBLE 回调只投递事件，与 stop() 之间没有竞争
+class AdvertisingController {
+public:
+    // 广播参数，在下一次启动时生效
+    struct Params {
+        bool directed;          // 定向广播到 peer（只有该设备可以连接）
+        NimBLEAddress peer;
+        bool acceptListOnly;    // 只接受过滤接受列表（白名单）中设备的扫描和连接请求
+        uint16_t minInterval;   // 单位 0.625ms，0 表示协议栈默认（30~60ms）
+        uint16_t maxInterval;
+    };
+
+    struct Stats {
+        uint32_t starts;         // 成功启动
+        uint32_t restarts;       // restart() 调用
+        uint32_t retries;        // 启动失败后的重试
+        uint32_t completions;    // 广播结束回调（连接建立或超时）
+        uint32_t lastLatencyUs;  // 最近一次从触发事件到广播启动的时间
+        uint32_t maxLatencyUs;
+    };
+
+    static const uint32_t RETRY_MS = 20;
+
+    // 注册广播结束回调并取消未完成的重试；可重复调用，TimerService::begin() 须已调用
+    static void begin(NimBLEAdvertising *advertising);
+
+    // 公开的非定向广播、协议栈默认间隔
+    static Params defaultParams();
+    // 设置之后启动时使用的参数；与当前广播的参数不同时，下一次 ensure() 会重新启动广播
+    static void setParams(const Params &params);
+    static const Params &params();
+    // 参数在当前广播启动之后被修改，尚未生效
+    static bool paramsPending();
+    // 按参数估算的平均广播事件间隔：间隔范围的中点加上 advDelay（0~10ms）的平均 5ms
+    static uint32_t eventIntervalUs(const Params &params);
+
+    // 确保正在以当前参数广播，已在广播且参数未变时不做任何操作；originUs 为触发事件的时刻（micros()），用于统计延迟
+    // 返回广播是否已启动，false 表示稍后重试
+    static bool ensure(uint32_t originUs);
+    // 停止当前广播并立即重新启动，使新的配置和配对请求生效
+    static bool restart(uint32_t originUs);
+    // 停止广播并取消重试
+    static void stop();
+    // AdvertisingRetry：仍需要广播且未在广播时重新启动，失败时再次安排重试
+    static void retry();
+
+    static bool advertising();
+
+    static Stats stats();
+    static void resetStats();
+
+private:
+    static bool tryStart();
+    static void scheduleRetry();
+    static void onComplete(NimBLEAdvertising *advertising);
+
+    static NimBLEAdvertising *adv;
+    static std::atomic<bool> wanted;   // 广播结束回调（NimBLE 主机任务）也会读取
+    static std::atomic<uint32_t> pendingOriginUs;
+    static Params current;
+    static bool paramsChanged;   // 参数在当前广播启动之后被修改
+    static Stats counters;
+};
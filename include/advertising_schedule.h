@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+// 分阶段广播计划：每个需要广播的状态在 entry() 中启动自己的计划，广播方式和间隔按进入状态后的时间逐级切换，
+// 刚开始广播（有人正在连接）时用短间隔，之后逐步放宽以降低射频占空比
+// - 阶段切换由 TimerService 的 ADVERTISING_STAGE 定时器投递 AdvertisingStageTimeout，在状态机中完成
+// - 广播由 AdvertisingController 启动，只在参数变化（或调用方要求）时重新启动
+// - 每个阶段统计进入次数、广播时间、估算的广播事件数和在该阶段建立的连接数
+//   （NimBLE 不报告单个广播事件，按平均间隔加上 advDelay 的平均 5ms 估算）
+class AdvertisingSchedule {
+public:
+    enum class ScheduleId : uint8_t {
+        IDLE,               // 公开广播，等待任意主机
+        PAIRING,            // 公开广播，用户正在配对
+        RECONNECT_BONDED,   // 等待已绑定的主机重连
+        RECONNECT_OPEN,     // 没有绑定时的重连
+        COUNT
+    };
+
+    struct Stage {
+        const char *name;
+        bool directed;          // 定向广播到 setPeer() 设置的地址
+        bool acceptListOnly;    // 只接受过滤接受列表中的主机
+        uint16_t minInterval;   // 单位 0.625ms，0 表示协议栈默认（30~60ms）
+        uint16_t maxInterval;
+        uint32_t untilMs;       // 该阶段在计划开始后多久结束，0 表示一直持续（只能用于最后一个阶段）
+    };
+
+    struct StageStats {
+        uint32_t entries;
+        uint32_t activeMs;      // 累计广播时间
+        uint32_t events;        // 估算的广播事件数
+        uint32_t connects;      // 在该阶段建立的连接
+    };
+
+    static const uint8_t MAX_STAGES = 4;
+
+    // 替换计划的阶段表（count 不超过 MAX_STAGES），表须在使用期间保持有效；下一次 start() 时生效
+    static void setSchedule(ScheduleId id, const Stage *stages, uint8_t count);
+    // 定向广播的目标地址
+    static void setPeer(const NimBLEAddress &peer);
+
+    // 从第一个阶段开始执行计划；originUs 为触发事件的时刻，用于统计广播启动延迟；
+    // restart 为 true 时即使参数未变也重新启动广播（使新的配对请求生效）
+    // 返回广播是否已启动，false 表示稍后重试
+    static bool start(ScheduleId id, uint32_t originUs, bool restart = false);
+    // AdvertisingStageTimeout：进入下一阶段，计划已结束时忽略
+    static void advance();
+    // 连接建立：记入当前阶段，结束计划并停止广播
+    static void onConnected();
+    // 结束计划并停止广播
+    static void stop();
+
+    static bool running();
+    static ScheduleId schedule();
+    static uint8_t stage();
+    static const Stage *stages(ScheduleId id);
+    static uint8_t stageCount(ScheduleId id);
+    static const char *stageName(ScheduleId id, uint8_t stage);
+    static const char *name(ScheduleId id);
+
+    static StageStats stageStats(ScheduleId id, uint8_t stage);
+    static void resetStats();
+
+private:
+    static bool enterStage(uint8_t stage, uint32_t originUs, bool restart);
+    static void closeStage();
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "report_pipeline.h"
+#include "button_engine.h"
+#include "motion_engine.h"
+#include "trajectory_player.h"
+
+// 按键引脚定义
+#define BOOT_BUTTON_PIN 9 // BOOT 按键，低电平有效
+
+// 固件的任务划分，各任务之间只通过固定长度的队列通信：
+// - 运动任务（最高优先级）：按报告速率档位的周期计算运动并发送 HID 报告，不做任何串口或 LED 操作；
+//   停止移动时阻塞到下一条命令，不周期唤醒
+// - 后台任务（最低优先级）：分发状态机事件、输出运动日志，空闲时休眠到下一个事件或设置的写入时间
+// 状态机事件（按键手势、连接/断开等）一律投递到 EventQueue，由后台任务唯一分发；
+// 按键由 ButtonEngine 在中断和 esp_timer 中消抖并识别手势，LED 图案由 LEDController 的定时器驱动
+class AppTasks {
+public:
+    enum class TaskId : uint8_t {
+        MOTION,
+        HOUSEKEEPING,
+        COUNT
+    };
+
+    // 运动控制命令（状态机 -> 运动任务）
+    enum class MotionCommand : uint8_t {
+        ENABLE,   // 重新开始自然移动
+        DISABLE   // 停止移动并清空报告
+    };
+
+    // 调度统计，单位微秒
+    struct TaskStats {
+        uint32_t iterations;
+        uint32_t maxLateUs;   // 相对计划唤醒时间的最大延迟
+        uint32_t maxRunUs;    // 单次执行的最长耗时
+    };
+
+    // msUntilHousekeeping() 没有截止时间时的返回值：后台任务只被任务通知唤醒
+    static const uint32_t NO_DEADLINE = 0xFFFFFFFF;
+
+    static const UBaseType_t MOTION_PRIORITY = 5;
+    static const UBaseType_t HOUSEKEEPING_PRIORITY = 2;
+
+    // 创建队列（幂等）、清空状态机事件、创建超时定时器、安装按键引擎并打开录制的轨迹
+    static void init();
+
+    // 创建全部任务
+    static void start();
+
+    // 状态机请求开启/关闭鼠标移动，不阻塞
+    static void requestMotion(bool enabled);
+
+    // 各任务的单次执行体：任务循环和主机端单线程仿真共用
+    static void motionStep();
+    // 休眠到有事件投递（含 TimerService 投递的状态超时）、运动日志到达或设置的写入时间（最多 maxWaitTicks），
+    // 然后分发事件、输出运动日志、读入轨迹的下一个块并写入到期的设置
+    static void housekeepingStep(TickType_t maxWaitTicks);
+    // 距后台任务下一个截止时间（设置的写入时间）的毫秒数，没有时返回 NO_DEADLINE
+    static uint32_t msUntilHousekeeping(uint32_t nowMs);
+    // 不投递事件而唤醒后台任务，可在任意任务中调用
+    static void wakeHousekeeping();
+
+    static const TaskStats &stats(TaskId id);
+    static void resetStats();
+
+    // 报告整形统计（提交、合并、丢弃、发送、失败、退避）
+    static const ReportPipeline::Stats &reportStats();
+
+    // 报告速率档位：可从任意任务调用，运动任务在下一周期生效并按档位间隔调整自身周期
+    static void setReportRate(ReportPipeline::RateMode mode);
+    static ReportPipeline::RateMode reportRate();
+
+    // 运动参数：只能在 start() 之前调用（运动引擎由运动任务独占）
+    static void setMotionConfig(const MotionEngine::Config &config);
+
+    // 是否在播放 motion 分区中录制的轨迹（init() 时检测），以及播放统计
+    static bool playingTrajectory();
+    static const TrajectoryPlayer::Stats &trajectoryStats();
+
+    // 当前退避级别和实际发送间隔（含连接间隔限制和退避）
+    static uint8_t reportBackoffLevel();
+    static uint32_t reportIntervalUs();
+
+private:
+    static void motionTask(void *);
+    static void housekeepingTask(void *);
+
+    static void openTrajectory();
+    static void recordRun(TaskId id, uint32_t plannedUs, uint32_t startUs);
+    static void printMotionLog();
+    static void postButtonEvent(const ButtonEngine::Event &event, void *);
+
+    static QueueHandle_t motionCommandQueue;
+    static QueueHandle_t motionLogQueue;
+    static TaskStats taskStats[(int)TaskId::COUNT];
+    static std::atomic<uint8_t> requestedRate;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <atomic>
+
+// 按键引擎：GPIO 中断记录边沿，esp_timer 在边沿停止抖动后采样稳定电平，
+// 手势识别在定时器回调中完成，全程不轮询、不阻塞任何任务
+// - 单击/双击/三击：松开后 MULTI_CLICK_GAP_MS 内没有再次按下即判定，三击立即判定
+// - 长按分级：按住达到 HOLD_LEVELS_MS 的每一级时立即产生事件，不等待松开
+// - 引脚使用电平中断，中断中改为等待相反的电平（松开时等低电平、按下时等高电平），每个边沿触发一次；
+//   同一设置也是浅睡眠的 GPIO 唤醒条件（C3 只能由电平唤醒），按下和松开在浅睡眠中都能唤醒。
+//   唤醒电平只由这里设置，PowerManager 只打开 GPIO 唤醒源
+// 识别出的手势交给 begin() 注册的接收函数（在 esp_timer 任务中调用，不能阻塞）
+class ButtonEngine {
+public:
+    enum class Gesture : uint8_t {
+        SHORT_PRESS,
+        DOUBLE_CLICK,
+        TRIPLE_CLICK,
+        LONG_PRESS,       // 按住 HOLD_LEVELS_MS[0]
+        VERY_LONG_PRESS,  // 按住 HOLD_LEVELS_MS[1]
+        COUNT
+    };
+
+    struct Event {
+        Gesture gesture;
+        uint32_t originUs;  // 手势可以判定的时刻（esp_timer 时间低 32 位，与 micros() 同源），用于测量到状态机的延迟
+    };
+
+    typedef void (*Sink)(const Event &event, void *context);
+
+    struct Stats {
+        uint32_t edges;          // 中断记录的原始边沿（含抖动）
+        uint32_t transitions;    // 消抖后的按下/松开
+        uint32_t glitches;       // 抖动结束后电平未变化的边沿组
+        uint32_t gestures[(int)Gesture::COUNT];
+    };
+
+    static const uint32_t DEBOUNCE_US = 10000;          // 最后一个边沿之后保持不变的时间
+    static const uint32_t SHORT_PRESS_MAX_MS = 1000;    // 超过该时长松开不算单击
+    static const uint32_t MULTI_CLICK_GAP_MS = 250;     // 等待下一次单击的时间
+    static const uint8_t MAX_CLICKS = 3;
+    static const uint8_t HOLD_LEVEL_COUNT = 2;
+    static const uint32_t HOLD_LEVELS_MS[HOLD_LEVEL_COUNT];
+
+    // 配置引脚（低电平有效、内部上拉）并安装中断；可重复调用，重新调用时更换接收函数、清空手势状态，
+    // 并按当前电平重新设置等待的电平
+    static void begin(uint8_t pin, Sink sink, void *context);
+
+    static bool pressed();
+    static Stats stats();
+    static void resetStats();
+
+    static const char *name(Gesture gesture);
+
+private:
+    static void onEdge();
+    static void onDebounceTimer(void *);
+    static void onGestureTimer(void *);
+
+    static void onPress(uint32_t edgeUs);
+    static void onRelease(uint32_t edgeUs);
+    static void emit(Gesture gesture, uint32_t originUs);
+    static void armGestureTimer(uint32_t deadlineUs);
+
+    static uint8_t buttonPin;
+    static Sink eventSink;
+    static void *sinkContext;
+    static esp_timer_handle_t debounceTimer;
+    static esp_timer_handle_t gestureTimer;
+
+    // 中断与 esp_timer 任务共享
+    static std::atomic<uint32_t> edgeCount;
+    static std::atomic<uint32_t> settledCount;
+    static std::atomic<uint32_t> lastEdgeUs;
+    static std::atomic<uint32_t> burstStartUs;
+
+    // 以下仅在 esp_timer 任务中访问
+    static bool stablePressed;
+    static uint32_t pressUs;
+    static uint32_t releaseUs;
+    static uint8_t clicks;
+    static uint8_t holdLevel;
+    static Stats counters;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+class NimBLEConnInfo;
+
+// 连接参数配置：连接建立后按状态向中心设备请求连接间隔、从机延迟和监督超时
+// - LATENCY：鼠标移动启用时使用 7.5~15ms 间隔，不跳过连接事件
+// - ECONOMY：鼠标移动禁用时使用长间隔并允许从机延迟，降低射频占空比
+// 协商结果由 NimBLE 回调写回，可通过 diagnostics() 读取
+class ConnParams {
+public:
+    enum class Profile : uint8_t {
+        CENTRAL_DEFAULT,  // 不主动请求，使用中心设备选择的参数
+        LATENCY,
+        ECONOMY,
+        COUNT
+    };
+
+    // 连接间隔单位 1.25ms，监督超时单位 10ms（与 BLE 规范一致）
+    struct Settings {
+        uint16_t minInterval;
+        uint16_t maxInterval;
+        uint16_t latency;
+        uint16_t timeout;
+    };
+
+    struct Diagnostics {
+        Profile profile;        // 最近一次请求的配置
+        uint16_t interval;      // 当前协商的连接间隔
+        uint16_t latency;       // 当前从机延迟
+        uint16_t timeout;       // 当前监督超时
+        uint32_t requests;      // 发出的更新请求数
+        uint32_t updates;       // 收到的参数更新数
+        uint32_t failures;      // 请求失败数
+    };
+
+    // 请求切换到指定配置；未连接时只记录，连接建立后再应用
+    static void request(Profile profile);
+
+    // 连接建立/断开时调用
+    static void onConnected(const NimBLEConnInfo &connInfo);
+    static void onDisconnected();
+
+    // NimBLE 参数更新回调中调用
+    static void onParamsUpdated(const NimBLEConnInfo &connInfo);
+
+    static void setSettings(Profile profile, const Settings &settings);
+    static const Settings &settings(Profile profile);
+    static const Diagnostics &diagnostics();
+
+    // 当前连接间隔（微秒），未连接时为 0，可在任意任务中读取
+    static uint32_t intervalUs() { return currentIntervalUs.load(std::memory_order_relaxed); }
+
+private:
+    static void apply();
+    static void record(const NimBLEConnInfo &connInfo);
+
+    static Settings profileSettings[(int)Profile::COUNT];
+    static Diagnostics diag;
+    static bool connected;
+    static uint16_t connHandle;
+    static std::atomic<uint32_t> currentIntervalUs;
+};
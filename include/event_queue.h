@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 状态机事件队列：TinyFSM 不可重入也不是线程安全的，所有生产者（NimBLE 回调、按键引擎、
+// 状态处理函数自身）只向有界无锁队列投递事件，由后台任务作为唯一消费者依次分发
+// - post() 可在任意任务中调用，不加锁、不分配内存，队列满时丢弃并计数
+// - 状态处理函数中投递的事件在当前处理函数返回后分发，不会嵌套进入状态机
+class EventQueue {
+public:
+    enum class EventId : uint8_t {
+        BOOT_SHORT_PRESS,
+        BOOT_DOUBLE_CLICK,
+        BOOT_TRIPLE_CLICK,
+        BOOT_LONG_PRESS,
+        BOOT_VERY_LONG_PRESS,
+        DEVICE_CONNECTED,
+        DEVICE_DISCONNECTED,
+        CONNECTION_TIMEOUT,
+        PAIRING_TIMEOUT,
+        CONNECTION_FAILED,
+        INIT_COMPLETE,
+        RESTORE_MOUSE_MOTION_STATE,
+        ADVERTISING_STAGE_TIMEOUT,
+        ADVERTISING_RETRY,
+        COUNT
+    };
+
+    struct Entry {
+        EventId id;
+        uint32_t originUs;   // 事件发生的时刻（micros()），用于统计到分发的延迟
+    };
+
+    struct EventStats {
+        uint32_t dispatched;
+        uint32_t maxLatencyUs;
+    };
+
+    struct Stats {
+        uint32_t posted;
+        uint32_t dropped;         // 队列满而丢弃
+        uint32_t dispatched;
+        uint32_t maxDepth;        // 分发前观察到的最大队列深度
+        uint32_t maxLatencyUs;    // originUs 到分发完成的最大延迟
+        uint64_t totalLatencyUs;
+        EventStats events[(int)EventId::COUNT];
+    };
+
+    static const size_t QUEUE_SIZE = 32;  // 2 的幂
+
+    // 投递事件，originUs 缺省为当前时刻
+    static bool post(EventId id);
+    static bool post(EventId id, uint32_t originUs);
+
+    // 有事件投递时通知该任务（ulTaskNotifyTake() 等待）；nullptr 表示不通知
+    static void setConsumer(TaskHandle_t task);
+
+    // 分发队列中的全部事件（含分发期间新投递的），返回分发的个数；只能由唯一消费者调用
+    static uint32_t dispatchAll();
+
+    // 正在分发的事件的 originUs，供状态处理函数测量从事件发生开始的延迟；不在分发中时返回当前时刻
+    static uint32_t dispatchingOriginUs();
+
+    // 丢弃未分发的事件，只能在没有生产者并发时调用（上电初始化）
+    static void clear();
+
+    static Stats stats();
+    static void resetStats();
+
+    static const char *name(EventId id);
+
+private:
+    static void dispatch(const Entry &entry);
+};
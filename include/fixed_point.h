@@ -0,0 +1,269 @@
+#pragma once
+
+// 定点数学工具：ESP32-C3 的 RISC-V 内核没有 FPU，运动计算的热路径只使用整数运算
+//
+// - Q16：int32_t，16 位小数，用于速度、幅度等
+// - Q15：int16_t，范围 [-1, 1)，用于正弦/余弦和比例系数
+// - 角度：uint32_t 二进制角度，2^32 表示一整圈，溢出即自然回绕；查表只用高 16 位
+//
+// 正弦表在编译期由 constexpr 泰勒级数生成（C++11），存放在只读数据段
+
+#include <stdint.h>
+
+namespace fixed {
+
+const int32_t Q16_ONE = 1 << 16;
+const int16_t Q15_MAX = 32767;
+
+// 1 弧度对应的二进制角度
+const int32_t ANGLE_PER_RADIAN = 683565276; // 2^32 / 2π
+
+constexpr int32_t toQ16(double value)
+{
+    return (int32_t)(value * Q16_ONE + (value >= 0 ? 0.5 : -0.5));
+}
+
+constexpr int16_t toQ15(double value)
+{
+    return (int16_t)(value * Q15_MAX + (value >= 0 ? 0.5 : -0.5));
+}
+
+constexpr uint32_t radiansToAngle(double radians)
+{
+    return (uint32_t)(int64_t)(radians * 4294967296.0 / 6.283185307179586 + 0.5);
+}
+
+inline float q16ToFloat(int32_t value)
+{
+    return value / 65536.0f;
+}
+
+// Q16 × Q15 -> Q16
+inline int32_t mulQ15(int32_t a, int16_t b)
+{
+    return (int32_t)(((int64_t)a * b) >> 15);
+}
+
+// 向零截断为整数，与 (int8_t)float 的转换行为一致
+inline int32_t truncQ16(int32_t value)
+{
+    return value >= 0 ? (value >> 16) : -((-value) >> 16);
+}
+
+// 整数平方根（逐位法）
+inline uint32_t isqrt64(uint64_t value)
+{
+    uint64_t result = 0;
+    uint64_t bit = 1ull << 62;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+inline uint32_t isqrt32(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+// 6t⁵ − 15t⁴ + 10t³：端点处一阶、二阶导数为零的 S 形曲线（最小加加速度轨迹、梯度噪声的插值权重）
+// t ∈ [0, 1] 为 Q16，结果为 Q16，t = 1 时正好为 1
+inline int32_t smootherStepQ16(int32_t t)
+{
+    int64_t t2 = ((int64_t)t * t) >> 16;
+    int64_t t3 = (t2 * t) >> 16;
+    return (int32_t)((t3 * (10 * Q16_ONE - 15 * (int64_t)t + 6 * t2)) >> 16);
+}
+
+namespace detail {
+
+constexpr double PI = 3.14159265358979323846;
+
+// 泰勒级数求和，x ∈ [-π, π] 时 13 项足够 Q15 精度
+constexpr double sinSeries(double x2, double term, int k)
+{
+    return k > 12 ? term : term + sinSeries(x2, -term * x2 / ((2 * k + 2) * (2 * k + 3)), k + 1);
+}
+
+constexpr double sinReduced(double x)
+{
+    return sinSeries(x * x, x, 0);
+}
+
+// exp(z) 的泰勒级数，z ∈ [-1, 0] 时 16 项足够 Q15 精度
+constexpr double expSeries(double z, double term, int k)
+{
+    return k > 16 ? term : term + expSeries(z, term * z / (k + 1), k + 1);
+}
+
+// 2^(-i/size)
+constexpr int16_t exp2Entry(int i, int size)
+{
+    return toQ15(expSeries(-0.6931471805599453 * i / size, 1.0, 0));
+}
+
+// 第 i 个表项对应的角度先归约到 [-π, π]
+constexpr int16_t sineEntry(int i, int size)
+{
+    return toQ15(sinReduced((i < size / 2 ? i : i - size) * 2.0 * PI / size));
+}
+
+template <int... I>
+struct IndexList {};
+
+template <int N, int... I>
+struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+
+template <int... I>
+struct MakeIndexList<0, I...> {
+    typedef IndexList<I...> type;
+};
+
+} // namespace detail
+
+const int SINE_TABLE_BITS = 8;
+const int SINE_TABLE_SIZE = 1 << SINE_TABLE_BITS;
+
+// 多一个表项作为插值的哨兵
+struct SineTable {
+    int16_t values[SINE_TABLE_SIZE + 1];
+};
+
+template <int... I>
+constexpr SineTable makeSineTable(detail::IndexList<I...>)
+{
+    return SineTable{{detail::sineEntry(I, SINE_TABLE_SIZE)..., 0}};
+}
+
+// 以类模板静态成员的形式定义，保证各编译单元共享同一份表
+template <typename Unused = void>
+struct SineTableHolder {
+    static constexpr SineTable table = makeSineTable(detail::MakeIndexList<SINE_TABLE_SIZE>::type());
+};
+
+template <typename Unused>
+constexpr SineTable SineTableHolder<Unused>::table;
+
+static_assert(SineTableHolder<>::table.values[SINE_TABLE_SIZE / 4] == Q15_MAX, "sin(π/2) 应为 1");
+static_assert(SineTableHolder<>::table.values[SINE_TABLE_SIZE / 2] == 0, "sin(π) 应为 0");
+
+// 查表并在相邻表项间线性插值，angle 为 16 位二进制角度
+inline int16_t sinQ15(uint16_t angle)
+{
+    const int shift = 16 - SINE_TABLE_BITS;
+    int index = angle >> shift;
+    int32_t frac = angle & ((1 << shift) - 1);
+    int32_t a = SineTableHolder<>::table.values[index];
+    int32_t b = SineTableHolder<>::table.values[index + 1];
+    return (int16_t)(a + (((b - a) * frac) >> shift));
+}
+
+inline int16_t cosQ15(uint16_t angle)
+{
+    return sinQ15((uint16_t)(angle + 16384));
+}
+
+const int EXP2_TABLE_BITS = 5;
+const int EXP2_TABLE_SIZE = 1 << EXP2_TABLE_BITS;
+
+// 2^(-f)，f ∈ [0, 1]，共 EXP2_TABLE_SIZE + 1 项
+struct Exp2Table {
+    int16_t values[EXP2_TABLE_SIZE + 1];
+};
+
+template <int... I>
+constexpr Exp2Table makeExp2Table(detail::IndexList<I...>)
+{
+    return Exp2Table{{detail::exp2Entry(I, EXP2_TABLE_SIZE)..., (int16_t)(Q15_MAX / 2 + 1)}};
+}
+
+template <typename Unused = void>
+struct Exp2TableHolder {
+    static constexpr Exp2Table table = makeExp2Table(detail::MakeIndexList<EXP2_TABLE_SIZE>::type());
+};
+
+template <typename Unused>
+constexpr Exp2Table Exp2TableHolder<Unused>::table;
+
+// e^(-x)，x 为非负 Q16，结果为 Q15：换算为 2^(-x·log2e)，整数部分移位，小数部分查表插值
+inline int16_t expNegQ15(int32_t x)
+{
+    const int32_t LOG2E_Q16 = 94548; // log2(e) × 65536
+    if (x <= 0)
+    {
+        return Q15_MAX;
+    }
+    int64_t y = ((int64_t)x * LOG2E_Q16) >> 16;
+    if (y >= (15 << 16))
+    {
+        return 0;
+    }
+    int shift = (int)(y >> 16);
+    int32_t frac = (int32_t)(y & 0xFFFF);
+    const int subBits = 16 - EXP2_TABLE_BITS;
+    int index = frac >> subBits;
+    int32_t sub = frac & ((1 << subBits) - 1);
+    int32_t a = Exp2TableHolder<>::table.values[index];
+    int32_t b = Exp2TableHolder<>::table.values[index + 1];
+    return (int16_t)((a + (((b - a) * sub) >> subBits)) >> shift);
+}
+
+inline int16_t sinAngle(uint32_t angle)
+{
+    return sinQ15((uint16_t)(angle >> 16));
+}
+
+inline int16_t cosAngle(uint32_t angle)
+{
+    return cosQ15((uint16_t)(angle >> 16));
+}
+
+// 时间步长用 Q24 秒表示：Q16 秒的分辨率约 15µs，10ms 步长会带来 0.05% 的速率误差并逐渐累积成相位漂移
+const int DT_SHIFT = 24;
+
+// 角速度：每秒的二进制角度（64 位以容纳每秒超过一整圈的速率，可为负）
+constexpr int64_t angleRate(double radiansPerSecond)
+{
+    return (int64_t)(radiansPerSecond * ANGLE_PER_RADIAN + (radiansPerSecond < 0 ? -0.5 : 0.5));
+}
+
+// 按角速度推进 dtQ24 秒的角度
+inline uint32_t angleDelta(int64_t rate, int32_t dtQ24)
+{
+    return (uint32_t)((rate * dtQ24) >> DT_SHIFT);
+}
+
+} // namespace fixed
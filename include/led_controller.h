@@ -1,11 +1,15 @@
 #pragma once
 
 #include <Arduino.h>
+#include <esp_timer.h>
 
 // LED 引脚定义
 #define LED_D4_PIN 12  // 高电平有效
 #define LED_D5_PIN 13  // 高电平有效
 
+// LED 图案引擎：每种模式是一张步骤表（两颗 LED 的亮度、持续时间、是否渐变），
+// 由 LEDC 外设输出 PWM 并完成渐变，esp_timer 按绝对时间切换步骤，
+// 不需要在任何循环中调用，任务阻塞时节奏也不受影响
 class LEDController {
 public:
     // LED模式枚举
@@ -15,37 +19,58 @@ public:
         SLOW_BLINK,     // 慢速同步闪烁 (1Hz)
         FAST_BLINK,     // 快速同步闪烁 (3Hz)
         ALTERNATE,      // 交替闪烁 (2Hz)
-        HEARTBEAT       // 心跳模式
+        HEARTBEAT,      // 心跳模式：两次渐亮渐灭后停顿
+        CUSTOM,         // setState()/blinkSync()/blinkAlternate() 设置的自定义步骤
+        COUNT
+    };
+
+    // 图案的一个步骤：在 durationMs 内保持（或渐变到）给定亮度
+    struct Step {
+        uint8_t d4;           // 亮度 0~255
+        uint8_t d5;
+        uint16_t durationMs;  // 单步图案忽略
+        bool fade;            // true: 在 durationMs 内从上一步亮度渐变到本步亮度
+    };
+
+    struct Pattern {
+        const Step *steps;
+        uint8_t count;        // 为 1 时是静态图案，不启动定时器
     };
 
 private:
     static bool initialized;
-    static unsigned long lastBlinkTime;
-    static bool ledState;
     static Mode currentMode;
-    static unsigned long blinkInterval;
-    static bool d4State;
-    static bool d5State;
+    static Pattern currentPattern;
+    static uint8_t stepIndex;
+    static int64_t stepDeadlineUs;
+    static esp_timer_handle_t stepTimer;
+    static Step customSteps[2];
+    static Pattern customPattern;
+
+    static void stop();
+    static void play(Mode mode, const Pattern &pattern);
+    static void applyStep(const Step &step);
+    static void onStepTimer(void *);
 
 public:
-    // 初始化LED引脚
+    // 初始化 LEDC 通道、渐变功能和步骤定时器
     static void init();
-    
-    // 设置LED状态
+
+    // 停止图案并直接设置两颗 LED 的亮灭
     static void setState(bool d4, bool d5);
-    
-    // 设置LED模式
+
+    // 设置LED模式，从图案的第一步开始播放；CUSTOM 重新播放最近一次的自定义步骤
     static void setMode(Mode mode);
-    
+
     // 获取当前LED模式
     static Mode getMode();
-    
-    // 更新LED状态（需要在loop中调用）
-    static void update();
-    
+
+    // 模式对应的步骤表；CUSTOM 为最近一次的自定义步骤
+    static const Pattern &pattern(Mode mode);
+
     // 简单的LED控制函数
     static void turnOff();
     static void turnOn();
     static void blinkSync(int intervalMs = 1000);  // 同步闪烁
     static void blinkAlternate(int intervalMs = 500);  // 交替闪烁
-};
\ No newline at end of file
+};
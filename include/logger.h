@@ -0,0 +1,118 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+// 日志级别：编译期通过 LOG_LEVEL 选择，高于该级别的 LOG_xxx 调用展开为空语句，
+// 格式字符串和参数都不会进入固件
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// 延迟格式化的二进制日志：
+// - 调用方只把时间戳、格式字符串指针和最多 LOG_MAX_ARGS 个参数写入定长记录，不分配内存、不等待串口
+// - 记录放入无锁环形队列，队列满时丢弃并计数；可在任务、NimBLE 回调和中断中调用
+// - 低优先级的日志任务取出记录，按 printf 格式化后写入串口
+// 格式字符串和 %s 参数必须是字符串字面量或其他静态存储的字符串：格式化发生在记录之后
+class Logger {
+public:
+    enum class Level : uint8_t {
+        ERROR = LOG_LEVEL_ERROR,
+        WARN = LOG_LEVEL_WARN,
+        INFO = LOG_LEVEL_INFO,
+        DEBUG = LOG_LEVEL_DEBUG
+    };
+
+    static const int MAX_ARGS = 4;
+    static const size_t RING_SIZE = 64;        // 记录条数，2 的幂
+    static const uint32_t DRAIN_PERIOD_MS = 20;
+    static const uint32_t TASK_PRIORITY = 1;   // 低于所有业务任务
+
+    // 参数一律按机器字保存，float/double 以 float 位模式保存
+    typedef uintptr_t Arg;
+
+    struct Record {
+        uint32_t timestampMs;
+        const char *format;
+        Arg args[MAX_ARGS];
+        Level level;
+        uint8_t argCount;
+    };
+
+    struct Stats {
+        uint32_t written;    // 成功写入队列的记录
+        uint32_t dropped;    // 队列满而丢弃的记录
+        uint32_t drained;    // 已输出到串口的记录
+        uint32_t maxDepth;   // 日志任务观察到的最大队列深度
+    };
+
+    // 创建日志任务（在此之前写入的记录会保留在队列中）
+    static void start();
+
+    // 取出队列中的全部记录并输出，返回输出的条数；只能由单一消费者调用
+    static uint32_t drain();
+
+    // 格式化一条记录到 buffer，返回写入的长度（不含结尾的 '\0'）
+    static size_t format(const Record &record, char *buffer, size_t size);
+
+    static Stats stats();
+    static void resetStats();
+
+    // 写入一条记录，由 LOG_xxx 宏调用
+    template <typename... Args>
+    static void write(Level level, const char *format, Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "日志参数过多");
+        Arg packed[sizeof...(Args) + 1] = {toArg(args)...};
+        push(level, format, packed, sizeof...(Args));
+    }
+
+private:
+    static void push(Level level, const char *format, const Arg *args, uint8_t count);
+    static void drainTask(void *);
+
+    static Arg toArg(int value) { return (Arg)(intptr_t)value; }
+    static Arg toArg(long value) { return (Arg)(intptr_t)value; }
+    static Arg toArg(unsigned int value) { return (Arg)value; }
+    static Arg toArg(unsigned long value) { return (Arg)value; }
+    static Arg toArg(const char *value) { return (Arg)value; }
+    static Arg toArg(double value)
+    {
+        float f = (float)value;
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return (Arg)bits;
+    }
+};
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::write(Logger::Level::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::write(Logger::Level::WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::write(Logger::Level::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::write(Logger::Level::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdint.h>
+#include "motion_patterns.h"
+#include "motion_planner.h"
+#include "prng.h"
+#include "tremor.h"
+
+// 随机时间范围常量
+const unsigned int MIN_MOVE_DURATION = 1000;   // 最小移动时间 1秒
+const unsigned int MAX_MOVE_DURATION = 4000;   // 最大移动时间 4秒
+const unsigned int MIN_PAUSE_DURATION = 500;   // 最小停顿时间 0.5秒
+const unsigned int MAX_PAUSE_DURATION = 3000;  // 最大停顿时间 3秒
+
+// 自然鼠标移动生成器：按 motion_patterns.h 中的模式策略生成轨迹，带平滑、限速和移动/停顿周期
+// 每段移动的来源在停顿开始时按权重抽取：Config::plannerWeight 与各模式的权重一起参与抽取。
+// 选中 MotionPlanner 时停顿期间规划下一段移动的全部位移，移动阶段每次 step() 只从缓冲区弹出到期的条目；
+// 选中模式策略时每步计算目标速度并平滑（以下说明针对这种方式）
+// 所有运行状态（包括随机数发生器）都保存在实例内，可按任意频率调用 step()，也可同时运行多个实例；
+// 相同的种子和调用时刻得到相同的输出
+// 速度、平滑和衰减都按实际经过的时间积分，轨迹与 step() 的调用频率无关；
+// 不足一个计数的位移留在余数中累积到下一次，低速移动不会被截断丢失
+// step() 只使用定点整数运算（见 fixed_point.h），Config 中的浮点参数在设置时转换
+class MotionEngine {
+public:
+    // 移动模式
+    typedef MotionPattern Pattern;
+
+    // 一段移动的来源：模式策略逐步计算，或 MotionPlanner 预先规划
+    enum class Source : uint8_t {
+        PATTERN,
+        PLANNER
+    };
+
+    // step() 附带的事件标志，供调用方输出日志
+    enum Event : uint8_t {
+        EVENT_NONE = 0,
+        EVENT_PAUSE_STARTED = 1 << 0,    // 进入停顿阶段
+        EVENT_MOVE_STARTED = 1 << 1,     // 进入移动阶段
+        EVENT_PATTERN_CHANGED = 1 << 2   // 移动模式或幅度改变
+    };
+
+    // 一次计算的输出：HID 报告中的相对位移
+    struct Report {
+        int8_t dx;
+        int8_t dy;
+        uint8_t events;
+
+        bool moving() const { return dx != 0 || dy != 0; }
+    };
+
+    // 调节参数
+    struct Config {
+        // 以下速率均按秒计；默认值等效于原先 10ms 节拍下的每步参数
+        float maxSpeed = 2000.0f;                // 最大速度（计数/秒，原 20/步）
+        float smoothRate = 10.536f;              // 速度趋近目标的速率（1/秒，原每步 0.1 的平滑系数）
+        float pauseDecayRate = 10.536f;          // 停顿阶段的减速速率（1/秒，原每步 ×0.9）
+        uint16_t patternChangeIntervalMs = 3000; // 每3秒改变移动模式
+        uint16_t minMoveMs = MIN_MOVE_DURATION;
+        uint16_t maxMoveMs = MAX_MOVE_DURATION;
+        uint16_t minPauseMs = MIN_PAUSE_DURATION;
+        uint16_t maxPauseMs = MAX_PAUSE_DURATION;
+        uint8_t plannerWeight = 5;               // 规划整段移动的调度权重（默认模式的总权重为 10），0 为只用模式策略
+        Tremor::Config tremor;                   // 移动阶段叠加的手部抖动
+    };
+
+    // 两次 step 之间按此上限积分，避免任务长时间停顿后一次跳出很远
+    static const uint32_t MAX_STEP_US = 100000;
+
+    // 运行状态（速度和幅度为 Q16 定点数，单位计数/秒；角度为 32 位二进制角度）
+    // 来源为 PLANNER 时 radius 为当前段的峰值速度，pattern 为上一次使用的模式
+    struct State {
+        int32_t velocityX;
+        int32_t velocityY;
+        int32_t targetVelocityX;
+        int32_t targetVelocityY;
+        int32_t radius;
+        int32_t residualX;       // 尚未输出的亚计数位移（Q16 计数）
+        int32_t residualY;
+        uint32_t angle;
+        uint32_t lastStepUs;
+        uint32_t patternChangeUs;
+        uint32_t phaseStartUs;   // 当前移动/停顿阶段的开始时间
+        uint16_t moveDurationMs;
+        uint16_t pauseDurationMs;
+        Pattern pattern;
+        Source source;           // 当前移动段的来源
+        bool inMovePhase;        // true=移动阶段, false=停顿阶段
+    };
+
+    MotionEngine();
+    explicit MotionEngine(const Config &config);
+
+    // 重新开始：从 ActivePatterns 中第一个模式（默认为随机漫步）的移动阶段开始
+    void reset(uint32_t nowUs);
+
+    // 推进到 nowUs 并返回本次应发送的位移
+    Report step(uint32_t nowUs);
+
+    const State &state() const { return s; }
+    const Config &config() const { return cfg; }
+    void setConfig(const Config &config);
+
+    // 重新设置随机数种子，之后的 reset() 和 step() 由它决定
+    void seed(uint32_t value)
+    {
+        rng.seed(value);
+        tremor.seed(value);
+    }
+
+    // 调用方的 step() 周期：规划器按它生成条目，下一段开始生效
+    void setStepInterval(uint32_t periodUs) { stepIntervalUs = periodUs; }
+    const MotionPlanner &planner() const { return segments; }
+
+    // 参与调度的模式（调整各模式的 Params）；权重为 0 的模式不会被选中，全部为 0 时只用规划器，
+    // 模式不在 ActivePatterns 中时返回 false
+    ActivePatterns &patterns() { return registry; }
+    bool setPatternWeight(Pattern pattern, uint8_t weight) { return registry.setWeight(pattern, weight); }
+
+private:
+    void computeTargetVelocity(uint32_t nowMs, int32_t dtQ24);
+    void pickPattern();
+    Source pickSource();
+    void planSegment();
+
+    Config cfg;
+    State s;
+    MotionPlanner segments;
+    uint32_t stepIntervalUs;
+    Prng rng;
+    Tremor tremor;
+    ActivePatterns registry;
+    uint8_t patternIndex;    // 当前模式在 registry 中的下标
+    Source nextSource;       // 停顿开始时为下一段抽取的来源
+
+    // Config 的定点形式
+    int32_t maxSpeedQ4;
+    int32_t smoothRateQ16;
+    int32_t pauseDecayRateQ16;
+};
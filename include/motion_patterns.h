@@ -0,0 +1,336 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+#include "fixed_point.h"
+#include "prng.h"
+
+// 移动模式编号（日志和 MotionEngine::State::pattern 使用）
+enum class MotionPattern : uint8_t {
+    RANDOM_WALK = 0,   // 随机漫步
+    CIRCLE = 1,        // 圆形轨迹
+    FIGURE_EIGHT = 2,  // 8字形轨迹
+    SPIRAL = 3,        // 螺旋：绕圈的同时幅度由小到大再回到小
+    LISSAJOUS = 4,     // 李萨如曲线：两轴按不同的整数频率比振荡
+    LINE_SWEEP = 5     // 往返扫动：沿一条直线来回移动并缓慢横移
+};
+
+// 模式策略每步的输入输出
+struct PatternContext {
+    int32_t radius;      // 幅度（Q16 计数/秒）
+    uint32_t nowMs;
+    int32_t dtQ24;       // 本步时长（Q24 秒）
+    uint32_t &angle;     // 各模式共用的行进角度：切换模式时方向连续
+    Prng &rng;
+    int32_t targetX;     // 输出：目标速度（Q16 计数/秒）
+    int32_t targetY;
+};
+
+// 模式策略基类（CRTP）：派生类提供 ID、WEIGHT、Params 和 target()，可选提供 begin()
+// step() 在编译期绑定到派生类的 target()，没有虚函数，整段计算内联到分派处
+template <typename Derived>
+class PatternPolicy {
+public:
+    static const uint8_t WEIGHT = 1;   // 调度权重的默认值
+
+    // 被调度选中时调用一次：派生类可以在这里随机化本次的形状
+    void begin(Prng &) {}
+
+    void step(PatternContext &ctx) { static_cast<Derived *>(this)->target(ctx); }
+
+protected:
+    static void polar(PatternContext &ctx, int32_t speed, uint32_t angle)
+    {
+        ctx.targetX = fixed::mulQ15(speed, fixed::cosAngle(angle));
+        ctx.targetY = fixed::mulQ15(speed, fixed::sinAngle(angle));
+    }
+};
+
+// 随机漫步：每步随机转向，速度按 sin(t/1s) 在 0~radius 之间起伏
+class RandomWalkPattern : public PatternPolicy<RandomWalkPattern> {
+public:
+    static const MotionPattern ID = MotionPattern::RANDOM_WALK;
+    static const uint8_t WEIGHT = 3;
+
+    struct Params {
+        int32_t turnRateQ16 = fixed::toQ16(30.0);   // 转向角速度的上限（弧度/秒，原 ±0.3/步）
+    };
+    Params params;
+
+    void target(PatternContext &ctx)
+    {
+        using namespace fixed;
+        int64_t turnRate = ((int64_t)ctx.rng.range(-params.turnRateQ16, params.turnRateQ16) * ANGLE_PER_RADIAN) >> 16;
+        ctx.angle += angleDelta(turnRate, ctx.dtQ24);
+        // radius × (0.5 + 0.5·sin(t))，乘法溢出即角度按整圈回绕
+        int32_t speed = (ctx.radius >> 1) + mulQ15(ctx.radius >> 1, sinAngle(ctx.nowMs * TIME_ANGLE_PER_MS));
+        polar(ctx, speed, ctx.angle);
+    }
+
+private:
+    static const uint32_t TIME_ANGLE_PER_MS = fixed::radiansToAngle(0.001);
+};
+
+// 圆形：匀速转向
+class CirclePattern : public PatternPolicy<CirclePattern> {
+public:
+    static const MotionPattern ID = MotionPattern::CIRCLE;
+    static const uint8_t WEIGHT = 2;
+
+    struct Params {
+        int64_t angleRate = fixed::angleRate(5.0);   // 转向角速度（原 0.05/步）
+    };
+    Params params;
+
+    void target(PatternContext &ctx)
+    {
+        ctx.angle += fixed::angleDelta(params.angleRate, ctx.dtQ24);
+        polar(ctx, ctx.radius, ctx.angle);
+    }
+};
+
+// 8 字形：x 按 sin(a)、y 按 sin(2a)/2
+class FigureEightPattern : public PatternPolicy<FigureEightPattern> {
+public:
+    static const MotionPattern ID = MotionPattern::FIGURE_EIGHT;
+    static const uint8_t WEIGHT = 2;
+
+    struct Params {
+        int64_t angleRate = fixed::angleRate(3.0);   // 原 0.03/步
+    };
+    Params params;
+
+    void target(PatternContext &ctx)
+    {
+        using namespace fixed;
+        ctx.angle += angleDelta(params.angleRate, ctx.dtQ24);
+        ctx.targetX = mulQ15(ctx.radius, sinAngle(ctx.angle));
+        ctx.targetY = mulQ15(ctx.radius, sinAngle(ctx.angle * 2)) >> 1;
+    }
+};
+
+// 螺旋：匀速转向，速度在 minScale~1 倍幅度之间缓慢往返，轨迹为向外再向内的螺线；旋转方向每次随机
+class SpiralPattern : public PatternPolicy<SpiralPattern> {
+public:
+    static const MotionPattern ID = MotionPattern::SPIRAL;
+
+    struct Params {
+        int64_t angleRate = fixed::angleRate(4.0);
+        int64_t breatheRate = fixed::angleRate(1.0);   // 幅度往返的角速度：约 3 秒向外、3 秒向内
+        int16_t minScaleQ15 = fixed::toQ15(0.2);
+    };
+    Params params;
+
+    void begin(Prng &rng)
+    {
+        breathe = 0;
+        clockwise = rng.below(2) != 0;
+    }
+
+    void target(PatternContext &ctx)
+    {
+        using namespace fixed;
+        uint32_t delta = angleDelta(params.angleRate, ctx.dtQ24);
+        ctx.angle += clockwise ? 0 - delta : delta;
+        breathe += angleDelta(params.breatheRate, ctx.dtQ24);
+        // minScale + (1 − minScale) × (1 − cos φ) / 2
+        int32_t rise = (Q15_MAX - cosAngle(breathe)) >> 1;
+        int32_t scale = params.minScaleQ15 + (((Q15_MAX - params.minScaleQ15) * rise) >> 15);
+        polar(ctx, mulQ15(ctx.radius, (int16_t)scale), ctx.angle);
+    }
+
+private:
+    uint32_t breathe = 0;
+    bool clockwise = false;
+};
+
+// 李萨如曲线：两轴速度为 cos(aθ + δ)、cos(bθ)，频率比 a:b 和相位差每次随机
+class LissajousPattern : public PatternPolicy<LissajousPattern> {
+public:
+    static const MotionPattern ID = MotionPattern::LISSAJOUS;
+
+    struct Params {
+        int64_t angleRate = fixed::angleRate(2.0);   // θ 的角速度
+    };
+    Params params;
+
+    void begin(Prng &rng)
+    {
+        static const uint8_t RATIOS[][2] = {{1, 2}, {3, 2}, {3, 4}, {5, 4}};
+        const uint8_t *ratio = RATIOS[rng.below(sizeof(RATIOS) / sizeof(RATIOS[0]))];
+        ratioX = ratio[0];
+        ratioY = ratio[1];
+        offset = rng.next();
+        theta = 0;
+    }
+
+    void target(PatternContext &ctx)
+    {
+        using namespace fixed;
+        theta += angleDelta(params.angleRate, ctx.dtQ24);
+        ctx.targetX = mulQ15(ctx.radius, cosAngle(theta * ratioX + offset));
+        ctx.targetY = mulQ15(ctx.radius, cosAngle(theta * ratioY));
+    }
+
+private:
+    uint32_t theta = 0;
+    uint32_t offset = 0;
+    uint8_t ratioX = 1;
+    uint8_t ratioY = 2;
+};
+
+// 往返扫动：沿随机方向按 cos 来回移动，同时以 drift 倍幅度沿法向横移，轨迹为之字形
+class LineSweepPattern : public PatternPolicy<LineSweepPattern> {
+public:
+    static const MotionPattern ID = MotionPattern::LINE_SWEEP;
+
+    struct Params {
+        int64_t sweepRate = fixed::angleRate(2.5);   // 一次往返约 2.5 秒
+        int16_t driftQ15 = fixed::toQ15(0.15);
+    };
+    Params params;
+
+    void begin(Prng &rng)
+    {
+        direction = rng.next();
+        phase = 0;
+    }
+
+    void target(PatternContext &ctx)
+    {
+        using namespace fixed;
+        phase += angleDelta(params.sweepRate, ctx.dtQ24);
+        int32_t along = mulQ15(ctx.radius, cosAngle(phase));
+        int32_t across = mulQ15(ctx.radius, params.driftQ15);
+        int16_t c = cosAngle(direction);
+        int16_t s = sinAngle(direction);
+        ctx.targetX = mulQ15(along, c) - mulQ15(across, s);
+        ctx.targetY = mulQ15(along, s) + mulQ15(across, c);
+    }
+
+private:
+    uint32_t direction = 0;
+    uint32_t phase = 0;
+};
+
+// 编译期模式注册表：模板参数列出参与构建的模式，每个模式一个实例（各自的参数和状态）
+// - step()/begin() 按下标递归展开为比较链，每个分支直接内联对应模式的 target()
+// - pick() 为加权调度：按各模式的权重抽取下标，权重初值为模式的 WEIGHT，可用 setWeight() 调整（0 为不选）
+// - get<P>() 在编译期按类型取出模式实例，用于调整其 Params
+template <typename... Patterns>
+class PatternRegistry;
+
+template <>
+class PatternRegistry<> {
+public:
+    static const size_t COUNT = 0;
+
+    MotionPattern id(size_t) const { return MotionPattern::RANDOM_WALK; }
+    int indexOf(MotionPattern) const { return -1; }
+    void begin(size_t, Prng &) {}
+    void step(size_t, PatternContext &) {}
+    uint8_t weight(size_t) const { return 0; }
+    bool setWeight(MotionPattern, uint8_t) { return false; }
+    uint32_t totalWeight() const { return 0; }
+    size_t select(uint32_t) const { return 0; }
+};
+
+template <typename Head, typename... Tail>
+class PatternRegistry<Head, Tail...> {
+public:
+    static const size_t COUNT = 1 + sizeof...(Tail);
+
+    MotionPattern id(size_t index) const
+    {
+        if (index == 0)
+        {
+            return Head::ID;
+        }
+        return rest.id(index - 1);
+    }
+
+    int indexOf(MotionPattern pattern) const
+    {
+        if (pattern == Head::ID)
+        {
+            return 0;
+        }
+        int index = rest.indexOf(pattern);
+        return index < 0 ? -1 : index + 1;
+    }
+
+    void begin(size_t index, Prng &rng)
+    {
+        if (index == 0)
+        {
+            head.begin(rng);
+        }
+        else
+        {
+            rest.begin(index - 1, rng);
+        }
+    }
+
+    void step(size_t index, PatternContext &ctx)
+    {
+        if (index == 0)
+        {
+            head.step(ctx);
+        }
+        else
+        {
+            rest.step(index - 1, ctx);
+        }
+    }
+
+    uint8_t weight(size_t index) const { return index == 0 ? headWeight : rest.weight(index - 1); }
+
+    // 模式不在注册表中时返回 false
+    bool setWeight(MotionPattern pattern, uint8_t value)
+    {
+        if (pattern == Head::ID)
+        {
+            headWeight = value;
+            return true;
+        }
+        return rest.setWeight(pattern, value);
+    }
+
+    uint32_t totalWeight() const { return headWeight + rest.totalWeight(); }
+
+    // 按权重随机选择下一个模式的下标；权重全为 0 时返回 0，不消耗随机数
+    size_t pick(Prng &rng) const
+    {
+        uint32_t total = totalWeight();
+        return total ? select(rng.below(total)) : 0;
+    }
+
+    // 累计权重落在 ticket 上的下标
+    size_t select(uint32_t ticket) const
+    {
+        return ticket < headWeight || COUNT == 1 ? 0 : 1 + rest.select(ticket - headWeight);
+    }
+
+    template <typename P>
+    P &get() { return get<P>(std::is_same<P, Head>()); }
+
+private:
+    template <typename P>
+    P &get(std::true_type) { return head; }
+    template <typename P>
+    P &get(std::false_type) { return rest.template get<P>(); }
+
+    Head head;
+    uint8_t headWeight = Head::WEIGHT;
+    PatternRegistry<Tail...> rest;
+};
+
+// 参与构建的模式：编译时定义 MOTION_PATTERNS 可以只保留其中一部分，例如
+// -D 'MOTION_PATTERNS=CirclePattern,SpiralPattern'；reset() 从列表中的第一个模式开始
+#ifndef MOTION_PATTERNS
+#define MOTION_PATTERNS RandomWalkPattern, CirclePattern, FigureEightPattern, SpiralPattern, LissajousPattern, \
+                        LineSweepPattern
+#endif
+
+typedef PatternRegistry<MOTION_PATTERNS> ActivePatterns;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "prng.h"
+
+// 移动段规划器：一次生成一整段移动，把每个报告周期的 int8 位移预先写入环形缓冲区，
+// 报告路径每次只弹出到期的条目，不再逐步计算三角函数和平滑
+// - 路径为从当前位置出发的三次 Bezier 曲线（两个控制点偏离连线，形成弧线或 S 形），
+//   沿路径按最小加加速度（minimum-jerk）时间曲线 s(τ) = 10τ³ − 15τ⁴ + 6τ⁵ 推进：起止速度和加速度都为零
+// - 每个条目由累计位置的取整差得到，取整误差不累积，整段结束时正好到达终点
+// - 峰值速度按 Bezier 导数的上界限制在 maxSpeed 以内；离起点超过 HOME_RADIUS 时终点朝起点方向选取
+// plan() 和 pop() 都只能在同一个任务中调用（MotionEngine 的调用方）
+class MotionPlanner {
+public:
+    struct Delta {
+        int8_t dx;
+        int8_t dy;
+    };
+
+    // 一段移动：控制点和终点相对段起点（计数）
+    struct Segment {
+        int32_t x1, y1;
+        int32_t x2, y2;
+        int32_t x3, y3;
+        uint32_t durationUs;
+        uint32_t periodUs;   // 条目间隔
+    };
+
+    struct Stats {
+        uint32_t segments;   // 规划的段数
+        uint32_t entries;    // 写入的条目
+        uint32_t scaled;     // 超过最大速度而缩小的段
+        uint32_t clipped;    // 超出 int8 而分摊到下一条目的条目
+    };
+
+    static const size_t CAPACITY = 1024;            // 条目数，2 的幂
+    static const uint32_t MIN_PERIOD_US = 2500;
+    static const int32_t HOME_RADIUS = 4000;        // 计数
+    static const int32_t MIN_PEAK_SPEED = 500;      // 计数/秒
+    static const int32_t MAX_PEAK_SPEED = 1500;
+
+    MotionPlanner();
+
+    // 清空缓冲区并以当前位置为起点
+    void reset();
+    // 丢弃尚未弹出的条目（移动阶段提前结束）
+    void clear();
+
+    // 用 rng 随机规划一段 durationMs 的移动并写入缓冲区，返回峰值速度（计数/秒）
+    // periodUs 为调用方的报告周期；段太长放不下时条目间隔相应加大
+    int32_t plan(Prng &rng, uint32_t durationMs, uint32_t periodUs, int32_t maxSpeed);
+    // 按给定的控制点生成条目，替换缓冲区中尚未弹出的条目
+    void generate(const Segment &segment);
+
+    // 推进 elapsedUs，弹出期间到期的条目并合为一份位移：调用周期等于条目间隔时正好一条
+    Delta pop(uint32_t elapsedUs);
+
+    size_t available() const { return count; }
+    const Segment &segment() const { return current; }
+    int32_t positionX() const { return posX; }
+    int32_t positionY() const { return posY; }
+    const Stats &stats() const { return counters; }
+
+private:
+    const Delta &push(int32_t dx, int32_t dy);
+
+    Delta ring[CAPACITY];
+    Segment current;
+    uint16_t head;
+    uint16_t count;
+    uint32_t entryUs;     // 当前段的条目间隔
+    uint32_t waitedUs;    // 已推进但不足一个条目间隔的时间
+    int32_t carryX;       // 多个条目合并后超出 int8 的部分，留到下一次
+    int32_t carryY;
+    int32_t posX;         // 已弹出位移的累计（相对 reset() 时的位置）
+    int32_t posY;
+    Stats counters;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// 有界无锁多生产者/单消费者环形队列（按槽位序号同步）：
+// - push() 可在任意任务或中断中调用，不加锁、不分配内存，队列满时立即返回 false
+// - pop() 只允许一个消费者调用
+// 每个槽位的序号指明它当前可写（== 写位置）还是可读（== 写位置 + 1），
+// 生产者用 CAS 抢占写位置，写完数据后再发布序号，消费者只读取已发布的槽位
+template <typename T, size_t N>
+class MpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing 容量必须是 2 的幂");
+
+public:
+    MpscRing() { clear(); }
+
+    // 只能在没有生产者和消费者并发访问时调用
+    void clear()
+    {
+        for (uint32_t i = 0; i < N; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        head.store(0, std::memory_order_relaxed);
+        tail = 0;
+    }
+
+    bool push(const T &value)
+    {
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &slots[pos & (N - 1)];
+            uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(sequence - pos);
+            if (diff == 0)
+            {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 消费者尚未取走一整圈之前的数据：队列已满
+            }
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        Slot &slot = slots[tail & (N - 1)];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if ((int32_t)(sequence - (tail + 1)) < 0)
+        {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(tail + N, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    // 近似的已用槽位数（含已抢占但尚未发布的槽位），仅用于统计
+    uint32_t size() const
+    {
+        return head.load(std::memory_order_relaxed) - tail;
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        T value;
+    };
+
+    Slot slots[N];
+    std::atomic<uint32_t> head;   // 下一个写位置（生产者共享）
+    uint32_t tail;                // 下一个读位置（仅消费者）
+};
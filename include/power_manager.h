@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// 电源管理：启用 ESP-IDF 的动态调频（160MHz/40MHz）和自动浅睡眠，由各模块声明自己需要的最低电源级别，
+// 按所有模块中最高的级别持有电源管理锁；没有模块需要时 CPU 在任务都阻塞的间隙降频或浅睡眠
+// - 浅睡眠需要 CONFIG_FREERTOS_USE_TICKLESS_IDLE，构建未启用时 begin() 退回只调频
+// - 浅睡眠期间由 GPIO 唤醒：这里只打开 GPIO 唤醒源，引脚的唤醒电平由 ButtonEngine 随按键状态设置（见 button_engine.h）；
+//   LED 的 LEDC 使用 RTC8M 时钟，图案和渐变不受影响
+// - 按状态机所处的阶段统计总时间、禁止浅睡眠和全速运行的时间、估算的射频工作时间和唤醒次数，
+//   estimate() 按电流模型换算为平均电流和 mAh
+// 除 noteWakeup() 外只能在状态机（后台任务）中调用
+class PowerManager {
+public:
+    // 统计阶段，与状态机的状态一一对应
+    enum class Phase : uint8_t {
+        INIT,
+        IDLE,
+        RECONNECT,
+        PAIRING,
+        CONNECTED,
+        MOTION_DISABLED,
+        MOTION_ENABLED,
+        COUNT
+    };
+
+    // 电源级别，从低到高
+    enum class Level : uint8_t {
+        SLEEP,        // 允许降频和浅睡眠
+        AWAKE,        // 禁止浅睡眠，允许降频
+        FULL_SPEED    // 禁止浅睡眠并保持最高频率
+    };
+
+    // 声明电源级别的模块
+    enum class Client : uint8_t {
+        MODE,         // setMode()
+        MOTION,       // 运动任务按报告周期运行时
+        COUNT
+    };
+
+    enum class Mode : uint8_t {
+        BALANCED,     // 默认：空闲时降频和浅睡眠
+        PERFORMANCE   // 始终全速、不睡眠；用于低负载时会自动断电的充电宝
+    };
+
+    struct PhaseStats {
+        uint32_t entries;
+        uint64_t totalUs;
+        uint64_t noSleepUs;     // 禁止浅睡眠的时间（AWAKE 或 FULL_SPEED）
+        uint64_t fullSpeedUs;   // 其中保持最高频率的时间
+        uint64_t radioUs;       // 按广播事件和连接事件估算的射频工作时间
+        uint32_t wakeups;       // 任务和定时器唤醒次数
+    };
+
+    // 电流模型，单位 mA；默认值为 ESP32-C3 的典型值，可按实测校准
+    struct Model {
+        float activeMa;        // CPU 160MHz 运行
+        float idleMaxMa;       // 160MHz 空闲（保持最高频率，不睡眠）
+        float idleMinMa;       // 40MHz 空闲（降频，不睡眠）
+        float lightSleepMa;    // 浅睡眠
+        float radioMa;         // 射频收发期间额外的电流
+        uint32_t wakeupUs;     // 每次唤醒以 160MHz 运行的时间（含唤醒延迟）
+        bool dfs;              // 是否启用了调频
+        bool lightSleep;       // 是否启用了浅睡眠
+    };
+
+    struct Estimate {
+        double averageMa;
+        double mAh;             // 统计时间内消耗的电荷
+        double sleepFraction;   // 浅睡眠的时间比例（未启用浅睡眠时为 0）
+    };
+
+    static const uint32_t MAX_FREQ_MHZ = 160;
+    static const uint32_t MIN_FREQ_MHZ = 40;
+    // 每个广播事件在 3 个广播信道上发送并监听扫描/连接请求，每个连接事件收发各一个包
+    static const uint32_t ADV_EVENT_RADIO_US = 1200;
+    static const uint32_t CONN_EVENT_RADIO_US = 400;
+
+    // 配置调频和浅睡眠、创建电源管理锁并打开 GPIO 唤醒源；可重复调用，重新开始统计
+    static void begin();
+    static bool dfsEnabled();
+    static bool lightSleepEnabled();
+
+    static void setMode(Mode mode);
+    static Mode mode();
+
+    // 模块声明需要的电源级别，立即按最高级别获取或释放锁
+    static void require(Client client, Level level);
+    static Level level();
+
+    // 状态机进入新状态
+    static void enterPhase(Phase phase);
+    // 把上次更新以来的时间记入当前阶段，并按当前的广播和连接重新估算射频占空比；后台任务每轮调用
+    static void update();
+    // 任务或定时器被唤醒，可在任意任务中调用
+    static void noteWakeup() { pendingWakeups.fetch_add(1, std::memory_order_relaxed); }
+
+    static PhaseStats stats(Phase phase);
+    static PhaseStats total();
+    static void resetStats();
+
+    static Model defaultModel();
+    static Estimate estimate(const PhaseStats &stats, const Model &model);
+
+    static const char *name(Phase phase);
+
+private:
+    static void applyLevel();
+    static uint32_t radioDutyPpm();
+
+    static std::atomic<uint32_t> pendingWakeups;
+};
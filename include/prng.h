@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+
+// 伪随机数发生器：xoshiro128**，32 位状态字，每次只有移位、异或和两次乘法，替代 Arduino 的 random()
+// - Arduino 的 random(min, max) 参数为 long：浮点范围会被截断，每次还要读硬件随机数寄存器并取模
+// - range() 用乘法代替取模，最多 2^-32 × 范围的偏差；uniform() 为浮点，不要在 step() 的热路径中使用
+// - 每个实例的序列只由种子决定：相同种子在主机和设备上得到相同的序列
+// - hardwareSeed() 在设备上取硬件随机数，主机替身返回随 hostsim::reset() 复位的固定序列；
+//   编译时定义 PRNG_FIXED_SEED 则始终返回该值，用于在设备上复现同一段移动
+class Prng {
+public:
+    static const uint32_t DEFAULT_SEED = 0x2545F491;
+
+    explicit Prng(uint32_t value = DEFAULT_SEED) { seed(value); }
+
+    // 用 splitmix32 把种子展开为 4 个状态字，任何种子（包括 0）都得到非全零的状态
+    void seed(uint32_t value)
+    {
+        for (uint32_t &word : state)
+        {
+            value += 0x9E3779B9u;
+            uint32_t z = value;
+            z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+            z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+            word = z ^ (z >> 16);
+        }
+    }
+
+    uint32_t next()
+    {
+        uint32_t result = rotl(state[1] * 5, 7) * 9;
+        uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+
+    // [0, bound)
+    uint32_t below(uint32_t bound) { return (uint32_t)(((uint64_t)next() * bound) >> 32); }
+
+    // [min, max)，与 Arduino 的 random(min, max) 含义相同；max <= min 时返回 min
+    int32_t range(int32_t min, int32_t max)
+    {
+        return max > min ? min + (int32_t)below((uint32_t)(max - min)) : min;
+    }
+
+    // [min, max) 的浮点均匀分布，24 位精度
+    float uniform(float min, float max) { return min + (next() >> 8) * (1.0f / 16777216.0f) * (max - min); }
+
+    static uint32_t hardwareSeed();
+
+private:
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    uint32_t state[4];
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 已绑定主机的快速重连：进入 Reconnect 时选择广播计划（见 AdvertisingSchedule）
+// - 有绑定时把绑定地址放进过滤接受列表，执行 RECONNECT_BONDED：先定向广播 1.28s，
+//   之后只接受绑定主机的非定向广播，间隔逐级放宽
+// - 没有绑定时执行 RECONNECT_OPEN，任何主机都可以连接
+// 新主机需要长按进入 Pairing，Pairing 使用公开广播；超长按用 forgetBonds() 清除绑定，之后的重连也使用公开广播
+// 每次重连记录从进入重连（断开事件）到连接事件的时间，按直方图统计；连接时所处的阶段由广播计划统计
+class ReconnectStrategy {
+public:
+    static const uint8_t HISTOGRAM_BUCKETS = 10;
+    // 各直方图桶的上界（毫秒），最后一个桶为 30s 及以上
+    static const uint32_t HISTOGRAM_LIMITS_MS[HISTOGRAM_BUCKETS - 1];
+
+    struct Stats {
+        uint32_t attempts;      // 进入重连
+        uint32_t reconnects;
+        uint32_t abandoned;     // 未连接就离开 Reconnect（进入配对）
+        uint32_t forgotten;     // forgetBonds() 清除了绑定
+        uint32_t maxMs;
+        uint64_t totalMs;
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+    };
+
+    // 进入 Reconnect：选择并启动广播计划；originUs 为断开（或初始化完成）事件的时刻
+    static void begin(uint32_t originUs);
+    // Reconnect 中收到连接事件，connectedUs 为连接事件的时刻
+    static void onConnected(uint32_t connectedUs);
+    // 离开 Reconnect
+    static void end();
+    // 清除全部绑定并把绑定地址移出过滤接受列表，之后的重连执行 RECONNECT_OPEN
+    static void forgetBonds();
+
+    // 直方图桶的序号
+    static uint8_t bucket(uint32_t ms);
+
+    static Stats stats();
+    static void resetStats();
+
+private:
+    static uint32_t startUs;
+    static bool connected;
+    static Stats counters;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// HID 报告整形：位于运动计算和 notify() 之间
+// - 同一连接间隔内到达的位移合并为一份报告；待发位移每轴最多保留一份报告（±127），
+//   超出部分丢弃并计入 stats().discarded，链路长时间发不出去时不会积压成停止后的长段拖尾
+// - 停止移动后只发送一次释放报告，之后仅按保活间隔补发，重复的全零报告直接丢弃
+// - 两次发送之间至少间隔一个连接间隔，不向协议栈堆积链路发不出去的报告
+// - 报告速率档位决定基本发送间隔；notify() 失败（协议栈缓冲耗尽）时位移退回待发，
+//   发送间隔逐级加倍退避，连续成功一段时间后再逐级恢复
+class ReportPipeline {
+public:
+    // 发送回调：report 为 4 字节鼠标报告，返回是否成功交给协议栈
+    typedef bool (*SendFunction)(const uint8_t *report, size_t length, void *context);
+
+    // 报告速率档位：在移动平滑度和空口占用之间取舍
+    enum class RateMode : uint8_t {
+        HZ_25,
+        HZ_50,
+        HZ_100,
+        HZ_133,
+        COUNT
+    };
+
+    struct Config {
+        uint32_t minIntervalUs = 7500;       // 两次发送的最小间隔，默认为 BLE 最短连接间隔
+        uint32_t idleReportIntervalUs = 100000; // 静止时释放报告的保活间隔（安卓兼容性）
+        RateMode rateMode = RateMode::HZ_100;   // 与原先 10ms 的发送节拍一致
+        uint8_t maxBackoffLevel = 3;            // 最多退避到 8 倍发送间隔
+        uint16_t rampUpSuccesses = 50;          // 连续成功发送多少份后恢复一级
+    };
+
+    struct Stats {
+        uint32_t submitted;   // 提交次数
+        uint32_t coalesced;   // 与其他位移合并发送的提交
+        uint32_t dropped;     // 没有产生报告的全零提交
+        uint32_t discarded;   // 待发位移超过一份报告而丢弃的计数（两轴绝对值之和）
+        uint32_t sent;        // 成功交给协议栈的报告
+        uint32_t failed;      // notify() 失败的报告
+        uint32_t backoffs;    // 退避升级次数
+        uint32_t rampUps;     // 退避恢复次数
+    };
+
+    ReportPipeline(SendFunction send, void *context);
+    ReportPipeline(SendFunction send, void *context, const Config &config);
+
+    // 清空待发位移和发送历史，统计保留
+    void reset();
+
+    // 提交一次位移，到达发送时刻时合并发送；返回本次是否发送了报告
+    bool submit(int8_t dx, int8_t dy, uint32_t nowUs);
+
+    // 按连接间隔更新最小发送间隔
+    void setMinInterval(uint32_t intervalUs) { cfg.minIntervalUs = intervalUs; }
+
+    // 切换速率档位，退避级别保持不变
+    void setRateMode(RateMode mode) { cfg.rateMode = mode; }
+    RateMode rateMode() const { return cfg.rateMode; }
+    static uint32_t rateIntervalUs(RateMode mode);
+
+    // 当前退避级别（0 为不退避）和实际生效的发送间隔
+    uint8_t backoffLevel() const { return backoff; }
+    uint32_t intervalUs() const;
+
+    const Config &config() const { return cfg; }
+    const Stats &stats() const { return counters; }
+    void resetStats();
+
+private:
+    bool send(int8_t dx, int8_t dy, uint32_t nowUs);
+    void onSendResult(bool delivered);
+
+    SendFunction sendFunction;
+    void *sendContext;
+    Config cfg;
+    Stats counters;
+
+    int32_t pendingX;
+    int32_t pendingY;
+    uint32_t lastSendUs;
+    bool hasSent;
+    bool releasePending;   // 移动报告之后还欠一份释放报告
+    uint8_t backoff;
+    uint16_t successStreak;  // 当前退避级别下连续成功的发送
+};
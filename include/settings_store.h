@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include "motion_engine.h"
+#include "report_pipeline.h"
+
+// 持久化设置：鼠标移动开关、报告速率档位和 MotionEngine 的调节参数，保存为 NVS 中的一条定长记录
+// - begin() 在 setup() 中调用一次：打开命名空间并读取记录，只有一次 nvs_get_blob()
+// - 修改只更新内存中的副本，由后台任务的 update() 在最后一次修改 COMMIT_DELAY_MS 后写入，
+//   连续修改最迟在第一次修改 MAX_COMMIT_DELAY_MS 后写入；与已保存的记录相同时不写入，
+//   反复开关移动只产生一次写入，写入前断电会丢失这段时间内的修改
+// - 记录带版本号，版本或长度不符、参数越界时丢弃并使用编译期默认值
+// - 运动参数只在启动时读取（可由工具预先写入 NVS），固件运行中不修改；写入记录时保留读到的值
+// 除 begin() 外只能在状态机（后台任务）中调用
+class SettingsStore {
+public:
+    struct Settings {
+        bool motionEnabled;
+        ReportPipeline::RateMode reportRate;
+        MotionEngine::Config motion;
+    };
+
+    // NVS 中的记录，小端定长，共 20 字节
+    struct Record {
+        uint8_t version;
+        uint8_t flags;                    // FLAG_xxx
+        uint8_t reportRate;
+        uint8_t reserved;
+        uint16_t maxSpeed;                // 计数/秒
+        uint16_t smoothRateQ8;            // 1/秒，Q8.8
+        uint16_t pauseDecayRateQ8;        // 1/秒，Q8.8
+        uint16_t patternChangeIntervalMs;
+        uint16_t minMoveMs;
+        uint16_t maxMoveMs;
+        uint16_t minPauseMs;
+        uint16_t maxPauseMs;
+    };
+
+    struct Stats {
+        uint32_t loads;           // 读到有效记录的次数
+        uint32_t rejected;        // 版本、长度或参数无效而丢弃的记录
+        uint32_t changes;         // 修改了内存副本的调用
+        uint32_t commits;         // 实际写入 NVS 的次数
+        uint32_t skipped;         // 到期时与已保存记录相同而跳过的写入
+        uint32_t failures;
+        uint32_t lastLoadUs;
+        uint32_t maxCommitUs;
+    };
+
+    static const uint8_t VERSION = 1;
+    static const uint8_t FLAG_MOTION_ENABLED = 1 << 0;
+    static const uint8_t FLAG_PER_STEP_MOTION = 1 << 1;   // Config::plannerWeight 为 0（只用模式策略）；没有此位时规划器使用默认权重
+    static const uint32_t COMMIT_DELAY_MS = 5000;
+    static const uint32_t MAX_COMMIT_DELAY_MS = 30000;
+
+    // 初始化 NVS 并读取记录；返回是否读到有效记录，没有时 settings() 为编译期默认值
+    static bool begin();
+
+    static const Settings &settings();
+
+    static void setMotionEnabled(bool enabled);
+    static void setReportRate(ReportPipeline::RateMode mode);
+
+    // 写入到期的修改；后台任务每轮调用
+    static void update(uint32_t nowMs);
+    // 距下一次写入的时间，没有待写入的修改时返回 maxWaitMs
+    static uint32_t msUntilCommit(uint32_t nowMs, uint32_t maxWaitMs);
+    static bool pending();
+
+    static Stats stats();
+    static void resetStats();
+
+    // 记录与设置之间的转换，不合法的记录返回 false
+    static Record encode(const Settings &settings);
+    static bool decode(const Record &record, Settings &settings);
+    static Settings defaults();
+
+private:
+    static void markDirty();
+    static bool commit();
+};
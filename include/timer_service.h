@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "event_queue.h"
+
+// 状态机超时定时器：每个超时占一个固定的槽，槽在 begin() 时创建对应的 esp_timer 单次定时器，
+// 到期时在 esp_timer 任务中向 EventQueue 投递该槽的事件
+// - arm()/cancel() 只操作自己的槽，不分配内存、不遍历其他定时器，可在状态的 entry()/exit() 中调用
+// - 主机端由 esp_timer 替身驱动，虚拟时钟下 hostsim::advanceMillis() 即可快进到超时
+// - 到期事件投递后状态才退出时，事件仍会被分发；各状态对不属于自己的超时事件不做状态转换
+class TimerService {
+public:
+    enum class TimerId : uint8_t {
+        PAIRING_TIMEOUT,     // 到期投递 PairingTimeout
+        RECONNECT_TIMEOUT,   // 到期投递 ConnectionTimeout
+        ADVERTISING_STAGE,   // 到期投递 AdvertisingStageTimeout
+        ADVERTISING_RETRY,   // 到期投递 AdvertisingRetry
+        COUNT
+    };
+
+    struct TimerStats {
+        uint32_t armed;
+        uint32_t cancelled;   // 到期前取消
+        uint32_t expired;
+        uint32_t retries;     // 到期时事件队列已满，10ms 后重试投递
+    };
+
+    // 创建全部定时器（幂等），已启动的定时器保持运行
+    static void begin();
+
+    // 启动或重新开始计时
+    static void arm(TimerId id, uint32_t timeoutMs);
+    static void cancel(TimerId id);
+
+    static bool active(TimerId id);
+    // 距到期的剩余时间，未启动时返回 0
+    static uint32_t remainingMs(TimerId id);
+
+    static TimerStats stats(TimerId id);
+    static void resetStats();
+
+    static const char *name(TimerId id);
+
+private:
+    static void onExpire(void *arg);
+};
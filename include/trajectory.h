@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 轨迹录制格式：带时间戳的 int8 位移序列，按报告顺序紧凑编码
+// 文件 = 12 字节文件头 + 记录序列，所有多字节整数为小端
+// - 文件头：魔数 "MTRJ"、版本、保留字节、时间单位（微秒，uint16）、记录区长度（字节，uint32）
+// - 每条记录以 varint(dt << 2 | kind) 开头，dt 为距上一条记录的时间（时间单位的整数倍）
+//   - DELTA：随后为 dx、dy 两个 int8
+//   - REPEAT：随后为 varint 次数，按同样的 dt 间隔再重复上一份位移这么多次（匀速段）
+//   - END：一遍结束，dt 为最后一份位移到循环点的时间
+// 全零位移（停顿）不写入记录，停顿的时长计入下一条记录的 dt，任意长度的停顿只占一两个字节
+class Trajectory {
+public:
+    enum Kind : uint8_t {
+        DELTA = 0,
+        REPEAT = 1,
+        END = 2
+    };
+
+    struct Header {
+        uint8_t magic[4];
+        uint8_t version;
+        uint8_t reserved;
+        uint16_t unitUs;
+        uint32_t length;
+    };
+
+    // 解码出的一条记录
+    struct Record {
+        Kind kind;
+        uint32_t dt;       // 时间单位数
+        int8_t dx;         // DELTA
+        int8_t dy;
+        uint32_t count;    // REPEAT
+    };
+
+    static const uint8_t VERSION = 1;
+    static const size_t HEADER_SIZE = 12;
+    static const uint16_t DEFAULT_UNIT_US = 500;   // 7.5ms 的报告间隔也是整数个单位
+    // 单条记录的最大长度：两个 5 字节 varint
+    static const size_t MAX_RECORD_SIZE = 10;
+
+    static bool parseHeader(const uint8_t *data, size_t length, Header &header);
+    static void writeHeader(const Header &header, uint8_t *out);
+
+    // 从 data 解码一条记录：返回消耗的字节数；数据不完整返回 0，格式错误返回 -1
+    static int decodeRecord(const uint8_t *data, size_t length, Record &record);
+
+    // 编码器：按时间顺序逐份加入报告位移，写入调用方提供的缓冲区；缓冲区不足时 ok() 为 false
+    class Encoder {
+    public:
+        Encoder(uint8_t *buffer, size_t capacity, uint16_t unitUs = DEFAULT_UNIT_US);
+
+        // timeUs 为从录制开始算起的时刻，全零位移只推进时间
+        void add(uint32_t timeUs, int8_t dx, int8_t dy);
+        // 写入 END 记录（循环点为 endUs）并补全文件头，返回文件总长度
+        size_t finish(uint32_t endUs);
+
+        bool ok() const { return !overflow; }
+        size_t size() const { return used; }
+
+        struct Stats {
+            uint32_t samples;   // 非零位移的份数
+            uint32_t deltas;    // DELTA 记录
+            uint32_t repeats;   // REPEAT 记录
+        };
+        const Stats &stats() const { return counters; }
+
+    private:
+        void flushRepeat();
+        void putByte(uint8_t value);
+        void putVarint(uint32_t value);
+
+        uint8_t *out;
+        size_t capacity;
+        size_t used;
+        bool overflow;
+        uint16_t unit;
+        uint32_t lastUnits;    // 上一份位移的时刻（时间单位）
+        uint32_t lastDt;
+        int8_t lastDx;
+        int8_t lastDy;
+        uint32_t repeatCount;  // 尚未写出的重复次数
+        bool hasLast;
+        Stats counters;
+    };
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "trajectory.h"
+
+// 流式轨迹播放器：从 flash 按块读取录制的轨迹（格式见 trajectory.h），循环播放，RAM 中只有两个块
+// - 双缓冲：后台任务调用 fill() 把下一个块读入空闲的缓冲区，运动任务调用 step() 从另一个缓冲区解码；
+//   每个缓冲区由 ready 标志在两个任务之间交接，不加锁
+// - 记录可以跨越块边界；需要的块还没读入时本次不输出位移并暂停播放时间（underrun），不会在之后集中补发
+// - step() 把到期的位移累加为一份报告，超出 int8 的部分留到下一次
+// 一个实例只能有一个消费者任务和一个生产者任务
+class TrajectoryPlayer {
+public:
+    // 从轨迹所在的存储中读取：offset 从文件开头算起，返回实际读到的字节数
+    typedef size_t (*ReadFunction)(uint32_t offset, uint8_t *buffer, size_t length, void *context);
+
+    struct Output {
+        int8_t dx;
+        int8_t dy;
+    };
+
+    struct Stats {
+        uint32_t blocks;      // 读入的块（生产者）
+        uint32_t readErrors;  // 读取失败（生产者）
+        uint32_t records;     // 播放的记录（消费者）
+        uint32_t underruns;   // 需要的块未就绪而暂停的 step()
+        uint32_t loops;       // 完整播放的遍数
+        uint32_t formatErrors;
+    };
+
+    static const size_t BLOCK_SIZE = 256;
+    // 两次 step() 之间最多推进的播放时间，与 MotionEngine 相同
+    static const uint32_t MAX_STEP_US = 100000;
+
+    TrajectoryPlayer();
+
+    // 读取并校验文件头，capacity 为存储的大小；成功后预读前两个块。调用时消费者和生产者都不能运行
+    bool open(ReadFunction read, void *context, uint32_t capacity);
+    void close();
+    bool isOpen() const { return opened; }
+    uint16_t unitUs() const { return header.unitUs; }
+    uint32_t length() const { return header.length; }
+
+    // 消费者（运动任务）：从当前位置继续播放，暂停期间的时间不计入
+    void resume(uint32_t nowUs);
+    Output step(uint32_t nowUs);
+    // 有空闲的缓冲区，需要通知生产者
+    bool needsFill() const;
+
+    // 生产者（后台任务）：把后续的块读入所有空闲的缓冲区
+    void fill();
+
+    const Stats &stats() const { return counters; }
+
+private:
+    struct Block {
+        uint8_t data[BLOCK_SIZE];
+        uint16_t length;
+        bool last;                 // 记录区的最后一块，之后从头开始
+        std::atomic<bool> ready;   // true 时归消费者所有
+    };
+
+    bool fetch(Trajectory::Record &record);
+    void release();
+
+    ReadFunction read;
+    void *context;
+    Trajectory::Header header;
+    bool opened;
+    bool failed;
+    Block blocks[2];
+
+    // 生产者
+    uint32_t loadIndex;    // 下一个要读入的块的序号
+    uint32_t loadOffset;   // 它在记录区中的偏移
+
+    // 消费者
+    uint32_t readIndex;    // 当前块的序号，位于 blocks[readIndex & 1]
+    uint16_t readPos;
+    uint32_t lastStepUs;
+    uint64_t playUs;       // 本遍开始以来的播放时间
+    uint64_t eventUs;      // 最近一份位移的时刻
+    Trajectory::Record pending;
+    bool hasPending;
+    uint32_t repeatLeft;
+    uint32_t repeatDt;
+    int8_t lastDx;
+    int8_t lastDy;
+    int32_t carryX;
+    int32_t carryY;
+
+    Stats counters;
+};
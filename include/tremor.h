@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+// 手部抖动：两个轴各一路一维梯度噪声（Perlin），输出平滑、带限的速度扰动，代替每步独立的白噪声
+// - 晶格间距为 1/frequency 秒，每个晶格点从 16 项梯度表中按哈希取梯度，相邻两点之间用
+//   smootherStepQ16 插值：输出连续可导，能量集中在 frequency 附近及以下，没有逐步跳变
+// - 梯度由 (晶格序号, 种子) 哈希决定，不保存排列表；两个轴使用不同的种子，互不相关
+// - 只使用整数运算，不调用随机数发生器：当前晶格两端的梯度缓存起来，跨过晶格点时才重新哈希，
+//   每次 step() 只有一次插值权重计算和每轴两次乘法加一次插值
+class Tremor {
+public:
+    struct Config {
+        float amplitude = 40.0f;   // 峰值速度扰动（计数/秒）
+        float frequency = 6.0f;    // 晶格频率（Hz）
+    };
+
+    // 速度扰动，Q16 计数/秒
+    struct Sample {
+        int32_t x;
+        int32_t y;
+    };
+
+    Tremor();
+    explicit Tremor(const Config &config);
+
+    void setConfig(const Config &config);
+    const Config &config() const { return cfg; }
+
+    // 选择噪声序列；相同的种子得到相同的输出
+    void seed(uint32_t value);
+    // 回到序列开头
+    void reset()
+    {
+        phase = 0;
+        cellValid = false;
+    }
+
+    // 推进 dtUs 并返回新时刻的扰动
+    Sample step(uint32_t dtUs);
+
+private:
+    void loadCell(uint32_t index);
+
+    Config cfg;
+    int32_t amplitudeQ16;
+    uint32_t ratePerUs;    // 每微秒推进的晶格坐标（小数部分 32 位）
+    uint64_t phase;        // 32.32 定点晶格坐标
+    uint32_t seedX;
+    uint32_t seedY;
+    uint32_t cell;         // 缓存的晶格序号及其两端的梯度（Q15）
+    bool cellValid;
+    int32_t gradientX[2];
+    int32_t gradientY[2];
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+// 主机端 Arduino 替身：仅实现固件用到的接口，默认时间为虚拟时钟
+// delay() 只推进虚拟时间，不真正睡眠，便于在 Linux 上快速运行和计时；
+// 多任务仿真时可通过 hostsim::setRealTime() 切换为真实时钟
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+// 中断触发方式（与 esp32-hal-gpio.h 一致，低 3 位即 gpio_int_type_t；_WE 同时允许该电平唤醒浅睡眠）
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define ONLOW 0x04
+#define ONHIGH 0x05
+#define ONLOW_WE 0x0C
+#define ONHIGH_WE 0x0D
+
+#define IRAM_ATTR
+#define digitalPinToInterrupt(p) (p)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// 固件入口，由主机端运行器调用
+void setup();
+void loop();
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+// 引脚电平变化（hostsim::setPinLevel() 或预定的边沿）时在变化发生的线程中同步调用；
+// 电平中断（ONLOW/ONHIGH）在引脚进入该电平时触发一次，固件在中断中改为等待相反的电平
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// 简化的 Arduino String，仅支持固件中的拼接用法
+class String {
+public:
+    String() {}
+    String(const char *s) : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    String(char c) : str(1, c) {}
+    String(int value);
+    String(unsigned int value);
+    String(long value);
+    String(unsigned long value);
+    String(float value, unsigned int decimalPlaces = 2);
+    String(double value, unsigned int decimalPlaces = 2);
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.size(); }
+
+    String &operator+=(const String &rhs)
+    {
+        str += rhs.str;
+        return *this;
+    }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs.str + rhs.str); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(std::string(lhs) + rhs.str); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs.str + rhs); }
+
+private:
+    std::string str;
+};
+
+// 串口替身：默认只统计字节数，可通过 hostsim::setSerialEcho() 回显到 stdout
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    size_t print(const String &s);
+    size_t print(const char *s);
+    size_t print(int value);
+    size_t println(const String &s);
+    size_t println(const char *s);
+    size_t println(int value);
+    size_t println();
+};
+
+extern HardwareSerial Serial;
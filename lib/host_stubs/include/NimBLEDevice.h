@@ -0,0 +1,154 @@
+#pragma once
+
+// 主机端 NimBLE-Arduino 2.x 替身：只保留固件用到的类与方法
+// notify() 不发送任何数据，只记录报告内容和次数，供基准测试统计；
+// 可用 hostsim::setNotifyBuffers() 模拟协议栈缓冲耗尽时的失败
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <functional>
+
+#define HID_MOUSE 0x03C2
+#define BLE_HS_CONN_HANDLE_NONE 0xffff
+#define BLE_GAP_CONN_MODE_NON 0
+#define BLE_GAP_CONN_MODE_DIR 1
+#define BLE_GAP_CONN_MODE_UND 2
+
+class NimBLEServer;
+
+class NimBLEUUID {
+public:
+    NimBLEUUID() : value(0) {}
+    explicit NimBLEUUID(uint16_t uuid) : value(uuid) {}
+    uint16_t value;
+};
+
+class NimBLEAddress {
+public:
+    NimBLEAddress() : type(0) {}
+    bool operator==(const NimBLEAddress &other) const;
+    bool operator!=(const NimBLEAddress &other) const { return !(*this == other); }
+    uint8_t type;
+    uint8_t val[6] = {0};
+};
+
+class NimBLEConnInfo {
+public:
+    uint16_t getConnHandle() const { return connHandle; }
+    NimBLEAddress getAddress() const { return address; }
+    uint16_t getConnInterval() const { return connInterval; }
+    uint16_t getConnLatency() const { return connLatency; }
+    uint16_t getConnTimeout() const { return connTimeout; }
+
+    uint16_t connHandle = 0;
+    NimBLEAddress address;
+    uint16_t connInterval = 24; // 30ms，单位 1.25ms
+    uint16_t connLatency = 0;
+    uint16_t connTimeout = 400; // 4s，单位 10ms
+};
+
+class NimBLECharacteristic {
+public:
+    void setValue(const uint8_t *data, size_t length);
+    bool notify(uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE);
+
+    uint8_t value[8] = {0};
+    size_t valueLength = 0;
+};
+
+class NimBLEService {
+public:
+    explicit NimBLEService(uint16_t uuid) : uuid(uuid) {}
+    NimBLEUUID getUUID() const { return uuid; }
+
+private:
+    NimBLEUUID uuid;
+};
+
+class NimBLEAdvertising {
+public:
+    typedef std::function<void(NimBLEAdvertising *)> advCompleteCB_t;
+
+    void setAppearance(uint16_t appearance) { this->appearance = appearance; }
+    void addServiceUUID(const NimBLEUUID &) {}
+    void setName(const std::string &name) { this->name = name; }
+    bool start(uint32_t duration = 0, const NimBLEAddress *dirAddr = nullptr);
+    bool stop();
+    bool isAdvertising() const { return advertising; }
+    void setAdvertisingCompleteCallback(advCompleteCB_t callback) { completeCallback = callback; }
+    bool setConnectableMode(uint8_t mode) { connMode = mode; return true; }
+    void setScanFilter(bool scanRequestWhitelistOnly, bool connectWhitelistOnly) { connectFilter = connectWhitelistOnly; }
+    void setMinInterval(uint16_t minInterval) { this->minInterval = minInterval; }
+    void setMaxInterval(uint16_t maxInterval) { this->maxInterval = maxInterval; }
+
+    uint16_t appearance = 0;
+    std::string name;
+    bool advertising = false;
+    uint32_t startCount = 0;
+    advCompleteCB_t completeCallback;
+    uint8_t connMode = BLE_GAP_CONN_MODE_UND;
+    bool connectFilter = false;
+    uint16_t minInterval = 0;
+    uint16_t maxInterval = 0;
+    bool directed = false;       // 最近一次 start() 是否为定向广播
+    NimBLEAddress directedPeer;
+};
+
+class NimBLEServerCallbacks {
+public:
+    virtual ~NimBLEServerCallbacks() {}
+    virtual void onConnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo) {}
+    virtual void onDisconnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo, int reason) {}
+    virtual void onConnParamsUpdate(NimBLEConnInfo &connInfo) {}
+};
+
+class NimBLEServer {
+public:
+    void setCallbacks(NimBLEServerCallbacks *callbacks, bool deleteCallbacks = true) { this->callbacks = callbacks; }
+    NimBLEServerCallbacks *getCallbacks() const { return callbacks; }
+    NimBLEAdvertising *getAdvertising() { return &advertising; }
+    uint8_t getConnectedCount() const { return connectedCount; }
+    NimBLEConnInfo getPeerInfo(uint8_t index) const { return connInfo; }
+    bool updateConnParams(uint16_t connHandle, uint16_t minInterval, uint16_t maxInterval,
+                          uint16_t latency, uint16_t timeout);
+
+    NimBLEServerCallbacks *callbacks = nullptr;
+    NimBLEAdvertising advertising;
+    uint8_t connectedCount = 0;
+    NimBLEConnInfo connInfo;
+};
+
+class NimBLEHIDDevice {
+public:
+    explicit NimBLEHIDDevice(NimBLEServer *server) : hidService(0x1812) {}
+    void setManufacturer(const std::string &name) {}
+    void setPnp(uint8_t sig, uint16_t vid, uint16_t pid, uint16_t version) {}
+    void setHidInfo(uint8_t country, uint8_t flags) {}
+    void setReportMap(uint8_t *map, uint16_t size) {}
+    void setBatteryLevel(uint8_t level, bool notify = false) {}
+    void startServices() {}
+    NimBLECharacteristic *getInputReport(uint8_t reportId) { return &inputReport; }
+    NimBLEService *getHidService() { return &hidService; }
+
+private:
+    NimBLEService hidService;
+    NimBLECharacteristic inputReport;
+};
+
+class NimBLEDevice {
+public:
+    static void init(const std::string &deviceName) {}
+    static void setSecurityAuth(bool bonding, bool mitm, bool sc) {}
+    static NimBLEServer *createServer();
+    static NimBLEServer *getServer();
+
+    // 绑定和过滤接受列表（白名单）
+    static int getNumBonds();
+    static NimBLEAddress getBondedAddress(int index);
+    static bool deleteAllBonds();
+    static bool whiteListAdd(const NimBLEAddress &address);
+    static bool whiteListRemove(const NimBLEAddress &address);
+    static bool onWhiteList(const NimBLEAddress &address);
+    static size_t getWhiteListCount();
+};
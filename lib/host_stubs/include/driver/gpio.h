@@ -0,0 +1,18 @@
+#pragma once
+
+// 主机端 GPIO 驱动替身：只提供浅睡眠唤醒配置；与芯片相同，gpio_wakeup_enable() 同时把引脚的中断类型改为该电平
+
+#include "../esp_err.h"
+
+typedef int gpio_num_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL
+} gpio_int_type_t;
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type);
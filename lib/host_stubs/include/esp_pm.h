@@ -0,0 +1,30 @@
+#pragma once
+
+// 主机端 ESP-IDF 电源管理替身：记录配置和各类锁的持有计数，不改变仿真的时钟；
+// hostsim::setLightSleepSupported(false) 模拟未启用 tickless idle 的构建（浅睡眠配置被拒绝）
+
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define CONFIG_PM_ENABLE 1
+#define ESP_ERR_NOT_SUPPORTED 0x106
+
+typedef enum {
+    ESP_PM_CPU_FREQ_MAX,
+    ESP_PM_APB_FREQ_MAX,
+    ESP_PM_NO_LIGHT_SLEEP
+} esp_pm_lock_type_t;
+
+typedef struct {
+    int max_freq_mhz;
+    int min_freq_mhz;
+    bool light_sleep_enable;
+} esp_pm_config_esp32c3_t;
+
+typedef struct esp_pm_lock *esp_pm_lock_handle_t;
+
+esp_err_t esp_pm_configure(const void *config);
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t lock_type, int arg, const char *name, esp_pm_lock_handle_t *out_handle);
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle);
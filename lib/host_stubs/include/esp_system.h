@@ -0,0 +1,9 @@
+#pragma once
+
+// 主机端 ESP-IDF 系统接口替身：硬件随机数由固定种子的序列代替，hostsim::reset() 后从头开始，仿真可复现
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint32_t esp_random(void);
+void esp_fill_random(void *buffer, size_t length);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+BaseType_t xTaskCreate(TaskFunction_t taskCode, const char *name, uint32_t stackDepth,
+                       void *parameters, UBaseType_t priority, TaskHandle_t *createdTask);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t *previousWakeTime, TickType_t timeIncrement);
+#define vTaskDelayUntil(previousWakeTime, timeIncrement) ((void)xTaskDelayUntil(previousWakeTime, timeIncrement))
+TickType_t xTaskGetTickCount();
+
+// 任务通知（计数信号量用法）：虚拟时钟下 ulTaskNotifyTake() 不阻塞；
+// 通知已被 hostsim::stopTasks() 回收的任务时忽略
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
@@ -0,0 +1,12 @@
+#pragma once
+
+// 主机端 GPIO 低层接口替身：只提供中断中使用的电平读取和唤醒配置（与 ESP32-C3 的 hal/gpio_ll.h 同名同参数）
+
+#include "../driver/gpio.h"
+
+typedef struct gpio_dev_s gpio_dev_t;
+extern gpio_dev_t GPIO;
+
+int gpio_ll_get_level(gpio_dev_t *hw, gpio_num_t gpio_num);
+// 与芯片相同：设置引脚的中断类型并允许唤醒，唤醒只在电平中断类型下有效
+void gpio_ll_wakeup_enable(gpio_dev_t *hw, gpio_num_t gpio_num, gpio_int_type_t intr_type);
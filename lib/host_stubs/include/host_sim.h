@@ -0,0 +1,101 @@
+#pragma once
+
+// 主机端仿真控制接口：驱动虚拟时钟、注入引脚电平、模拟 BLE 连接并读取统计
+
+#include <stdint.h>
+#include <stddef.h>
+
+class NimBLEAddress;
+
+namespace hostsim {
+
+// 将所有替身恢复到上电状态（虚拟时间归零、引脚复位、计数清零、esp_timer 全部停止）
+void reset();
+
+// 时钟：默认为虚拟时钟，只由 advance*() 和 delay() 推进，推进时按到期顺序执行 esp_timer 回调；
+// 实时模式下 millis()/micros() 读取真实单调时钟，delay() 真正睡眠，供多任务仿真使用
+void setRealTime(bool realTime);
+bool realTime();
+uint64_t nowMicros();
+void advanceMicros(uint64_t us);
+void advanceMillis(unsigned long ms);
+
+// 引脚仿真：电平变化时调用 attachInterrupt() 安装的中断处理函数
+void setPinLevel(uint8_t pin, int level);
+int pinLevel(uint8_t pin);
+uint32_t pinWriteCount();
+
+// 预定在 delayUs 之后把引脚设为 level，由虚拟时钟推进时与 esp_timer 回调按时间顺序执行（仅虚拟时钟）
+void schedulePinLevel(uint8_t pin, int level, uint64_t delayUs);
+
+// 按键抖动波形：当前时刻切换到 level，随后回弹 bounces 次（每次短暂回到原电平，间隔逐渐变长），
+// spanUs 时稳定在 level；bounces 为 0 时即干净的单个边沿
+void bouncePin(uint8_t pin, int level, uint8_t bounces, uint32_t spanUs);
+
+// 串口
+void setSerialEcho(bool echo);
+size_t serialBytes();
+
+// BLE 连接仿真：模拟中心设备连接/断开，按 NimBLE 2.x 回调签名调用服务器回调
+void connect();
+void disconnect();
+
+// 广播仿真：之后的 count 次 NimBLEAdvertising::start() 返回失败（相当于协议栈忙）；
+// advertisingStartCount() 为成功启动广播的次数，lastAdvertisingStartUs() 为最近一次成功启动的时刻
+void failAdvertisingStarts(uint32_t count);
+// 绑定仿真：bonded 为 true 时存在一个已绑定的中心设备（地址固定），hostsim::connect() 以该设备连接
+void setBonded(bool bonded);
+NimBLEAddress bondedAddress();
+uint32_t advertisingStartCount();
+uint64_t lastAdvertisingStartUs();
+
+// xTaskCreate() 只在实时模式下为任务创建线程；停止并回收所有任务线程
+void stopTasks();
+
+// HID 报告统计（notifyCount 只计协议栈接收的报告）
+uint32_t notifyCount();
+const uint8_t *lastReport();
+
+// LEDC 时间线：每次 ledc_update_duty() 或 ledc_fade_start() 记录一条
+struct LedcEvent {
+    uint64_t timeUs;
+    uint8_t pin;
+    uint32_t startDuty;
+    uint32_t targetDuty;
+    uint32_t fadeMs;      // 0 表示立即切换
+};
+
+size_t ledcEventCount();
+LedcEvent ledcEvent(size_t index);
+void clearLedcTimeline();
+uint32_t ledcDuty(uint8_t pin);   // 当前时刻的占空比，渐变中按线性插值
+
+// 链路拥塞仿真：协议栈最多缓冲 buffers 份报告，每 drainIntervalUs 发出一份
+// （0 表示每个连接事件一份），缓冲满时 notify() 返回失败；buffers 为 0 时不限制（默认）
+void setNotifyBuffers(uint16_t buffers, uint32_t drainIntervalUs);
+uint32_t notifyFailureCount();
+
+// 电源管理：supported 为 false 时 esp_pm_configure() 拒绝启用自动浅睡眠（相当于未启用 tickless idle 的构建）；
+// pmLockCount() 为某类电源管理锁（esp_pm_lock_type_t）当前被持有的次数
+void setLightSleepSupported(bool supported);
+bool pmLightSleepEnabled();
+int pmLockCount(int type);
+// 引脚当前能唤醒浅睡眠的电平（HIGH/LOW）；未允许唤醒或中断类型不是电平（例如被 attachInterrupt(CHANGE) 改写）时为 -1
+int gpioWakeupLevel(uint8_t pin);
+
+// NVS：path 非空时 nvs_commit() 把全部内容写入该文件，reset() 之后的 nvs_flash_init() 从中加载（断电后保留）；
+// 为空时（默认）内容只在内存中，reset() 即清空。计数只包括内容有变化的写入，跨 reset() 累计
+void setNvsFile(const char *path);
+uint32_t nvsWriteCount();
+uint32_t nvsBytesWritten();
+uint32_t nvsCommitCount();
+
+// 分区：注册（或替换）一个大小为 size 的分区，前 length 字节为 data，其余为擦除后的 0xFF；
+// 分区内容跨 reset() 保留，removePartition() 之后 esp_partition_find_first() 找不到它
+void setPartition(const char *label, uint8_t type, uint8_t subtype, const uint8_t *data, size_t length,
+                  uint32_t size);
+void removePartition(const char *label);
+uint32_t partitionReadCount();
+uint64_t partitionBytesRead();
+
+} // namespace hostsim
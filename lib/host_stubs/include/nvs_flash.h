@@ -0,0 +1,8 @@
+#pragma once
+
+// 主机端 NVS 分区初始化替身，见 nvs.h
+
+#include "esp_err.h"
+
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
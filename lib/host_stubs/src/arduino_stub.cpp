@@ -0,0 +1,415 @@
+#include "Arduino.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include "esp_system.h"
+#include "hal/gpio_ll.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+
+HardwareSerial Serial;
+
+namespace {
+
+const int PIN_COUNT = 32;
+
+uint64_t virtualMicros = 0;
+bool realTimeMode = false;
+std::chrono::steady_clock::time_point realTimeStart;
+int pinLevels[PIN_COUNT];
+uint32_t pinWrites = 0;
+bool serialEcho = false;
+size_t serialByteCount = 0;
+uint32_t prngState = 1;
+uint32_t hardwareRngState = 0;
+
+struct PinInterrupt
+{
+    void (*handler)(void);
+    int type;      // gpio_int_type_t
+    bool wakeup;   // 允许唤醒浅睡眠
+};
+
+// 中断处理函数和中断类型由固件设置，复位时保留（与 esp_timer、LEDC 通道一致）
+PinInterrupt pinInterrupts[PIN_COUNT];
+
+struct ScheduledLevel
+{
+    uint64_t timeUs;
+    uint8_t pin;
+    int level;
+};
+
+std::vector<ScheduledLevel> scheduledLevels; // 按时间排序，同一时刻按预定顺序
+
+void resetPins()
+{
+    for (int i = 0; i < PIN_COUNT; i++)
+    {
+        pinLevels[i] = HIGH; // 按键上拉，默认未按下
+    }
+}
+
+struct PinInit
+{
+    PinInit() { resetPins(); }
+} pinInit;
+
+size_t serialWrite(const char *s, bool newline)
+{
+    size_t len = 0;
+    while (s[len])
+    {
+        len++;
+    }
+    if (newline)
+    {
+        len += 2;
+    }
+    serialByteCount += len;
+    if (serialEcho)
+    {
+        fputs(s, stdout);
+        if (newline)
+        {
+            fputc('\n', stdout);
+        }
+    }
+    return len;
+}
+
+} // namespace
+
+namespace hostsim {
+
+void resetArduino()
+{
+    virtualMicros = 0;
+    realTimeMode = false;
+    resetPins();
+    pinWrites = 0;
+    serialByteCount = 0;
+    prngState = 1;
+    hardwareRngState = 0;
+    scheduledLevels.clear();
+}
+
+void setRealTime(bool realTime)
+{
+    stopTimerDispatcher();
+    realTimeMode = realTime;
+    realTimeStart = std::chrono::steady_clock::now();
+    startTimerDispatcher();
+}
+
+bool realTime()
+{
+    return realTimeMode;
+}
+
+uint64_t nowMicros()
+{
+    if (realTimeMode)
+    {
+        return virtualMicros + (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - realTimeStart)
+                                   .count();
+    }
+    return virtualMicros;
+}
+
+void advanceMicros(uint64_t us)
+{
+    if (realTimeMode)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+    uint64_t targetUs = virtualMicros + us;
+    // 预定的引脚边沿与定时器回调按时间交错执行，边沿触发的中断可以启动新的定时器
+    while (!scheduledLevels.empty() && scheduledLevels.front().timeUs <= targetUs)
+    {
+        ScheduledLevel next = scheduledLevels.front();
+        scheduledLevels.erase(scheduledLevels.begin());
+        runTimersUntil(next.timeUs);
+        virtualMicros = std::max(virtualMicros, next.timeUs);
+        setPinLevel(next.pin, next.level);
+    }
+    runTimersUntil(targetUs);
+    virtualMicros = targetUs;
+}
+
+void setVirtualMicros(uint64_t us)
+{
+    virtualMicros = us;
+}
+
+void advanceMillis(unsigned long ms)
+{
+    advanceMicros((uint64_t)ms * 1000);
+}
+
+void setPinLevel(uint8_t pin, int level)
+{
+    if (pin >= PIN_COUNT)
+    {
+        return;
+    }
+    int previous = pinLevels[pin];
+    pinLevels[pin] = level;
+
+    const PinInterrupt &interrupt = pinInterrupts[pin];
+    if (interrupt.handler && previous != level &&
+        (interrupt.type == GPIO_INTR_ANYEDGE || (interrupt.type == GPIO_INTR_POSEDGE && level == HIGH) ||
+         (interrupt.type == GPIO_INTR_NEGEDGE && level == LOW) ||
+         (interrupt.type == GPIO_INTR_HIGH_LEVEL && level == HIGH) ||
+         (interrupt.type == GPIO_INTR_LOW_LEVEL && level == LOW)))
+    {
+        interrupt.handler();
+    }
+}
+
+void setPinInterruptType(uint8_t pin, int type, bool wakeup)
+{
+    if (pin < PIN_COUNT)
+    {
+        pinInterrupts[pin].type = type;
+        pinInterrupts[pin].wakeup = pinInterrupts[pin].wakeup || wakeup;
+    }
+}
+
+int gpioWakeupLevel(uint8_t pin)
+{
+    if (pin >= PIN_COUNT || !pinInterrupts[pin].wakeup)
+    {
+        return -1;
+    }
+    int type = pinInterrupts[pin].type;
+    return type == GPIO_INTR_LOW_LEVEL ? LOW : (type == GPIO_INTR_HIGH_LEVEL ? HIGH : -1);
+}
+
+void schedulePinLevel(uint8_t pin, int level, uint64_t delayUs)
+{
+    ScheduledLevel scheduled = {nowMicros() + delayUs, pin, level};
+    auto position = std::upper_bound(scheduledLevels.begin(), scheduledLevels.end(), scheduled,
+                                     [](const ScheduledLevel &a, const ScheduledLevel &b)
+                                     { return a.timeUs < b.timeUs; });
+    scheduledLevels.insert(position, scheduled);
+}
+
+// 第 k 次回弹在 spanUs * (k/bounces)^2 处回到 level，离开 level 的时刻取两次回弹的中点
+void bouncePin(uint8_t pin, int level, uint8_t bounces, uint32_t spanUs)
+{
+    int other = level == HIGH ? LOW : HIGH;
+    schedulePinLevel(pin, level, 0);
+    uint64_t previousUs = 0;
+    for (uint32_t k = 1; k <= bounces; k++)
+    {
+        uint64_t returnUs = (uint64_t)spanUs * k * k / ((uint32_t)bounces * bounces);
+        schedulePinLevel(pin, other, (previousUs + returnUs) / 2);
+        schedulePinLevel(pin, level, returnUs);
+        previousUs = returnUs;
+    }
+}
+
+int pinLevel(uint8_t pin)
+{
+    return pin < PIN_COUNT ? pinLevels[pin] : LOW;
+}
+
+uint32_t pinWriteCount()
+{
+    return pinWrites;
+}
+
+void setSerialEcho(bool echo)
+{
+    serialEcho = echo;
+}
+
+size_t serialBytes()
+{
+    return serialByteCount;
+}
+
+} // namespace hostsim
+
+unsigned long millis()
+{
+    return (unsigned long)(hostsim::nowMicros() / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)hostsim::nowMicros();
+}
+
+// 与 ESP32 Arduino 核心一致，delay() 即 vTaskDelay()
+void delay(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    hostsim::advanceMicros(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (mode == INPUT_PULLUP)
+    {
+        hostsim::setPinLevel(pin, HIGH);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    hostsim::setPinLevel(pin, val ? HIGH : LOW);
+    pinWrites++;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return hostsim::pinLevel(pin);
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    return 0;
+}
+
+// 与 Arduino 核心相同：低 3 位为中断类型，_WE 模式同时调用 gpio_wakeup_enable()；不清除已有的唤醒允许位
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode)
+{
+    if (pin < PIN_COUNT)
+    {
+        pinInterrupts[pin].handler = handler;
+        hostsim::setPinInterruptType(pin, mode & 0x07, (mode & 0x08) != 0);
+    }
+}
+
+struct gpio_dev_s {
+};
+gpio_dev_t GPIO;
+
+int gpio_ll_get_level(gpio_dev_t *, gpio_num_t gpio_num)
+{
+    return hostsim::pinLevel((uint8_t)gpio_num);
+}
+
+void gpio_ll_wakeup_enable(gpio_dev_t *, gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    hostsim::setPinInterruptType((uint8_t)gpio_num, intr_type, true);
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    if (pin < PIN_COUNT)
+    {
+        pinInterrupts[pin].handler = nullptr;
+    }
+}
+
+// 与 newlib 的 rand() 同为线性同余，保证主机端结果可复现
+long random(long howbig)
+{
+    if (howbig <= 0)
+    {
+        return 0;
+    }
+    prngState = prngState * 1103515245u + 12345u;
+    return (long)((prngState >> 1) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+    {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+    {
+        prngState = (uint32_t)seed;
+    }
+}
+
+// 硬件随机数替身：splitmix32 计数器序列
+uint32_t esp_random(void)
+{
+    uint32_t z = hardwareRngState += 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void esp_fill_random(void *buffer, size_t length)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    for (size_t i = 0; i < length; i += 4)
+    {
+        uint32_t word = esp_random();
+        for (size_t k = 0; k < 4 && i + k < length; k++)
+        {
+            out[i + k] = (uint8_t)(word >> (8 * k));
+        }
+    }
+}
+
+String::String(int value) : str(std::to_string(value)) {}
+String::String(unsigned int value) : str(std::to_string(value)) {}
+String::String(long value) : str(std::to_string(value)) {}
+String::String(unsigned long value) : str(std::to_string(value)) {}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    str = buf;
+}
+
+void HardwareSerial::begin(unsigned long baud) {}
+
+size_t HardwareSerial::print(const String &s)
+{
+    return serialWrite(s.c_str(), false);
+}
+
+size_t HardwareSerial::print(const char *s)
+{
+    return serialWrite(s, false);
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return print(String(value));
+}
+
+size_t HardwareSerial::println(const String &s)
+{
+    return serialWrite(s.c_str(), true);
+}
+
+size_t HardwareSerial::println(const char *s)
+{
+    return serialWrite(s, true);
+}
+
+size_t HardwareSerial::println(int value)
+{
+    return println(String(value));
+}
+
+size_t HardwareSerial::println()
+{
+    return serialWrite("", true);
+}
@@ -0,0 +1,138 @@
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "driver/gpio.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <mutex>
+
+struct esp_pm_lock {
+    esp_pm_lock_type_t type;
+    int count;
+};
+
+namespace {
+
+std::mutex pmMutex;
+bool lightSleepSupported = true;
+bool lightSleepEnabled = false;
+int lockCounts[ESP_PM_NO_LIGHT_SLEEP + 1] = {};
+
+} // namespace
+
+esp_err_t esp_pm_configure(const void *config)
+{
+    const esp_pm_config_esp32c3_t *pmConfig = (const esp_pm_config_esp32c3_t *)config;
+    if (!pmConfig || pmConfig->min_freq_mhz > pmConfig->max_freq_mhz)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(pmMutex);
+    if (pmConfig->light_sleep_enable && !lightSleepSupported)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    lightSleepEnabled = pmConfig->light_sleep_enable;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t lock_type, int, const char *, esp_pm_lock_handle_t *out_handle)
+{
+    if (!out_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_handle = new esp_pm_lock{lock_type, 0};
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle)
+{
+    if (!handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(pmMutex);
+    handle->count++;
+    lockCounts[handle->type]++;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle)
+{
+    if (!handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(pmMutex);
+    if (handle->count == 0)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    handle->count--;
+    lockCounts[handle->type]--;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle)
+{
+    if (!handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->count)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_pd_config(esp_sleep_pd_domain_t, esp_sleep_pd_option_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    if (gpio_num < 0 || gpio_num >= 32 || (intr_type != GPIO_INTR_LOW_LEVEL && intr_type != GPIO_INTR_HIGH_LEVEL))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    hostsim::setPinInterruptType((uint8_t)gpio_num, intr_type, true);
+    return ESP_OK;
+}
+
+namespace hostsim {
+
+// 锁句柄由固件持有并跨复位复用，这里只清零全局计数和配置
+void resetPowerManagement()
+{
+    std::lock_guard<std::mutex> lock(pmMutex);
+    lightSleepSupported = true;
+    lightSleepEnabled = false;
+}
+
+void setLightSleepSupported(bool supported)
+{
+    std::lock_guard<std::mutex> lock(pmMutex);
+    lightSleepSupported = supported;
+}
+
+bool pmLightSleepEnabled()
+{
+    std::lock_guard<std::mutex> lock(pmMutex);
+    return lightSleepEnabled;
+}
+
+int pmLockCount(int type)
+{
+    std::lock_guard<std::mutex> lock(pmMutex);
+    return type >= 0 && type <= ESP_PM_NO_LIGHT_SLEEP ? lockCounts[type] : 0;
+}
+
+} // namespace hostsim
@@ -0,0 +1,243 @@
+#include "esp_timer.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    const char *name;
+    uint64_t deadlineUs;
+    uint64_t periodUs;   // 0 表示单次
+    bool armed;
+};
+
+namespace {
+
+// timersMutex 保护定时器列表；callbackMutex 在执行回调期间持有，使回调串行执行，
+// 并让 esp_timer_stop() 等待正在执行的回调（可重入，回调内部可以启动或停止定时器）
+std::mutex timersMutex;
+std::recursive_mutex callbackMutex;
+std::condition_variable_any timersChanged;
+std::vector<esp_timer *> timers;
+
+std::thread dispatcher;
+bool dispatcherStopping = false;
+bool dispatching = false;   // 防止虚拟时钟下回调内部 delay() 造成重入
+
+const std::chrono::milliseconds WAIT_SLICE(1);
+
+// 取出最早一个到期时间不晚于 limitUs 的定时器，并按单次/周期更新状态
+esp_timer *takeDue(uint64_t limitUs, uint64_t &deadlineUs)
+{
+    esp_timer *earliest = nullptr;
+    for (esp_timer *timer : timers)
+    {
+        if (timer->armed && timer->deadlineUs <= limitUs &&
+            (!earliest || timer->deadlineUs < earliest->deadlineUs))
+        {
+            earliest = timer;
+        }
+    }
+    if (earliest)
+    {
+        deadlineUs = earliest->deadlineUs;
+        if (earliest->periodUs)
+        {
+            earliest->deadlineUs += earliest->periodUs;
+        }
+        else
+        {
+            earliest->armed = false;
+        }
+    }
+    return earliest;
+}
+
+void dispatcherLoop()
+{
+    std::unique_lock<std::mutex> lock(timersMutex);
+    while (!dispatcherStopping && hostsim::realTime())
+    {
+        uint64_t deadlineUs;
+        esp_timer *timer = takeDue(hostsim::nowMicros(), deadlineUs);
+        if (!timer)
+        {
+            timersChanged.wait_for(lock, WAIT_SLICE);
+            continue;
+        }
+        esp_timer_cb_t callback = timer->callback;
+        void *arg = timer->arg;
+        lock.unlock();
+        {
+            std::lock_guard<std::recursive_mutex> running(callbackMutex);
+            callback(arg);
+        }
+        lock.lock();
+    }
+}
+
+
+esp_err_t start(esp_timer_handle_t timer, uint64_t timeoutUs, uint64_t periodUs)
+{
+    if (!timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timersMutex);
+        if (timer->armed)
+        {
+            return ESP_ERR_INVALID_STATE; // 与 ESP-IDF 一致：运行中的定时器需先停止
+        }
+        timer->deadlineUs = hostsim::nowMicros() + timeoutUs;
+        timer->periodUs = periodUs;
+        timer->armed = true;
+    }
+    timersChanged.notify_all();
+    hostsim::startTimerDispatcher();
+    return ESP_OK;
+}
+
+} // namespace
+
+namespace hostsim {
+
+void startTimerDispatcher()
+{
+    if (realTime() && !dispatcher.joinable())
+    {
+        dispatcherStopping = false;
+        dispatcher = std::thread(dispatcherLoop);
+    }
+}
+
+void stopTimerDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(timersMutex);
+        dispatcherStopping = true;
+    }
+    timersChanged.notify_all();
+    if (dispatcher.joinable())
+    {
+        dispatcher.join();
+    }
+}
+
+// 定时器对象由固件持有，复位时只停止而不释放
+void resetEspTimer()
+{
+    stopTimerDispatcher();
+    std::lock_guard<std::mutex> lock(timersMutex);
+    for (esp_timer *timer : timers)
+    {
+        timer->armed = false;
+    }
+}
+
+void runTimersUntil(uint64_t targetUs)
+{
+    if (dispatching)
+    {
+        return;
+    }
+    dispatching = true;
+    for (;;)
+    {
+        uint64_t deadlineUs;
+        esp_timer *timer;
+        {
+            std::lock_guard<std::mutex> lock(timersMutex);
+            timer = takeDue(targetUs, deadlineUs);
+        }
+        if (!timer)
+        {
+            break;
+        }
+        setVirtualMicros(deadlineUs);
+        std::lock_guard<std::recursive_mutex> running(callbackMutex);
+        timer->callback(timer->arg);
+    }
+    dispatching = false;
+}
+
+} // namespace hostsim
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (!create_args || !create_args->callback || !out_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_timer *timer = new esp_timer();
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+    timer->name = create_args->name;
+    timer->deadlineUs = 0;
+    timer->periodUs = 0;
+    timer->armed = false;
+    std::lock_guard<std::mutex> lock(timersMutex);
+    timers.push_back(timer);
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    return start(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (!timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::recursive_mutex> running(callbackMutex);
+    std::lock_guard<std::mutex> lock(timersMutex);
+    if (!timer->armed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (!timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::recursive_mutex> running(callbackMutex);
+    std::lock_guard<std::mutex> lock(timersMutex);
+    if (timer->armed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timers.erase(std::remove(timers.begin(), timers.end(), timer), timers.end());
+    delete timer;
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    std::lock_guard<std::mutex> lock(timersMutex);
+    return timer && timer->armed;
+}
+
+int64_t esp_timer_get_time()
+{
+    return (int64_t)hostsim::nowMicros();
+}
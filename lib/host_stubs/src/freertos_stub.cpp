@@ -0,0 +1,309 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+struct QueueDefinition {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<uint8_t> storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+namespace {
+
+// 停止任务时在阻塞调用中抛出，使任务线程从任务函数中退出
+struct TaskStopped {};
+
+struct HostTask {
+    std::thread thread;
+    UBaseType_t priority;
+    std::mutex notifyMutex;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+std::mutex tasksMutex;
+std::vector<HostTask *> tasks;
+std::atomic<bool> stopping(false);
+thread_local bool inTask = false;
+thread_local HostTask *currentTask = nullptr;
+
+const std::chrono::milliseconds WAIT_SLICE(1);
+
+void checkStop()
+{
+    if (inTask && stopping.load())
+    {
+        throw TaskStopped();
+    }
+}
+
+void taskEntry(HostTask *task, TaskFunction_t taskCode, void *parameters)
+{
+    inTask = true;
+    currentTask = task;
+    try
+    {
+        taskCode(parameters);
+    }
+    catch (const TaskStopped &)
+    {
+    }
+}
+
+// 实时模式下睡眠到指定的 micros()，期间响应停止请求
+void sleepUntilMicros(uint64_t deadline)
+{
+    while (hostsim::nowMicros() < deadline)
+    {
+        checkStop();
+        uint64_t remaining = deadline - hostsim::nowMicros();
+        std::this_thread::sleep_for(std::min(std::chrono::microseconds(remaining),
+                                             std::chrono::microseconds(WAIT_SLICE)));
+    }
+    checkStop();
+}
+
+} // namespace
+
+namespace hostsim {
+
+void stopTasks()
+{
+    std::vector<HostTask *> stopped;
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        stopped.swap(tasks);
+    }
+    stopping = true;
+    for (size_t i = 0; i < stopped.size(); i++)
+    {
+        if (stopped[i]->thread.joinable())
+        {
+            stopped[i]->thread.join();
+        }
+        delete stopped[i];
+    }
+    stopping = false;
+}
+
+void resetFreeRTOS()
+{
+    stopTasks();
+}
+
+} // namespace hostsim
+
+// 虚拟时钟下没有调度器，任务只登记不运行，由仿真代码直接调用任务的单次执行体
+BaseType_t xTaskCreate(TaskFunction_t taskCode, const char *name, uint32_t stackDepth,
+                       void *parameters, UBaseType_t priority, TaskHandle_t *createdTask)
+{
+    HostTask *task = new HostTask();
+    task->priority = priority;
+    if (hostsim::realTime())
+    {
+        task->thread = std::thread(taskEntry, task, taskCode, parameters);
+    }
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasks.push_back(task);
+    }
+    if (createdTask)
+    {
+        *createdTask = task;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // 只支持任务删除自身
+    if (task == nullptr && inTask)
+    {
+        throw TaskStopped();
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (!hostsim::realTime())
+    {
+        hostsim::advanceMillis(ticks);
+        return;
+    }
+    sleepUntilMicros(hostsim::nowMicros() + (uint64_t)ticks * 1000);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previousWakeTime, TickType_t timeIncrement)
+{
+    TickType_t wakeTime = *previousWakeTime + timeIncrement;
+    TickType_t now = xTaskGetTickCount();
+    *previousWakeTime = wakeTime;
+    if ((int32_t)(wakeTime - now) <= 0)
+    {
+        return pdFALSE; // 已错过唤醒时间，不延时
+    }
+    vTaskDelay(wakeTime - now);
+    return pdTRUE;
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)(hostsim::nowMicros() / 1000);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    HostTask *task = (HostTask *)handle;
+    if (std::find(tasks.begin(), tasks.end(), task) == tasks.end())
+    {
+        return pdFAIL;
+    }
+    {
+        std::lock_guard<std::mutex> notifyLock(task->notifyMutex);
+        task->notifications++;
+    }
+    task->notified.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    HostTask *task = currentTask;
+    if (!task)
+    {
+        return 0; // 虚拟时钟下由仿真代码直接调用任务执行体，没有当前任务
+    }
+    std::unique_lock<std::mutex> lock(task->notifyMutex);
+    uint64_t deadline = hostsim::nowMicros() + (uint64_t)ticksToWait * 1000;
+    while (task->notifications == 0 && ticksToWait != 0)
+    {
+        if (ticksToWait != portMAX_DELAY && hostsim::nowMicros() >= deadline)
+        {
+            break;
+        }
+        task->notified.wait_for(lock, WAIT_SLICE);
+        checkStop();
+    }
+    uint32_t value = task->notifications;
+    if (value)
+    {
+        task->notifications = clearCountOnExit ? 0 : value - 1;
+    }
+    return value;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    QueueDefinition *queue = new QueueDefinition();
+    queue->storage.resize(length * itemSize);
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+// 队列等待：虚拟时钟下不阻塞；实时模式下按时间片等待，期间响应停止请求
+template <typename Ready>
+static bool waitQueue(QueueHandle_t queue, std::unique_lock<std::mutex> &lock, TickType_t ticksToWait, Ready ready)
+{
+    if (ready())
+    {
+        return true;
+    }
+    if (ticksToWait == 0 || !hostsim::realTime())
+    {
+        return false;
+    }
+    uint64_t deadline = hostsim::nowMicros() + (uint64_t)ticksToWait * 1000;
+    while (!ready())
+    {
+        if (ticksToWait != portMAX_DELAY && hostsim::nowMicros() >= deadline)
+        {
+            return false;
+        }
+        queue->changed.wait_for(lock, WAIT_SLICE);
+        checkStop();
+    }
+    return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitQueue(queue, lock, ticksToWait, [queue]() { return queue->count < queue->length; }))
+    {
+        return errQUEUE_FULL;
+    }
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(&queue->storage[tail * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitQueue(queue, lock, ticksToWait, [queue]() { return queue->count > 0; }))
+    {
+        return pdFALSE;
+    }
+    memcpy(buffer, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *buffer, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitQueue(queue, lock, ticksToWait, [queue]() { return queue->count > 0; }))
+    {
+        return pdFALSE;
+    }
+    memcpy(buffer, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->length - queue->count;
+}
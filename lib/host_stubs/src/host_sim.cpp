@@ -0,0 +1,17 @@
+#include "host_sim.h"
+#include "host_sim_internal.h"
+
+namespace hostsim {
+
+void reset()
+{
+    resetFreeRTOS();
+    resetEspTimer();
+    resetArduino();
+    resetNimBLE();
+    resetLedc();
+    resetPowerManagement();
+    resetNvs();
+}
+
+} // namespace hostsim
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+// 各替身模块的复位入口，由 hostsim::reset() 统一调用
+
+namespace hostsim {
+
+void resetArduino();
+void resetNimBLE();
+void resetFreeRTOS();
+void resetEspTimer();
+void resetLedc();
+void resetPowerManagement();
+void resetNvs();
+
+// 引脚中断类型（gpio_int_type_t）和唤醒允许位：attachInterrupt()、gpio_wakeup_enable() 和
+// gpio_ll_wakeup_enable() 都写同一个设置，与芯片上每个引脚只有一个中断类型一致
+void setPinInterruptType(uint8_t pin, int type, bool wakeup);
+
+// 虚拟时钟：advanceMicros() 先按到期顺序执行 [当前时间, targetUs] 内的定时器回调，
+// 每个回调执行前把时钟设为它的到期时间
+void runTimersUntil(uint64_t targetUs);
+void setVirtualMicros(uint64_t us);
+
+// 实时模式下由调度线程执行 esp_timer 回调，切换时钟模式时重新启动
+void startTimerDispatcher();
+void stopTimerDispatcher();
+
+} // namespace hostsim
@@ -0,0 +1,205 @@
+#include "driver/ledc.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Channel {
+    int gpio;
+    uint32_t duty;           // 最近一次 ledc_set_duty / 渐变的目标值
+    uint32_t pendingDuty;    // 已设置但尚未 ledc_update_duty 的值
+    uint32_t pendingFadeMs;  // 已设置但尚未 ledc_fade_start 的渐变时间
+    uint32_t fadeTarget;
+    uint32_t fadeMs;
+    uint32_t fadeStartDuty;
+    uint64_t fadeStartUs;
+    bool configured;
+};
+
+std::mutex ledcMutex;
+Channel channels[LEDC_CHANNEL_MAX] = {};
+std::vector<hostsim::LedcEvent> timeline;
+bool fadeInstalled = false;
+
+// 渐变进行中时按线性插值计算当前占空比
+uint32_t currentDuty(const Channel &channel, uint64_t nowUs)
+{
+    if (channel.fadeMs == 0)
+    {
+        return channel.duty;
+    }
+    uint64_t elapsedUs = nowUs - channel.fadeStartUs;
+    uint64_t fadeUs = channel.fadeMs * 1000ull;
+    if (elapsedUs >= fadeUs)
+    {
+        return channel.fadeTarget;
+    }
+    int64_t delta = (int64_t)channel.fadeTarget - (int64_t)channel.fadeStartDuty;
+    return (uint32_t)((int64_t)channel.fadeStartDuty + delta * (int64_t)elapsedUs / (int64_t)fadeUs);
+}
+
+void record(const Channel &channel, uint32_t startDuty, uint32_t targetDuty, uint32_t fadeMs)
+{
+    hostsim::LedcEvent event = {hostsim::nowMicros(), (uint8_t)channel.gpio, startDuty, targetDuty, fadeMs};
+    timeline.push_back(event);
+}
+
+} // namespace
+
+namespace hostsim {
+
+// 通道配置由固件的静态对象持有（只初始化一次），复位时保留，只清除占空比和时间线
+void resetLedc()
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    for (Channel &channel : channels)
+    {
+        channel.duty = 0;
+        channel.pendingDuty = 0;
+        channel.pendingFadeMs = 0;
+        channel.fadeMs = 0;
+    }
+    timeline.clear();
+}
+
+size_t ledcEventCount()
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    return timeline.size();
+}
+
+LedcEvent ledcEvent(size_t index)
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    return timeline[index];
+}
+
+void clearLedcTimeline()
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    timeline.clear();
+}
+
+uint32_t ledcDuty(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    for (const Channel &channel : channels)
+    {
+        if (channel.configured && channel.gpio == pin)
+        {
+            return currentDuty(channel, nowMicros());
+        }
+    }
+    return 0;
+}
+
+} // namespace hostsim
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *timer_conf)
+{
+    return timer_conf ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *ledc_conf)
+{
+    if (!ledc_conf || ledc_conf->channel >= LEDC_CHANNEL_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    Channel &channel = channels[ledc_conf->channel];
+    channel = Channel();
+    channel.gpio = ledc_conf->gpio_num;
+    channel.duty = ledc_conf->duty;
+    channel.pendingDuty = ledc_conf->duty;
+    channel.configured = true;
+    record(channel, ledc_conf->duty, ledc_conf->duty, 0);
+    return ESP_OK;
+}
+
+esp_err_t ledc_fade_func_install(int intr_alloc_flags)
+{
+    if (fadeInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    fadeInstalled = true;
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty)
+{
+    if (channel >= LEDC_CHANNEL_MAX || !channels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    channels[channel].pendingDuty = duty;
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t speed_mode, ledc_channel_t channel)
+{
+    if (channel >= LEDC_CHANNEL_MAX || !channels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    Channel &c = channels[channel];
+    uint32_t start = currentDuty(c, hostsim::nowMicros());
+    c.duty = c.pendingDuty;
+    c.fadeMs = 0;
+    record(c, start, c.duty, 0);
+    return ESP_OK;
+}
+
+uint32_t ledc_get_duty(ledc_mode_t speed_mode, ledc_channel_t channel)
+{
+    if (channel >= LEDC_CHANNEL_MAX)
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    return currentDuty(channels[channel], hostsim::nowMicros());
+}
+
+esp_err_t ledc_set_fade_with_time(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t target_duty, int max_fade_time_ms)
+{
+    if (!fadeInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (channel >= LEDC_CHANNEL_MAX || !channels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    Channel &c = channels[channel];
+    c.pendingDuty = target_duty;
+    c.pendingFadeMs = max_fade_time_ms;
+    return ESP_OK;
+}
+
+esp_err_t ledc_fade_start(ledc_mode_t speed_mode, ledc_channel_t channel, ledc_fade_mode_t fade_mode)
+{
+    if (!fadeInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (channel >= LEDC_CHANNEL_MAX || !channels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(ledcMutex);
+    Channel &c = channels[channel];
+    uint64_t nowUs = hostsim::nowMicros();
+    c.fadeStartDuty = currentDuty(c, nowUs);
+    c.fadeStartUs = nowUs;
+    c.fadeTarget = c.pendingDuty;
+    c.fadeMs = c.pendingFadeMs;
+    c.duty = c.fadeTarget;
+    record(c, c.fadeStartDuty, c.fadeTarget, c.fadeMs);
+    return ESP_OK;
+}
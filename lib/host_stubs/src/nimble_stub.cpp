@@ -0,0 +1,268 @@
+#include "NimBLEDevice.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+NimBLEServer server;
+bool serverCreated = false;
+uint32_t notifies = 0;
+uint8_t lastNotified[8] = {0};
+
+// 链路拥塞模型：协议栈缓冲 notifyBuffers 份报告，每 drainIntervalUs 发出一份（0 表示每个连接事件一份）
+uint16_t notifyBuffers = 0;
+uint32_t drainIntervalUs = 0;
+uint16_t queuedNotifies = 0;
+uint64_t lastDrainUs = 0;
+uint32_t notifyFailures = 0;
+
+uint32_t failingStarts = 0;
+uint64_t advertisingStartUs = 0;
+
+bool bonded = false;
+const uint8_t BONDED_ADDRESS[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+std::vector<NimBLEAddress> whiteList;
+
+// 按经过的时间清空缓冲
+void drainNotifyBuffers()
+{
+    uint64_t nowUs = hostsim::nowMicros();
+    uint64_t intervalUs = drainIntervalUs ? drainIntervalUs : server.connInfo.connInterval * 1250ull;
+    uint64_t drained = (nowUs - lastDrainUs) / intervalUs;
+    if (drained == 0)
+    {
+        return;
+    }
+    queuedNotifies = drained >= queuedNotifies ? 0 : (uint16_t)(queuedNotifies - drained);
+    lastDrainUs += drained * intervalUs;
+}
+
+} // namespace
+
+namespace hostsim {
+
+void resetNimBLE()
+{
+    server.callbacks = nullptr;
+    server.connectedCount = 0;
+    server.advertising = NimBLEAdvertising();
+    serverCreated = false;
+    server.connInfo = NimBLEConnInfo();
+    notifies = 0;
+    memset(lastNotified, 0, sizeof(lastNotified));
+    notifyBuffers = 0;
+    drainIntervalUs = 0;
+    queuedNotifies = 0;
+    lastDrainUs = 0;
+    notifyFailures = 0;
+    failingStarts = 0;
+    advertisingStartUs = 0;
+    bonded = false;
+    whiteList.clear();
+}
+
+void setBonded(bool bonded)
+{
+    ::bonded = bonded;
+}
+
+NimBLEAddress bondedAddress()
+{
+    NimBLEAddress address;
+    memcpy(address.val, BONDED_ADDRESS, sizeof(address.val));
+    return address;
+}
+
+void failAdvertisingStarts(uint32_t count)
+{
+    failingStarts = count;
+}
+
+uint32_t advertisingStartCount()
+{
+    return server.advertising.startCount;
+}
+
+uint64_t lastAdvertisingStartUs()
+{
+    return advertisingStartUs;
+}
+
+void setNotifyBuffers(uint16_t buffers, uint32_t intervalUs)
+{
+    notifyBuffers = buffers;
+    drainIntervalUs = intervalUs;
+    queuedNotifies = 0;
+    lastDrainUs = nowMicros();
+}
+
+uint32_t notifyFailureCount()
+{
+    return notifyFailures;
+}
+
+void connect()
+{
+    server.connectedCount = 1;
+    server.connInfo.address = bonded ? bondedAddress() : NimBLEAddress();
+    // 连接建立后控制器停止广播，NimBLE 调用广播结束回调
+    if (server.advertising.advertising)
+    {
+        server.advertising.advertising = false;
+        if (server.advertising.completeCallback)
+        {
+            server.advertising.completeCallback(&server.advertising);
+        }
+    }
+    if (server.callbacks)
+    {
+        server.callbacks->onConnect(&server, server.connInfo);
+    }
+}
+
+void disconnect()
+{
+    server.connectedCount = 0;
+    if (server.callbacks)
+    {
+        server.callbacks->onDisconnect(&server, server.connInfo, 0x13); // 远端用户终止连接
+    }
+}
+
+uint32_t notifyCount()
+{
+    return notifies;
+}
+
+const uint8_t *lastReport()
+{
+    return lastNotified;
+}
+
+} // namespace hostsim
+
+void NimBLECharacteristic::setValue(const uint8_t *data, size_t length)
+{
+    if (length > sizeof(value))
+    {
+        length = sizeof(value);
+    }
+    memcpy(value, data, length);
+    valueLength = length;
+}
+
+bool NimBLECharacteristic::notify(uint16_t connHandle)
+{
+    if (notifyBuffers)
+    {
+        drainNotifyBuffers();
+        if (queuedNotifies >= notifyBuffers)
+        {
+            notifyFailures++; // 相当于 mbuf 耗尽，ble_gatts_notify_custom 返回 BLE_HS_ENOMEM
+            return false;
+        }
+        queuedNotifies++;
+    }
+    notifies++;
+    memcpy(lastNotified, value, valueLength);
+    return true;
+}
+
+// 仿真的中心设备总是接受请求并选择范围内的最短间隔，立即回调
+bool NimBLEServer::updateConnParams(uint16_t connHandle, uint16_t minInterval, uint16_t maxInterval,
+                                    uint16_t latency, uint16_t timeout)
+{
+    if (connectedCount == 0)
+    {
+        return false;
+    }
+    connInfo.connInterval = minInterval;
+    connInfo.connLatency = latency;
+    connInfo.connTimeout = timeout;
+    if (callbacks)
+    {
+        callbacks->onConnParamsUpdate(connInfo);
+    }
+    return true;
+}
+
+bool NimBLEAdvertising::start(uint32_t duration, const NimBLEAddress *dirAddr)
+{
+    if (failingStarts)
+    {
+        failingStarts--;
+        return false;
+    }
+    advertising = true;
+    directed = dirAddr != nullptr;
+    directedPeer = dirAddr ? *dirAddr : NimBLEAddress();
+    startCount++;
+    advertisingStartUs = hostsim::nowMicros();
+    return true;
+}
+
+bool NimBLEAdvertising::stop()
+{
+    advertising = false;
+    return true;
+}
+
+bool NimBLEAddress::operator==(const NimBLEAddress &other) const
+{
+    return type == other.type && memcmp(val, other.val, sizeof(val)) == 0;
+}
+
+int NimBLEDevice::getNumBonds()
+{
+    return bonded ? 1 : 0;
+}
+
+NimBLEAddress NimBLEDevice::getBondedAddress(int index)
+{
+    return bonded && index == 0 ? hostsim::bondedAddress() : NimBLEAddress();
+}
+
+bool NimBLEDevice::deleteAllBonds()
+{
+    bonded = false;
+    return true;
+}
+
+bool NimBLEDevice::whiteListAdd(const NimBLEAddress &address)
+{
+    if (!onWhiteList(address))
+    {
+        whiteList.push_back(address);
+    }
+    return true;
+}
+
+bool NimBLEDevice::whiteListRemove(const NimBLEAddress &address)
+{
+    whiteList.erase(std::remove(whiteList.begin(), whiteList.end(), address), whiteList.end());
+    return true;
+}
+
+bool NimBLEDevice::onWhiteList(const NimBLEAddress &address)
+{
+    return std::find(whiteList.begin(), whiteList.end(), address) != whiteList.end();
+}
+
+size_t NimBLEDevice::getWhiteListCount()
+{
+    return whiteList.size();
+}
+
+NimBLEServer *NimBLEDevice::createServer()
+{
+    serverCreated = true;
+    return &server;
+}
+
+NimBLEServer *NimBLEDevice::getServer()
+{
+    return serverCreated ? &server : nullptr;
+}
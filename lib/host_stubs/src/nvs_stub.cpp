@@ -0,0 +1,266 @@
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "host_sim.h"
+#include "host_sim_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct OpenHandle {
+    std::string space;
+    nvs_open_mode_t mode;
+};
+
+std::mutex nvsMutex;
+std::map<std::string, std::vector<uint8_t>> entries;   // "命名空间/键" -> 值
+std::map<nvs_handle_t, OpenHandle> handles;
+nvs_handle_t nextHandle = 1;   // 跨复位递增，固件持有的旧句柄不会与新句柄相同
+bool initialized = false;
+std::string backingFile;
+uint32_t writes = 0;
+uint32_t bytesWritten = 0;
+uint32_t commits = 0;
+
+// 文件格式：每条记录为 键长度(uint16)、键、值长度(uint32)、值
+void loadFile()
+{
+    entries.clear();
+    if (backingFile.empty())
+    {
+        return;
+    }
+    FILE *file = fopen(backingFile.c_str(), "rb");
+    if (!file)
+    {
+        return;
+    }
+    uint16_t keyLength;
+    while (fread(&keyLength, sizeof(keyLength), 1, file) == 1)
+    {
+        std::string key(keyLength, '\0');
+        uint32_t valueLength;
+        if (fread(&key[0], 1, keyLength, file) != keyLength || fread(&valueLength, sizeof(valueLength), 1, file) != 1)
+        {
+            break;
+        }
+        std::vector<uint8_t> value(valueLength);
+        if (valueLength && fread(value.data(), 1, valueLength, file) != valueLength)
+        {
+            break;
+        }
+        entries[key] = value;
+    }
+    fclose(file);
+}
+
+void saveFile()
+{
+    if (backingFile.empty())
+    {
+        return;
+    }
+    FILE *file = fopen(backingFile.c_str(), "wb");
+    if (!file)
+    {
+        return;
+    }
+    for (const auto &entry : entries)
+    {
+        uint16_t keyLength = (uint16_t)entry.first.size();
+        uint32_t valueLength = (uint32_t)entry.second.size();
+        fwrite(&keyLength, sizeof(keyLength), 1, file);
+        fwrite(entry.first.data(), 1, keyLength, file);
+        fwrite(&valueLength, sizeof(valueLength), 1, file);
+        fwrite(entry.second.data(), 1, valueLength, file);
+    }
+    fclose(file);
+}
+
+OpenHandle *findHandle(nvs_handle_t handle)
+{
+    auto it = handles.find(handle);
+    return it == handles.end() ? nullptr : &it->second;
+}
+
+} // namespace
+
+esp_err_t nvs_flash_init(void)
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    if (!initialized)
+    {
+        loadFile();
+        initialized = true;
+    }
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    entries.clear();
+    handles.clear();
+    initialized = false;
+    saveFile();
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    if (!name || !out_handle || strlen(name) > 15)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    if (!initialized)
+    {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    *out_handle = nextHandle++;
+    handles[*out_handle] = OpenHandle{name, open_mode};
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    handles.erase(handle);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    if (!key || !length)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    OpenHandle *open = findHandle(handle);
+    if (!open)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    auto it = entries.find(open->space + "/" + key);
+    if (it == entries.end())
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    // out_value 为空时只返回长度
+    if (!out_value)
+    {
+        *length = it->second.size();
+        return ESP_OK;
+    }
+    if (*length < it->second.size())
+    {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(out_value, it->second.data(), it->second.size());
+    *length = it->second.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    if (!key || (!value && length))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    OpenHandle *open = findHandle(handle);
+    if (!open)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (open->mode == NVS_READONLY)
+    {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    std::vector<uint8_t> &stored = entries[open->space + "/" + key];
+    const uint8_t *bytes = (const uint8_t *)value;
+    if (stored.size() == length && (length == 0 || memcmp(stored.data(), bytes, length) == 0))
+    {
+        return ESP_OK;
+    }
+    stored.assign(bytes, bytes + length);
+    writes++;
+    bytesWritten += (uint32_t)length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    if (!key)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    OpenHandle *open = findHandle(handle);
+    if (!open)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (open->mode == NVS_READONLY)
+    {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    if (entries.erase(open->space + "/" + key) == 0)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    writes++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    if (!findHandle(handle))
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    commits++;
+    saveFile();
+    return ESP_OK;
+}
+
+namespace hostsim {
+
+// 断电重启：丢弃内存中的内容和打开的句柄，下次 nvs_flash_init() 时从文件重新加载；写入计数保留
+void resetNvs()
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    entries.clear();
+    handles.clear();
+    initialized = false;
+}
+
+void setNvsFile(const char *path)
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    backingFile = path ? path : "";
+}
+
+uint32_t nvsWriteCount()
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    return writes;
+}
+
+uint32_t nvsBytesWritten()
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    return bytesWritten;
+}
+
+uint32_t nvsCommitCount()
+{
+    std::lock_guard<std::mutex> lock(nvsMutex);
+    return commits;
+}
+
+} // namespace hostsim
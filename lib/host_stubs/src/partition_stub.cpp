@@ -0,0 +1,119 @@
+#include "esp_partition.h"
+#include "host_sim.h"
+#include <string.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Partition {
+    esp_partition_t info;
+    std::vector<uint8_t> data;
+    bool present;
+};
+
+std::mutex partitionMutex;
+std::list<Partition> partitions;   // 固件持有 esp_partition_t 指针，删除的分区只标记不释放
+uint32_t reads = 0;
+uint64_t bytesRead = 0;
+
+} // namespace
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    for (Partition &partition : partitions)
+    {
+        if (partition.present && partition.info.type == type &&
+            (subtype == ESP_PARTITION_SUBTYPE_ANY || partition.info.subtype == subtype) &&
+            (!label || strcmp(label, partition.info.label) == 0))
+        {
+            return &partition.info;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *info, size_t src_offset, void *dst, size_t size)
+{
+    if (!info || !dst)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    for (Partition &partition : partitions)
+    {
+        if (&partition.info != info)
+        {
+            continue;
+        }
+        if (!partition.present || src_offset + size > partition.info.size)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        memcpy(dst, partition.data.data() + src_offset, size);
+        reads++;
+        bytesRead += size;
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+namespace hostsim {
+
+void setPartition(const char *label, uint8_t type, uint8_t subtype, const uint8_t *data, size_t length,
+                  uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    Partition *target = nullptr;
+    for (Partition &partition : partitions)
+    {
+        if (strcmp(partition.info.label, label) == 0)
+        {
+            target = &partition;
+            break;
+        }
+    }
+    if (!target)
+    {
+        partitions.push_back(Partition());
+        target = &partitions.back();
+        strncpy(target->info.label, label, sizeof(target->info.label) - 1);
+    }
+    target->info.type = (esp_partition_type_t)type;
+    target->info.subtype = (esp_partition_subtype_t)subtype;
+    target->info.size = size;
+    target->data.assign(size, 0xFF);   // 擦除后的 flash
+    memcpy(target->data.data(), data, length < size ? length : size);
+    target->present = true;
+}
+
+void removePartition(const char *label)
+{
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    for (Partition &partition : partitions)
+    {
+        if (strcmp(partition.info.label, label) == 0)
+        {
+            partition.present = false;
+            partition.data.clear();
+        }
+    }
+}
+
+uint32_t partitionReadCount()
+{
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    return reads;
+}
+
+uint64_t partitionBytesRead()
+{
+    std::lock_guard<std::mutex> lock(partitionMutex);
+    return bytesRead;
+}
+
+} // namespace hostsim
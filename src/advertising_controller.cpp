@@ -0,0 +1,178 @@
+#include "advertising_controller.h"
+#include "event_queue.h"
+#include "logger.h"
+#include "timer_service.h"
+#include <string.h>
+
+NimBLEAdvertising *AdvertisingController::adv = nullptr;
+std::atomic<bool> AdvertisingController::wanted(false);
+std::atomic<uint32_t> AdvertisingController::pendingOriginUs(0);
+AdvertisingController::Stats AdvertisingController::counters;
+AdvertisingController::Params AdvertisingController::current = AdvertisingController::defaultParams();
+bool AdvertisingController::paramsChanged = false;
+
+static bool sameParams(const AdvertisingController::Params &a, const AdvertisingController::Params &b)
+{
+    return a.directed == b.directed && memcmp(a.peer.val, b.peer.val, sizeof(a.peer.val)) == 0 &&
+           a.peer.type == b.peer.type && a.acceptListOnly == b.acceptListOnly &&
+           a.minInterval == b.minInterval && a.maxInterval == b.maxInterval;
+}
+
+void AdvertisingController::begin(NimBLEAdvertising *advertising)
+{
+    adv = advertising;
+    adv->setAdvertisingCompleteCallback(onComplete);
+    TimerService::cancel(TimerService::TimerId::ADVERTISING_RETRY);
+    wanted = false;
+    current = defaultParams();
+    paramsChanged = false;
+}
+
+AdvertisingController::Params AdvertisingController::defaultParams()
+{
+    Params params = {};
+    return params;
+}
+
+void AdvertisingController::setParams(const Params &params)
+{
+    if (!sameParams(params, current))
+    {
+        current = params;
+        paramsChanged = true;
+    }
+}
+
+const AdvertisingController::Params &AdvertisingController::params()
+{
+    return current;
+}
+
+bool AdvertisingController::paramsPending()
+{
+    return paramsChanged;
+}
+
+uint32_t AdvertisingController::eventIntervalUs(const Params &params)
+{
+    uint32_t minUs = params.minInterval ? params.minInterval * 625u : 30000;
+    uint32_t maxUs = params.maxInterval ? params.maxInterval * 625u : 60000;
+    return (minUs + maxUs) / 2 + 5000;
+}
+
+bool AdvertisingController::ensure(uint32_t originUs)
+{
+    if (!adv)
+    {
+        LOG_ERROR("广播控制器未初始化");
+        return false;
+    }
+    if (adv->isAdvertising() && paramsChanged)
+    {
+        return restart(originUs);
+    }
+    wanted = true;
+    if (adv->isAdvertising())
+    {
+        return true;
+    }
+    pendingOriginUs = originUs;
+    return tryStart();
+}
+
+bool AdvertisingController::restart(uint32_t originUs)
+{
+    if (!adv)
+    {
+        LOG_ERROR("广播控制器未初始化");
+        return false;
+    }
+    counters.restarts++;
+    wanted = true;
+    if (adv->isAdvertising())
+    {
+        adv->stop(); // ble_gap_adv_stop() 同步返回，可以立即重新启动
+    }
+    pendingOriginUs = originUs;
+    return tryStart();
+}
+
+void AdvertisingController::stop()
+{
+    wanted = false;
+    TimerService::cancel(TimerService::TimerId::ADVERTISING_RETRY);
+    if (adv && adv->isAdvertising())
+    {
+        adv->stop();
+    }
+}
+
+bool AdvertisingController::advertising()
+{
+    return adv && adv->isAdvertising();
+}
+
+bool AdvertisingController::tryStart()
+{
+    adv->setConnectableMode(current.directed ? BLE_GAP_CONN_MODE_DIR : BLE_GAP_CONN_MODE_UND);
+    adv->setScanFilter(current.acceptListOnly, current.acceptListOnly);
+    adv->setMinInterval(current.minInterval);
+    adv->setMaxInterval(current.maxInterval);
+    paramsChanged = false;
+    if (!adv->start(0, current.directed ? &current.peer : nullptr))
+    {
+        scheduleRetry();
+        return false;
+    }
+    uint32_t latencyUs = micros() - pendingOriginUs.load();
+    counters.starts++;
+    counters.lastLatencyUs = latencyUs;
+    if (latencyUs > counters.maxLatencyUs)
+    {
+        counters.maxLatencyUs = latencyUs;
+    }
+    LOG_DEBUG("广播已启动，距触发事件 %lu us", (unsigned long)latencyUs);
+    return true;
+}
+
+void AdvertisingController::scheduleRetry()
+{
+    if (!TimerService::active(TimerService::TimerId::ADVERTISING_RETRY))
+    {
+        TimerService::arm(TimerService::TimerId::ADVERTISING_RETRY, RETRY_MS);
+    }
+}
+
+// 在状态机中调用；事件投递之后 stop() 过或广播已由 ensure()/restart() 启动时忽略
+void AdvertisingController::retry()
+{
+    if (!adv || !wanted || adv->isAdvertising())
+    {
+        return;
+    }
+    counters.retries++;
+    tryStart();
+}
+
+// 在 NimBLE 主机任务中调用：连接建立时广播结束属于正常情况，由状态机决定下一步；
+// 没有连接时（超时或被协议栈终止）投递 AdvertisingRetry，由状态机重新启动
+void AdvertisingController::onComplete(NimBLEAdvertising *)
+{
+    counters.completions++;
+    NimBLEServer *server = NimBLEDevice::getServer();
+    if (wanted && (!server || server->getConnectedCount() == 0))
+    {
+        pendingOriginUs = micros();
+        EventQueue::post(EventQueue::EventId::ADVERTISING_RETRY);
+    }
+}
+
+AdvertisingController::Stats AdvertisingController::stats()
+{
+    return counters;
+}
+
+void AdvertisingController::resetStats()
+{
+    counters = Stats();
+}
@@ -0,0 +1,208 @@
+#include "advertising_schedule.h"
+#include "advertising_controller.h"
+#include "timer_service.h"
+#include "logger.h"
+
+typedef AdvertisingSchedule::Stage Stage;
+
+// 间隔单位 0.625ms：20~30ms、30~60ms、152.5~211.25ms、1022.5~1285ms
+// 空闲时没有主机在等待，30s 后放宽到约 150ms，5 分钟后到约 1s
+static const Stage IDLE_STAGES[] = {
+    {"fast", false, false, 32, 48, 30000},
+    {"medium", false, false, 244, 338, 300000},
+    {"slow", false, false, 1636, 2056, 0},
+};
+
+static const Stage PAIRING_STAGES[] = {
+    {"fast", false, false, 32, 48, 0},   // 配对只持续 60s（PairingTimeout）
+};
+
+// 主机多在断开很久之后才醒来并以低占空比后台扫描，间隔越长醒来后找到设备越慢，
+// 所以前 5 分钟保持改造前的 30~60ms，之后才放宽
+static const Stage RECONNECT_BONDED_STAGES[] = {
+    {"directed", true, true, 32, 32, 1280},   // 与高占空比定向广播的 1.28s 上限相同
+    {"fast", false, true, 32, 48, 30000},
+    {"medium", false, true, 48, 96, 300000},
+    {"slow", false, true, 244, 338, 0},
+};
+
+// 没有绑定时任何主机都可以连接，间隔变化与有绑定时相同
+static const Stage RECONNECT_OPEN_STAGES[] = {
+    {"fast", false, false, 32, 48, 30000},
+    {"medium", false, false, 48, 96, 300000},
+    {"slow", false, false, 244, 338, 0},
+};
+
+struct ScheduleSlot {
+    const char *name;
+    const Stage *stages;
+    uint8_t count;
+    AdvertisingSchedule::StageStats stats[AdvertisingSchedule::MAX_STAGES];
+};
+
+static ScheduleSlot schedules[(int)AdvertisingSchedule::ScheduleId::COUNT] = {
+    {"idle", IDLE_STAGES, sizeof(IDLE_STAGES) / sizeof(IDLE_STAGES[0]), {}},
+    {"pairing", PAIRING_STAGES, sizeof(PAIRING_STAGES) / sizeof(PAIRING_STAGES[0]), {}},
+    {"reconnect_bonded", RECONNECT_BONDED_STAGES,
+     sizeof(RECONNECT_BONDED_STAGES) / sizeof(RECONNECT_BONDED_STAGES[0]), {}},
+    {"reconnect_open", RECONNECT_OPEN_STAGES,
+     sizeof(RECONNECT_OPEN_STAGES) / sizeof(RECONNECT_OPEN_STAGES[0]), {}},
+};
+
+static bool active = false;
+static AdvertisingSchedule::ScheduleId currentSchedule = AdvertisingSchedule::ScheduleId::IDLE;
+static uint8_t currentStage = 0;
+static uint32_t scheduleStartMs = 0;
+static uint32_t stageStartUs = 0;
+static NimBLEAddress peerAddress;
+
+void AdvertisingSchedule::setSchedule(ScheduleId id, const Stage *stages, uint8_t count)
+{
+    if (!stages || count == 0 || count > MAX_STAGES)
+    {
+        LOG_ERROR("广播计划 %s 的阶段数无效: %u", name(id), count);
+        return;
+    }
+    ScheduleSlot &slot = schedules[(int)id];
+    slot.stages = stages;
+    slot.count = count;
+    memset(slot.stats, 0, sizeof(slot.stats));
+}
+
+void AdvertisingSchedule::setPeer(const NimBLEAddress &peer)
+{
+    peerAddress = peer;
+}
+
+bool AdvertisingSchedule::start(ScheduleId id, uint32_t originUs, bool restart)
+{
+    closeStage();
+    active = true;
+    currentSchedule = id;
+    scheduleStartMs = millis();
+    return enterStage(0, originUs, restart);
+}
+
+void AdvertisingSchedule::advance()
+{
+    const ScheduleSlot &slot = schedules[(int)currentSchedule];
+    if (!active || currentStage + 1 >= slot.count)
+    {
+        return;
+    }
+    closeStage();
+    enterStage(currentStage + 1, micros(), false);
+}
+
+bool AdvertisingSchedule::enterStage(uint8_t index, uint32_t originUs, bool restart)
+{
+    ScheduleSlot &slot = schedules[(int)currentSchedule];
+    const Stage &stage = slot.stages[index];
+    currentStage = index;
+    stageStartUs = micros();
+    slot.stats[index].entries++;
+
+    AdvertisingController::Params params = AdvertisingController::defaultParams();
+    params.directed = stage.directed;
+    params.peer = peerAddress;
+    params.acceptListOnly = stage.acceptListOnly;
+    params.minInterval = stage.minInterval;
+    params.maxInterval = stage.maxInterval;
+    AdvertisingController::setParams(params);
+    bool started = restart ? AdvertisingController::restart(originUs) : AdvertisingController::ensure(originUs);
+
+    // 按计划开始的时间计算，阶段切换的延迟不累积
+    if (stage.untilMs && index + 1 < slot.count)
+    {
+        int32_t remainingMs = (int32_t)(scheduleStartMs + stage.untilMs - millis());
+        TimerService::arm(TimerService::TimerId::ADVERTISING_STAGE, remainingMs > 0 ? (uint32_t)remainingMs : 0);
+    }
+    else
+    {
+        TimerService::cancel(TimerService::TimerId::ADVERTISING_STAGE);
+    }
+    LOG_INFO("广播计划 %s 进入阶段 %s", slot.name, stage.name);
+    return started;
+}
+
+// 把当前阶段的广播时间和估算的广播事件数记入统计
+void AdvertisingSchedule::closeStage()
+{
+    if (!active)
+    {
+        return;
+    }
+    uint32_t elapsedUs = micros() - stageStartUs;
+    StageStats &stats = schedules[(int)currentSchedule].stats[currentStage];
+    stats.activeMs += elapsedUs / 1000;
+    stats.events += elapsedUs / AdvertisingController::eventIntervalUs(AdvertisingController::params());
+    stageStartUs = micros();
+}
+
+void AdvertisingSchedule::onConnected()
+{
+    if (active)
+    {
+        schedules[(int)currentSchedule].stats[currentStage].connects++;
+    }
+    stop();
+}
+
+void AdvertisingSchedule::stop()
+{
+    closeStage();
+    active = false;
+    TimerService::cancel(TimerService::TimerId::ADVERTISING_STAGE);
+    AdvertisingController::stop();
+}
+
+bool AdvertisingSchedule::running()
+{
+    return active;
+}
+
+AdvertisingSchedule::ScheduleId AdvertisingSchedule::schedule()
+{
+    return currentSchedule;
+}
+
+uint8_t AdvertisingSchedule::stage()
+{
+    return currentStage;
+}
+
+const Stage *AdvertisingSchedule::stages(ScheduleId id)
+{
+    return schedules[(int)id].stages;
+}
+
+uint8_t AdvertisingSchedule::stageCount(ScheduleId id)
+{
+    return schedules[(int)id].count;
+}
+
+const char *AdvertisingSchedule::stageName(ScheduleId id, uint8_t stage)
+{
+    const ScheduleSlot &slot = schedules[(int)id];
+    return stage < slot.count ? slot.stages[stage].name : "?";
+}
+
+const char *AdvertisingSchedule::name(ScheduleId id)
+{
+    return (int)id < (int)ScheduleId::COUNT ? schedules[(int)id].name : "?";
+}
+
+AdvertisingSchedule::StageStats AdvertisingSchedule::stageStats(ScheduleId id, uint8_t stage)
+{
+    closeStage(); // 计入当前阶段到目前为止的时间
+    return stage < MAX_STAGES ? schedules[(int)id].stats[stage] : StageStats();
+}
+
+void AdvertisingSchedule::resetStats()
+{
+    for (ScheduleSlot &slot : schedules)
+    {
+        memset(slot.stats, 0, sizeof(slot.stats));
+    }
+    stageStartUs = micros();
+}
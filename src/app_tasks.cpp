@@ -0,0 +1,403 @@
+#include "app_tasks.h"
+#include "state_machine.h"
+#include "motion_engine.h"
+#include "prng.h"
+#include "fixed_point.h"
+#include "report_pipeline.h"
+#include "conn_params.h"
+#include "event_queue.h"
+#include "timer_service.h"
+#include "power_manager.h"
+#include "settings_store.h"
+#include "trajectory_player.h"
+#include "logger.h"
+#include <NimBLEDevice.h>
+#include <esp_partition.h>
+
+// 全局变量声明
+extern NimBLECharacteristic *inputMouse;
+extern bool deviceConnected;
+
+// 队列长度
+static const UBaseType_t MOTION_COMMAND_QUEUE_LENGTH = 4;
+static const UBaseType_t MOTION_LOG_QUEUE_LENGTH = 8;
+
+static const uint32_t TASK_STACK_SIZE = 4096;
+
+// 运动任务 -> 后台任务的日志记录，由后台任务负责串口输出
+struct MotionLogRecord {
+    uint8_t events;
+    uint8_t source;   // MotionEngine::Source
+    uint8_t pattern;
+    uint16_t moveDurationMs;
+    uint16_t pauseDurationMs;
+    int32_t radius;
+};
+
+QueueHandle_t AppTasks::motionCommandQueue = nullptr;
+QueueHandle_t AppTasks::motionLogQueue = nullptr;
+AppTasks::TaskStats AppTasks::taskStats[(int)AppTasks::TaskId::COUNT];
+std::atomic<uint8_t> AppTasks::requestedRate((uint8_t)ReportPipeline::RateMode::HZ_100);
+
+// 后台任务句柄：运动任务投递日志记录后通知它
+static TaskHandle_t housekeepingHandle = nullptr;
+
+// 运动状态（仅运动任务访问）
+static MotionEngine motionEngine;
+static bool motionEnabled = false;
+
+// 录制的轨迹：存在时代替 MotionEngine 作为运动来源，由后台任务按块读入，运动任务播放
+static const char *const TRAJECTORY_PARTITION = "motion";
+static const esp_partition_subtype_t TRAJECTORY_SUBTYPE = (esp_partition_subtype_t)0x40;
+static TrajectoryPlayer trajectoryPlayer;
+
+static size_t readPartition(uint32_t offset, uint8_t *buffer, size_t length, void *context)
+{
+    const esp_partition_t *partition = (const esp_partition_t *)context;
+    return esp_partition_read(partition, offset, buffer, length) == ESP_OK ? length : 0;
+}
+
+// 队列满时直接丢弃
+static void postMotionLog(QueueHandle_t queue, const MotionLogRecord &record)
+{
+    if (xQueueSend(queue, &record, 0) == pdPASS && housekeepingHandle)
+    {
+        xTaskNotifyGive(housekeepingHandle);
+    }
+}
+
+static bool notifyReport(const uint8_t *report, size_t length, void *)
+{
+    if (!inputMouse || !deviceConnected)
+    {
+        return false;
+    }
+    inputMouse->setValue(report, length);
+    return inputMouse->notify();
+}
+
+// 报告整形：合并同一连接间隔内的位移，丢弃重复的释放报告
+static ReportPipeline reportPipeline(notifyReport, nullptr);
+
+void AppTasks::init()
+{
+    if (!motionCommandQueue)
+    {
+        motionCommandQueue = xQueueCreate(MOTION_COMMAND_QUEUE_LENGTH, sizeof(MotionCommand));
+        motionLogQueue = xQueueCreate(MOTION_LOG_QUEUE_LENGTH, sizeof(MotionLogRecord));
+    }
+    EventQueue::clear();
+    TimerService::begin();
+    ButtonEngine::begin(BOOT_BUTTON_PIN, postButtonEvent, nullptr);
+    openTrajectory();
+}
+
+// 分区不存在或没有有效的轨迹（例如擦除后的 0xFF）时使用 MotionEngine
+void AppTasks::openTrajectory()
+{
+    const esp_partition_t *partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, TRAJECTORY_SUBTYPE, TRAJECTORY_PARTITION);
+    if (partition && trajectoryPlayer.open(readPartition, (void *)partition, partition->size))
+    {
+        LOG_INFO("使用录制的轨迹：%lu 字节，时间单位 %uus", (unsigned long)trajectoryPlayer.length(),
+                 trajectoryPlayer.unitUs());
+    }
+    else
+    {
+        trajectoryPlayer.close();
+        LOG_DEBUG("没有录制的轨迹，使用生成的移动");
+    }
+}
+
+bool AppTasks::playingTrajectory()
+{
+    return trajectoryPlayer.isOpen();
+}
+
+const TrajectoryPlayer::Stats &AppTasks::trajectoryStats()
+{
+    return trajectoryPlayer.stats();
+}
+
+static_assert((int)EventQueue::EventId::BOOT_VERY_LONG_PRESS - (int)EventQueue::EventId::BOOT_SHORT_PRESS ==
+                  (int)ButtonEngine::Gesture::VERY_LONG_PRESS,
+              "按键事件的顺序必须与 ButtonEngine::Gesture 一致");
+
+// 在 esp_timer 任务中调用，不能阻塞；手势按 Gesture 的顺序对应 BOOT_xxx 事件
+void AppTasks::postButtonEvent(const ButtonEngine::Event &event, void *)
+{
+    EventQueue::EventId id = (EventQueue::EventId)((int)EventQueue::EventId::BOOT_SHORT_PRESS + (int)event.gesture);
+    if (!EventQueue::post(id, event.originUs))
+    {
+        LOG_WARN("状态机事件队列已满，按键事件被丢弃");
+    }
+}
+
+void AppTasks::start()
+{
+    // setup() 已调用过 init() 时不再清空事件队列，保留初始化期间投递的连接事件
+    if (!motionCommandQueue)
+    {
+        init();
+    }
+    xTaskCreate(motionTask, "motion", TASK_STACK_SIZE, nullptr, MOTION_PRIORITY, nullptr);
+    xTaskCreate(housekeepingTask, "housekeeping", TASK_STACK_SIZE, nullptr, HOUSEKEEPING_PRIORITY,
+                &housekeepingHandle);
+    EventQueue::setConsumer(housekeepingHandle);
+}
+
+void AppTasks::requestMotion(bool enabled)
+{
+    MotionCommand command = enabled ? MotionCommand::ENABLE : MotionCommand::DISABLE;
+    // 按报告周期运行时保持最高频率、不睡眠，避免调频和唤醒延迟打乱报告节奏
+    PowerManager::require(PowerManager::Client::MOTION,
+                          enabled ? PowerManager::Level::FULL_SPEED : PowerManager::Level::SLEEP);
+    if (xQueueSend(motionCommandQueue, &command, 0) != pdPASS)
+    {
+        LOG_WARN("运动命令队列已满，命令被丢弃");
+    }
+}
+
+const AppTasks::TaskStats &AppTasks::stats(TaskId id)
+{
+    return taskStats[(int)id];
+}
+
+void AppTasks::setReportRate(ReportPipeline::RateMode mode)
+{
+    requestedRate = (uint8_t)mode;
+}
+
+ReportPipeline::RateMode AppTasks::reportRate()
+{
+    return (ReportPipeline::RateMode)requestedRate.load();
+}
+
+void AppTasks::setMotionConfig(const MotionEngine::Config &config)
+{
+    motionEngine.setConfig(config);
+}
+
+uint8_t AppTasks::reportBackoffLevel()
+{
+    return reportPipeline.backoffLevel();
+}
+
+uint32_t AppTasks::reportIntervalUs()
+{
+    return reportPipeline.intervalUs();
+}
+
+void AppTasks::motionTask(void *)
+{
+    TickType_t lastWake = xTaskGetTickCount();
+    uint32_t carryUs = 0;
+    for (;;)
+    {
+        uint32_t plannedUs = 0;
+        if (motionEnabled)
+        {
+            // 周期跟随速率档位；7.5ms 这类不是整数个节拍的周期由余数累积，交替使用 7/8 个节拍
+            uint32_t periodUs = ReportPipeline::rateIntervalUs(reportRate());
+            uint32_t ticks = (periodUs + carryUs) / (1000 * portTICK_PERIOD_MS);
+            carryUs = periodUs + carryUs - ticks * 1000 * portTICK_PERIOD_MS;
+            vTaskDelayUntil(&lastWake, ticks);
+            plannedUs = ticks * 1000 * portTICK_PERIOD_MS;
+        }
+        else
+        {
+            // 停止移动时阻塞到下一条命令，不再按报告周期唤醒；命令由 motionStep() 取出
+            MotionCommand command;
+            xQueuePeek(motionCommandQueue, &command, portMAX_DELAY);
+            lastWake = xTaskGetTickCount();
+            carryUs = 0;
+        }
+        uint32_t startUs = micros();
+        motionStep();
+        recordRun(TaskId::MOTION, plannedUs, startUs);
+    }
+}
+
+void AppTasks::housekeepingTask(void *)
+{
+    for (;;)
+    {
+        // 只被事件投递、运动日志和设置的写入时间唤醒，没有固定周期
+        housekeepingStep(portMAX_DELAY);
+        recordRun(TaskId::HOUSEKEEPING, 0, micros());
+    }
+}
+
+void AppTasks::resetStats()
+{
+    for (int i = 0; i < (int)TaskId::COUNT; i++)
+    {
+        taskStats[i] = TaskStats();
+    }
+}
+
+// 记录一次执行：periodUs 为 0 的任务由事件驱动，不统计唤醒延迟
+void AppTasks::recordRun(TaskId id, uint32_t periodUs, uint32_t startUs)
+{
+    static uint32_t lastStartUs[(int)TaskId::COUNT];
+    TaskStats &stats = taskStats[(int)id];
+    uint32_t runUs = micros() - startUs;
+
+    if (periodUs && stats.iterations > 0)
+    {
+        uint32_t intervalUs = startUs - lastStartUs[(int)id];
+        if (intervalUs > periodUs && intervalUs - periodUs > stats.maxLateUs)
+        {
+            stats.maxLateUs = intervalUs - periodUs;
+        }
+    }
+    if (runUs > stats.maxRunUs)
+    {
+        stats.maxRunUs = runUs;
+    }
+    lastStartUs[(int)id] = startUs;
+    stats.iterations++;
+}
+
+void AppTasks::motionStep()
+{
+    PowerManager::noteWakeup();
+    MotionCommand command;
+    while (xQueueReceive(motionCommandQueue, &command, 0) == pdTRUE)
+    {
+        if (command == MotionCommand::ENABLE)
+        {
+            motionEnabled = true;
+            reportPipeline.reset();
+            if (trajectoryPlayer.isOpen())
+            {
+                // 轨迹从上次停下的位置继续
+                trajectoryPlayer.resume(micros());
+                continue;
+            }
+            // 每次开启重新取种子：此时已连接，射频开启，硬件随机数可用
+            motionEngine.seed(Prng::hardwareSeed());
+            motionEngine.setStepInterval(ReportPipeline::rateIntervalUs(reportRate()));
+            motionEngine.reset(micros());
+
+            const MotionEngine::State &state = motionEngine.state();
+            MotionLogRecord record = {MotionEngine::EVENT_MOVE_STARTED, (uint8_t)state.source, (uint8_t)state.pattern,
+                                      state.moveDurationMs, state.pauseDurationMs, state.radius};
+            postMotionLog(motionLogQueue, record);
+        }
+        else
+        {
+            motionEnabled = false;
+            // 确保鼠标报告不发送移动数据
+            if (inputMouse && deviceConnected)
+            {
+                uint8_t mouseReport[4] = {0, 0, 0, 0}; // 无移动的空报告
+                inputMouse->setValue(mouseReport, sizeof(mouseReport));
+            }
+        }
+    }
+
+    if (!motionEnabled)
+    {
+        return;
+    }
+
+    // 每个连接间隔最多发送一份报告，间隔随参数协商结果更新
+    uint32_t linkIntervalUs = ConnParams::intervalUs();
+    if (linkIntervalUs)
+    {
+        reportPipeline.setMinInterval(linkIntervalUs);
+    }
+    reportPipeline.setRateMode(reportRate());
+
+    uint32_t nowUs = micros();
+    if (trajectoryPlayer.isOpen())
+    {
+        TrajectoryPlayer::Output output = trajectoryPlayer.step(nowUs);
+        if (trajectoryPlayer.needsFill() && housekeepingHandle)
+        {
+            xTaskNotifyGive(housekeepingHandle);
+        }
+        reportPipeline.submit(output.dx, output.dy, nowUs);
+        return;
+    }
+
+    motionEngine.setStepInterval(ReportPipeline::rateIntervalUs(reportRate()));
+    MotionEngine::Report motion = motionEngine.step(nowUs);
+
+    // 阶段和模式切换只投递记录，由后台任务输出，队列满时直接丢弃
+    if (motion.events)
+    {
+        const MotionEngine::State &state = motionEngine.state();
+        MotionLogRecord record = {motion.events, (uint8_t)state.source, (uint8_t)state.pattern,
+                                  state.moveDurationMs, state.pauseDurationMs, state.radius};
+        postMotionLog(motionLogQueue, record);
+    }
+
+    reportPipeline.submit(motion.dx, motion.dy, nowUs);
+}
+
+const ReportPipeline::Stats &AppTasks::reportStats()
+{
+    return reportPipeline.stats();
+}
+
+void AppTasks::housekeepingStep(TickType_t maxWaitTicks)
+{
+    // 等待通知（状态超时也由 TimerService 投递事件唤醒）或设置的写入时间，
+    // 唤醒后分发队列中的全部事件（通知可能合并，以队列为准）
+    TickType_t waitTicks = maxWaitTicks;
+    uint32_t waitMs = msUntilHousekeeping(millis());
+    if (waitMs != NO_DEADLINE && pdMS_TO_TICKS(waitMs) < waitTicks)
+    {
+        waitTicks = pdMS_TO_TICKS(waitMs);
+    }
+    if (waitTicks)
+    {
+        ulTaskNotifyTake(pdTRUE, waitTicks);
+    }
+    PowerManager::noteWakeup();
+    EventQueue::dispatchAll();
+    printMotionLog();
+    trajectoryPlayer.fill();
+    SettingsStore::update(millis());
+    PowerManager::update();
+}
+
+uint32_t AppTasks::msUntilHousekeeping(uint32_t nowMs)
+{
+    return SettingsStore::msUntilCommit(nowMs, NO_DEADLINE);
+}
+
+void AppTasks::wakeHousekeeping()
+{
+    if (housekeepingHandle)
+    {
+        xTaskNotifyGive(housekeepingHandle);
+    }
+}
+
+void AppTasks::printMotionLog()
+{
+    MotionLogRecord record;
+    while (xQueueReceive(motionLogQueue, &record, 0) == pdTRUE)
+    {
+        if (record.events & MotionEngine::EVENT_PAUSE_STARTED)
+        {
+            LOG_INFO("切换到停顿阶段，停顿时长: %ums", record.pauseDurationMs);
+        }
+        if (record.events & MotionEngine::EVENT_MOVE_STARTED)
+        {
+            LOG_INFO("切换到移动阶段，移动时长: %ums", record.moveDurationMs);
+        }
+        if ((record.events & MotionEngine::EVENT_PATTERN_CHANGED) &&
+            record.source == (uint8_t)MotionEngine::Source::PLANNER)
+        {
+            LOG_INFO("切换到规划移动，峰值速度: %.2f", fixed::q16ToFloat(record.radius));
+        }
+        else if (record.events & MotionEngine::EVENT_PATTERN_CHANGED)
+        {
+            LOG_INFO("切换到移动模式: %u, 幅度: %.2f", record.pattern, fixed::q16ToFloat(record.radius));
+        }
+    }
+}
@@ -0,0 +1,228 @@
+#include "button_engine.h"
+#include "logger.h"
+#include <hal/gpio_ll.h>
+
+const uint32_t ButtonEngine::HOLD_LEVELS_MS[ButtonEngine::HOLD_LEVEL_COUNT] = {3000, 8000};
+
+uint8_t ButtonEngine::buttonPin = 0;
+ButtonEngine::Sink ButtonEngine::eventSink = nullptr;
+void *ButtonEngine::sinkContext = nullptr;
+esp_timer_handle_t ButtonEngine::debounceTimer = nullptr;
+esp_timer_handle_t ButtonEngine::gestureTimer = nullptr;
+
+std::atomic<uint32_t> ButtonEngine::edgeCount(0);
+std::atomic<uint32_t> ButtonEngine::settledCount(0);
+std::atomic<uint32_t> ButtonEngine::lastEdgeUs(0);
+std::atomic<uint32_t> ButtonEngine::burstStartUs(0);
+
+bool ButtonEngine::stablePressed = false;
+uint32_t ButtonEngine::pressUs = 0;
+uint32_t ButtonEngine::releaseUs = 0;
+uint8_t ButtonEngine::clicks = 0;
+uint8_t ButtonEngine::holdLevel = 0;
+ButtonEngine::Stats ButtonEngine::counters;
+
+static uint32_t edgeBase = 0; // resetStats() 时的边沿计数
+
+static const char *const GESTURE_NAMES[] = {"短按", "双击", "三击", "长按", "超长按"};
+
+// esp_timer 时间的低 32 位：约 71 分钟回绕一次，只用于求差
+static inline uint32_t timerNowUs()
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+static esp_timer_handle_t createTimer(esp_timer_cb_t callback, const char *name)
+{
+    esp_timer_create_args_t args = {};
+    args.callback = callback;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = name;
+    esp_timer_handle_t timer = nullptr;
+    esp_timer_create(&args, &timer);
+    return timer;
+}
+
+void ButtonEngine::begin(uint8_t pin, Sink sink, void *context)
+{
+    eventSink = sink;
+    sinkContext = context;
+
+    if (!debounceTimer)
+    {
+        buttonPin = pin;
+        pinMode(pin, INPUT_PULLUP);
+        debounceTimer = createTimer(onDebounceTimer, "btn_debounce");
+        gestureTimer = createTimer(onGestureTimer, "btn_gesture");
+        bool low = digitalRead(pin) == LOW;
+        attachInterrupt(digitalPinToInterrupt(pin), onEdge, low ? ONHIGH_WE : ONLOW_WE);
+    }
+    else
+    {
+        esp_timer_stop(debounceTimer); // 未运行时返回 ESP_ERR_INVALID_STATE，忽略
+        esp_timer_stop(gestureTimer);
+        bool low = digitalRead(buttonPin) == LOW;
+        gpio_ll_wakeup_enable(&GPIO, (gpio_num_t)buttonPin, low ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+    }
+
+    // 以当前电平为稳定状态，丢弃未完成的手势
+    settledCount.store(edgeCount.load());
+    stablePressed = digitalRead(buttonPin) == LOW;
+    clicks = 0;
+    holdLevel = 0;
+}
+
+// 中断中先改为等待相反的电平（清除本次触发，同时更新浅睡眠的唤醒电平），再记录时间并在空闲时启动消抖定时器；
+// 中断可能在 flash 操作期间运行，只调用内联的 gpio_ll 和 esp_timer_start_once()
+void IRAM_ATTR ButtonEngine::onEdge()
+{
+    bool low = gpio_ll_get_level(&GPIO, (gpio_num_t)buttonPin) == 0;
+    gpio_ll_wakeup_enable(&GPIO, (gpio_num_t)buttonPin, low ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+
+    uint32_t now = timerNowUs();
+    uint32_t count = edgeCount.load(std::memory_order_relaxed);
+    if (count == settledCount.load(std::memory_order_acquire))
+    {
+        burstStartUs.store(now, std::memory_order_relaxed); // 一组抖动的第一个边沿即按下/松开的时刻
+    }
+    lastEdgeUs.store(now, std::memory_order_relaxed);
+    edgeCount.store(count + 1, std::memory_order_release);
+
+    if (!esp_timer_is_active(debounceTimer))
+    {
+        esp_timer_start_once(debounceTimer, DEBOUNCE_US);
+    }
+}
+
+// 最后一个边沿之后保持 DEBOUNCE_US 不变才采样电平，否则顺延到静默期结束
+void ButtonEngine::onDebounceTimer(void *)
+{
+    uint32_t count = edgeCount.load(std::memory_order_acquire);
+    uint32_t quietUs = timerNowUs() - lastEdgeUs.load(std::memory_order_relaxed);
+    if (quietUs < DEBOUNCE_US)
+    {
+        esp_timer_start_once(debounceTimer, DEBOUNCE_US - quietUs); // 中断已重新启动时返回错误，忽略
+        return;
+    }
+
+    uint32_t edgeUs = burstStartUs.load(std::memory_order_relaxed);
+    settledCount.store(count, std::memory_order_release);
+
+    bool level = digitalRead(buttonPin) == LOW;
+    if (level == stablePressed)
+    {
+        counters.glitches++;
+        return;
+    }
+    stablePressed = level;
+    counters.transitions++;
+
+    if (level)
+    {
+        onPress(edgeUs);
+    }
+    else
+    {
+        onRelease(edgeUs);
+    }
+}
+
+void ButtonEngine::onPress(uint32_t edgeUs)
+{
+    pressUs = edgeUs;
+    holdLevel = 0;
+    // 取代等待下一次单击的定时器，已累计的单击次数保留
+    armGestureTimer(edgeUs + HOLD_LEVELS_MS[0] * 1000);
+}
+
+void ButtonEngine::onRelease(uint32_t edgeUs)
+{
+    releaseUs = edgeUs;
+    uint32_t heldUs = edgeUs - pressUs;
+
+    if (holdLevel > 0 || heldUs >= SHORT_PRESS_MAX_MS * 1000)
+    {
+        // 长按已在按住期间产生事件；介于短按和长按之间的按压放弃整个手势
+        clicks = 0;
+        esp_timer_stop(gestureTimer);
+        return;
+    }
+
+    clicks++;
+    if (clicks >= MAX_CLICKS)
+    {
+        clicks = 0;
+        esp_timer_stop(gestureTimer);
+        emit(Gesture::TRIPLE_CLICK, edgeUs);
+        return;
+    }
+    armGestureTimer(edgeUs + MULTI_CLICK_GAP_MS * 1000);
+}
+
+// 按住时到达下一级长按阈值；松开时等待下一次单击超时
+void ButtonEngine::onGestureTimer(void *)
+{
+    if (stablePressed)
+    {
+        if (holdLevel >= HOLD_LEVEL_COUNT)
+        {
+            return;
+        }
+        clicks = 0; // 双击后接长按按长按处理
+        emit((Gesture)((int)Gesture::LONG_PRESS + holdLevel), pressUs + HOLD_LEVELS_MS[holdLevel] * 1000);
+        holdLevel++;
+        if (holdLevel < HOLD_LEVEL_COUNT)
+        {
+            armGestureTimer(pressUs + HOLD_LEVELS_MS[holdLevel] * 1000);
+        }
+    }
+    else if (clicks > 0)
+    {
+        Gesture gesture = clicks == 1 ? Gesture::SHORT_PRESS : Gesture::DOUBLE_CLICK;
+        clicks = 0;
+        emit(gesture, releaseUs + MULTI_CLICK_GAP_MS * 1000);
+    }
+}
+
+// 按绝对时间启动手势定时器，已过期时立即触发
+void ButtonEngine::armGestureTimer(uint32_t deadlineUs)
+{
+    int32_t waitUs = (int32_t)(deadlineUs - timerNowUs());
+    esp_timer_stop(gestureTimer);
+    esp_timer_start_once(gestureTimer, waitUs > 0 ? (uint64_t)waitUs : 0);
+}
+
+void ButtonEngine::emit(Gesture gesture, uint32_t originUs)
+{
+    counters.gestures[(int)gesture]++;
+    LOG_DEBUG("按键手势: %s", name(gesture));
+    if (eventSink)
+    {
+        Event event = {gesture, originUs};
+        eventSink(event, sinkContext);
+    }
+}
+
+bool ButtonEngine::pressed()
+{
+    return stablePressed;
+}
+
+ButtonEngine::Stats ButtonEngine::stats()
+{
+    Stats result = counters;
+    result.edges = edgeCount.load(std::memory_order_relaxed) - edgeBase;
+    return result;
+}
+
+void ButtonEngine::resetStats()
+{
+    counters = Stats();
+    // 边沿计数同时用于判断一组抖动的开始，不清零，只记录基准
+    edgeBase = edgeCount.load(std::memory_order_relaxed);
+}
+
+const char *ButtonEngine::name(Gesture gesture)
+{
+    return (int)gesture < (int)Gesture::COUNT ? GESTURE_NAMES[(int)gesture] : "?";
+}
@@ -0,0 +1,94 @@
+#include "conn_params.h"
+#include "logger.h"
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+extern NimBLEServer *pServer;
+
+ConnParams::Settings ConnParams::profileSettings[(int)ConnParams::Profile::COUNT] = {
+    {0, 0, 0, 0},       // CENTRAL_DEFAULT：不请求
+    {6, 12, 0, 400},    // LATENCY：7.5~15ms，无从机延迟，4s 超时
+    {80, 100, 4, 600},  // ECONOMY：100~125ms，从机延迟 4，6s 超时
+};
+ConnParams::Diagnostics ConnParams::diag = {ConnParams::Profile::CENTRAL_DEFAULT, 0, 0, 0, 0, 0, 0};
+bool ConnParams::connected = false;
+uint16_t ConnParams::connHandle = 0;
+std::atomic<uint32_t> ConnParams::currentIntervalUs(0);
+
+void ConnParams::request(Profile profile)
+{
+    diag.profile = profile;
+    if (connected)
+    {
+        apply();
+    }
+}
+
+void ConnParams::onConnected(const NimBLEConnInfo &connInfo)
+{
+    connected = true;
+    connHandle = connInfo.getConnHandle();
+    record(connInfo);
+    apply();
+}
+
+void ConnParams::onDisconnected()
+{
+    connected = false;
+    diag.profile = Profile::CENTRAL_DEFAULT; // 重新连接后由状态机重新选择
+    diag.interval = 0;
+    diag.latency = 0;
+    diag.timeout = 0;
+    currentIntervalUs.store(0, std::memory_order_relaxed);
+}
+
+void ConnParams::onParamsUpdated(const NimBLEConnInfo &connInfo)
+{
+    diag.updates++;
+    record(connInfo);
+    LOG_INFO("连接参数已更新：间隔 %.2fms，从机延迟 %u，超时 %ums", connInfo.getConnInterval() * 1.25f,
+             connInfo.getConnLatency(), connInfo.getConnTimeout() * 10);
+}
+
+void ConnParams::setSettings(Profile profile, const Settings &settings)
+{
+    profileSettings[(int)profile] = settings;
+}
+
+const ConnParams::Settings &ConnParams::settings(Profile profile)
+{
+    return profileSettings[(int)profile];
+}
+
+const ConnParams::Diagnostics &ConnParams::diagnostics()
+{
+    return diag;
+}
+
+void ConnParams::apply()
+{
+    if (diag.profile == Profile::CENTRAL_DEFAULT || !pServer)
+    {
+        return;
+    }
+    const Settings &s = profileSettings[(int)diag.profile];
+    // 当前参数已在目标范围内时不重复请求
+    if (diag.interval >= s.minInterval && diag.interval <= s.maxInterval && diag.latency == s.latency)
+    {
+        return;
+    }
+    diag.requests++;
+    if (!pServer->updateConnParams(connHandle, s.minInterval, s.maxInterval, s.latency, s.timeout))
+    {
+        diag.failures++;
+        LOG_WARN("连接参数更新请求失败");
+    }
+}
+
+void ConnParams::record(const NimBLEConnInfo &connInfo)
+{
+    diag.interval = connInfo.getConnInterval();
+    diag.latency = connInfo.getConnLatency();
+    diag.timeout = connInfo.getConnTimeout();
+    currentIntervalUs.store(diag.interval * 1250u, std::memory_order_relaxed);
+}
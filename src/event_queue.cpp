@@ -0,0 +1,172 @@
+#include "event_queue.h"
+#include "mpsc_ring.h"
+#include "state_machine.h"
+
+static MpscRing<EventQueue::Entry, EventQueue::QUEUE_SIZE> ring;
+static std::atomic<TaskHandle_t> consumer(nullptr);
+static std::atomic<uint32_t> postedCount(0);
+static std::atomic<uint32_t> droppedCount(0);
+static EventQueue::Stats counters;   // 其余字段仅消费者访问
+static bool dispatching = false;
+static uint32_t dispatchingOrigin = 0;
+
+static const char *const EVENT_NAMES[] = {
+    "BootButtonShortPress",
+    "BootButtonDoubleClick",
+    "BootButtonTripleClick",
+    "BootButtonLongPress",
+    "BootButtonVeryLongPress",
+    "DeviceConnected",
+    "DeviceDisconnected",
+    "ConnectionTimeout",
+    "PairingTimeout",
+    "ConnectionFailed",
+    "InitComplete",
+    "RestoreMouseMotionState",
+    "AdvertisingStageTimeout",
+    "AdvertisingRetry",
+};
+
+bool EventQueue::post(EventId id)
+{
+    return post(id, micros());
+}
+
+bool EventQueue::post(EventId id, uint32_t originUs)
+{
+    Entry entry = {id, originUs};
+    if (!ring.push(entry))
+    {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    postedCount.fetch_add(1, std::memory_order_relaxed);
+
+    TaskHandle_t task = consumer.load(std::memory_order_acquire);
+    if (task)
+    {
+        xTaskNotifyGive(task);
+    }
+    return true;
+}
+
+void EventQueue::setConsumer(TaskHandle_t task)
+{
+    consumer.store(task, std::memory_order_release);
+}
+
+uint32_t EventQueue::dispatchAll()
+{
+    uint32_t depth = ring.size();
+    if (depth > counters.maxDepth)
+    {
+        counters.maxDepth = depth;
+    }
+
+    uint32_t count = 0;
+    Entry entry;
+    while (ring.pop(entry))
+    {
+        dispatching = true;
+        dispatchingOrigin = entry.originUs;
+        dispatch(entry);
+        dispatching = false;
+
+        uint32_t latencyUs = micros() - entry.originUs;
+        EventStats &event = counters.events[(int)entry.id];
+        event.dispatched++;
+        if (latencyUs > event.maxLatencyUs)
+        {
+            event.maxLatencyUs = latencyUs;
+        }
+        if (latencyUs > counters.maxLatencyUs)
+        {
+            counters.maxLatencyUs = latencyUs;
+        }
+        counters.totalLatencyUs += latencyUs;
+        counters.dispatched++;
+        count++;
+    }
+    return count;
+}
+
+void EventQueue::dispatch(const Entry &entry)
+{
+    switch (entry.id)
+    {
+    case EventId::BOOT_SHORT_PRESS:
+        BleMouseState::dispatch(BootButtonShortPress());
+        break;
+    case EventId::BOOT_DOUBLE_CLICK:
+        BleMouseState::dispatch(BootButtonDoubleClick());
+        break;
+    case EventId::BOOT_TRIPLE_CLICK:
+        BleMouseState::dispatch(BootButtonTripleClick());
+        break;
+    case EventId::BOOT_LONG_PRESS:
+        BleMouseState::dispatch(BootButtonLongPress());
+        break;
+    case EventId::BOOT_VERY_LONG_PRESS:
+        BleMouseState::dispatch(BootButtonVeryLongPress());
+        break;
+    case EventId::DEVICE_CONNECTED:
+        BleMouseState::dispatch(DeviceConnected());
+        break;
+    case EventId::DEVICE_DISCONNECTED:
+        BleMouseState::dispatch(DeviceDisconnected());
+        break;
+    case EventId::CONNECTION_TIMEOUT:
+        BleMouseState::dispatch(ConnectionTimeout());
+        break;
+    case EventId::PAIRING_TIMEOUT:
+        BleMouseState::dispatch(PairingTimeout());
+        break;
+    case EventId::CONNECTION_FAILED:
+        BleMouseState::dispatch(ConnectionFailed());
+        break;
+    case EventId::INIT_COMPLETE:
+        BleMouseState::dispatch(InitComplete());
+        break;
+    case EventId::RESTORE_MOUSE_MOTION_STATE:
+        BleMouseState::dispatch(RestoreMouseMotionState());
+        break;
+    case EventId::ADVERTISING_STAGE_TIMEOUT:
+        BleMouseState::dispatch(AdvertisingStageTimeout());
+        break;
+    case EventId::ADVERTISING_RETRY:
+        BleMouseState::dispatch(AdvertisingRetry());
+        break;
+    default:
+        break;
+    }
+}
+
+uint32_t EventQueue::dispatchingOriginUs()
+{
+    return dispatching ? dispatchingOrigin : micros();
+}
+
+void EventQueue::clear()
+{
+    ring.clear();
+}
+
+EventQueue::Stats EventQueue::stats()
+{
+    Stats result = counters;
+    result.posted = postedCount.load(std::memory_order_relaxed);
+    result.dropped = droppedCount.load(std::memory_order_relaxed);
+    return result;
+}
+
+void EventQueue::resetStats()
+{
+    counters = Stats();
+    postedCount = 0;
+    droppedCount = 0;
+}
+
+const char *EventQueue::name(EventId id)
+{
+    return (int)id < (int)EventId::COUNT ? EVENT_NAMES[(int)id] : "?";
+}
@@ -1,130 +1,178 @@
 #include "led_controller.h"
+#include "power_manager.h"
+#include <driver/ledc.h>
+
+// LEDC 配置：两颗 LED 共用一个 5kHz、10 位分辨率的定时器
+static const ledc_mode_t LED_SPEED_MODE = LEDC_LOW_SPEED_MODE;
+static const ledc_timer_t LED_TIMER = LEDC_TIMER_0;
+static const ledc_channel_t LED_D4_CHANNEL = LEDC_CHANNEL_0;
+static const ledc_channel_t LED_D5_CHANNEL = LEDC_CHANNEL_1;
+static const uint32_t LED_PWM_FREQUENCY = 5000;
+
+typedef LEDController::Step Step;
+typedef LEDController::Pattern Pattern;
+
+template <size_t N>
+static constexpr Pattern makePattern(const Step (&steps)[N]) {
+    return Pattern{steps, (uint8_t)N};
+}
+
+// 图案表：{D4 亮度, D5 亮度, 持续时间 ms, 是否渐变}
+static const Step OFF_STEPS[] = {{0, 0, 0, false}};
+static const Step ON_STEPS[] = {{255, 255, 0, false}};
+static const Step SLOW_BLINK_STEPS[] = {
+    {0, 0, 1000, false},
+    {255, 255, 1000, false}
+};
+static const Step FAST_BLINK_STEPS[] = {
+    {0, 0, 333, false},
+    {255, 255, 333, false}
+};
+static const Step ALTERNATE_STEPS[] = {
+    {255, 0, 250, false},
+    {0, 255, 250, false}
+};
+static const Step HEARTBEAT_STEPS[] = {
+    {255, 255, 120, true},
+    {0, 0, 120, true},
+    {255, 255, 120, true},
+    {0, 0, 240, true},
+    {0, 0, 900, false}
+};
+
+// 按 Mode 的顺序排列，CUSTOM 的步骤在 customSteps 中
+static const Pattern PATTERNS[(int)LEDController::Mode::CUSTOM] = {
+    makePattern(OFF_STEPS),
+    makePattern(ON_STEPS),
+    makePattern(SLOW_BLINK_STEPS),
+    makePattern(FAST_BLINK_STEPS),
+    makePattern(ALTERNATE_STEPS),
+    makePattern(HEARTBEAT_STEPS)
+};
 
 // 静态成员变量定义
 bool LEDController::initialized = false;
-unsigned long LEDController::lastBlinkTime = 0;
-bool LEDController::ledState = false;
 LEDController::Mode LEDController::currentMode = LEDController::Mode::OFF;
-unsigned long LEDController::blinkInterval = 1000;
-bool LEDController::d4State = false;
-bool LEDController::d5State = false;
+LEDController::Pattern LEDController::currentPattern = {OFF_STEPS, 1};
+uint8_t LEDController::stepIndex = 0;
+int64_t LEDController::stepDeadlineUs = 0;
+esp_timer_handle_t LEDController::stepTimer = nullptr;
+LEDController::Step LEDController::customSteps[2];
+LEDController::Pattern LEDController::customPattern = {LEDController::customSteps, 1};
+
+// 8 位亮度扩展为 10 位占空比
+static uint32_t toDuty(uint8_t brightness) {
+    return ((uint32_t)brightness << 2) | (brightness >> 6);
+}
+
+static void configureChannel(ledc_channel_t channel, int pin) {
+    ledc_channel_config_t config = {};
+    config.gpio_num = pin;
+    config.speed_mode = LED_SPEED_MODE;
+    config.channel = channel;
+    config.intr_type = LEDC_INTR_DISABLE;
+    config.timer_sel = LED_TIMER;
+    config.duty = 0;
+    config.hpoint = 0;
+    ledc_channel_config(&config);
+}
+
+static void setChannel(ledc_channel_t channel, uint8_t brightness, uint16_t fadeMs) {
+    if (fadeMs) {
+        // 渐变由 LEDC 硬件完成，不占用 CPU
+        ledc_set_fade_with_time(LED_SPEED_MODE, channel, toDuty(brightness), fadeMs);
+        ledc_fade_start(LED_SPEED_MODE, channel, LEDC_FADE_NO_WAIT);
+    } else {
+        ledc_set_duty(LED_SPEED_MODE, channel, toDuty(brightness));
+        ledc_update_duty(LED_SPEED_MODE, channel);
+    }
+}
 
 void LEDController::init() {
     if (!initialized) {
-        pinMode(LED_D4_PIN, OUTPUT);
-        pinMode(LED_D5_PIN, OUTPUT);
-        digitalWrite(LED_D4_PIN, LOW);
-        digitalWrite(LED_D5_PIN, LOW);
+        ledc_timer_config_t timerConfig = {};
+        timerConfig.speed_mode = LED_SPEED_MODE;
+        timerConfig.duty_resolution = LEDC_TIMER_10_BIT;
+        timerConfig.timer_num = LED_TIMER;
+        timerConfig.freq_hz = LED_PWM_FREQUENCY;
+        // RTC8M 时钟在浅睡眠期间继续运行（PowerManager 保持其供电），PWM 和渐变不中断
+        timerConfig.clk_cfg = LEDC_USE_RTC8M_CLK;
+        ledc_timer_config(&timerConfig);
+
+        configureChannel(LED_D4_CHANNEL, LED_D4_PIN);
+        configureChannel(LED_D5_CHANNEL, LED_D5_PIN);
+        ledc_fade_func_install(0);
+
+        esp_timer_create_args_t timerArgs = {};
+        timerArgs.callback = onStepTimer;
+        timerArgs.dispatch_method = ESP_TIMER_TASK;
+        timerArgs.name = "led";
+        esp_timer_create(&timerArgs, &stepTimer);
+
         initialized = true;
         currentMode = Mode::OFF;
-        d4State = false;
-        d5State = false;
+        currentPattern = PATTERNS[(int)Mode::OFF];
     }
 }
 
-void LEDController::setState(bool d4, bool d5) {
-    d4State = d4;
-    d5State = d5;
-    digitalWrite(LED_D4_PIN, d4 ? HIGH : LOW);
-    digitalWrite(LED_D5_PIN, d5 ? HIGH : LOW);
-    currentMode = Mode::ON; // 当手动设置状态时，暂时脱离自动模式
+void LEDController::applyStep(const Step &step) {
+    uint16_t fadeMs = step.fade ? step.durationMs : 0;
+    setChannel(LED_D4_CHANNEL, step.d4, fadeMs);
+    setChannel(LED_D5_CHANNEL, step.d5, fadeMs);
 }
 
-void LEDController::setMode(Mode mode) {
+// 停止步骤定时器；esp_timer 任务优先级高于所有调用方，停止后不会再有步骤回调并发执行
+void LEDController::stop() {
+    if (!initialized) {
+        init();
+    }
+    esp_timer_stop(stepTimer); // 未运行时返回 ESP_ERR_INVALID_STATE，忽略
+}
+
+// 从第一步开始播放；调用方先 stop()，再改写步骤表（自定义步骤）并播放
+void LEDController::play(Mode mode, const Pattern &pattern) {
     currentMode = mode;
-    
-    // 根据模式设置初始状态
-    switch (mode) {
-        case Mode::OFF:
-            setState(false, false);
-            break;
-        case Mode::ON:
-            setState(true, true);
-            break;
-        case Mode::ALTERNATE:
-            setState(true, false); // 初始D4亮，D5灭
-            lastBlinkTime = millis();
-            blinkInterval = 250; // 交替闪烁间隔
-            break;
-        case Mode::SLOW_BLINK:
-            setState(true, true); // 初始都亮
-            lastBlinkTime = millis();
-            blinkInterval = 1000; // 慢速闪烁间隔
-            break;
-        case Mode::FAST_BLINK:
-            setState(true, true); // 初始都亮
-            lastBlinkTime = millis();
-            blinkInterval = 333; // 快速闪烁间隔
-            break;
-        case Mode::HEARTBEAT:
-            setState(true, true); // 初始都亮
-            lastBlinkTime = millis();
-            blinkInterval = 500; // 心跳间隔
-            break;
+    currentPattern = pattern;
+    stepIndex = 0;
+    applyStep(pattern.steps[0]);
+
+    if (pattern.count > 1) {
+        uint64_t durationUs = pattern.steps[0].durationMs * 1000ull;
+        stepDeadlineUs = esp_timer_get_time() + durationUs;
+        esp_timer_start_once(stepTimer, durationUs);
     }
 }
 
+// 步骤按绝对时间推进：下一步的等待时间扣除本次回调的延迟，误差不会累积
+void LEDController::onStepTimer(void *) {
+    PowerManager::noteWakeup();
+    stepIndex = (stepIndex + 1) % currentPattern.count;
+    const Step &step = currentPattern.steps[stepIndex];
+    applyStep(step);
+
+    stepDeadlineUs += step.durationMs * 1000ll;
+    int64_t waitUs = stepDeadlineUs - esp_timer_get_time();
+    esp_timer_start_once(stepTimer, waitUs > 0 ? (uint64_t)waitUs : 0);
+}
+
+void LEDController::setState(bool d4, bool d5) {
+    stop();
+    customSteps[0] = {(uint8_t)(d4 ? 255 : 0), (uint8_t)(d5 ? 255 : 0), 0, false};
+    customPattern.count = 1;
+    play(Mode::CUSTOM, customPattern); // 当手动设置状态时，暂时脱离自动模式
+}
+
+void LEDController::setMode(Mode mode) {
+    stop();
+    play(mode, pattern(mode));
+}
+
 LEDController::Mode LEDController::getMode() {
     return currentMode;
 }
 
-void LEDController::update() {
-    if (!initialized) {
-        init();
-        return;
-    }
-    
-    unsigned long currentTime = millis();
-    
-    switch (currentMode) {
-        case Mode::OFF:
-        case Mode::ON:
-            // 静态模式，无需更新
-            break;
-            
-        case Mode::SLOW_BLINK:
-            if (currentTime - lastBlinkTime >= blinkInterval) {
-                ledState = !ledState;
-                setState(ledState, ledState);
-                lastBlinkTime = currentTime;
-            }
-            break;
-            
-        case Mode::FAST_BLINK:
-            if (currentTime - lastBlinkTime >= blinkInterval) {
-                ledState = !ledState;
-                setState(ledState, ledState);
-                lastBlinkTime = currentTime;
-            }
-            break;
-            
-        case Mode::ALTERNATE:
-            if (currentTime - lastBlinkTime >= blinkInterval) {
-                ledState = !ledState;
-                setState(ledState, !ledState); // 交替状态
-                lastBlinkTime = currentTime;
-            }
-            break;
-            
-        case Mode::HEARTBEAT:
-            if (currentTime - lastBlinkTime >= blinkInterval) {
-                // 简单的心跳模式：快闪两次
-                static int heartbeatStep = 0;
-                if (heartbeatStep == 0) {
-                    setState(false, false);
-                } else if (heartbeatStep == 1) {
-                    setState(true, true);
-                } else if (heartbeatStep == 2) {
-                    setState(false, false);
-                } else {
-                    setState(true, true);
-                    heartbeatStep = -1; // 重置
-                }
-                heartbeatStep++;
-                lastBlinkTime = currentTime;
-            }
-            break;
-    }
+const LEDController::Pattern &LEDController::pattern(Mode mode) {
+    return mode == Mode::CUSTOM ? customPattern : PATTERNS[(int)mode];
 }
 
 void LEDController::turnOff() {
@@ -136,11 +184,17 @@ void LEDController::turnOn() {
 }
 
 void LEDController::blinkSync(int intervalMs) {
-    blinkInterval = intervalMs;
-    setMode(Mode::SLOW_BLINK);
+    stop();
+    customSteps[0] = {255, 255, (uint16_t)intervalMs, false};
+    customSteps[1] = {0, 0, (uint16_t)intervalMs, false};
+    customPattern.count = 2;
+    play(Mode::CUSTOM, customPattern);
 }
 
 void LEDController::blinkAlternate(int intervalMs) {
-    blinkInterval = intervalMs;
-    setMode(Mode::ALTERNATE);
-}
\ No newline at end of file
+    stop();
+    customSteps[0] = {255, 0, (uint16_t)intervalMs, false};
+    customSteps[1] = {0, 255, (uint16_t)intervalMs, false};
+    customPattern.count = 2;
+    play(Mode::CUSTOM, customPattern);
+}
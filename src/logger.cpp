@@ -0,0 +1,206 @@
+#include "logger.h"
+#include "mpsc_ring.h"
+#include <Arduino.h>
+#include <stdio.h>
+
+static const uint32_t TASK_STACK_SIZE = 3072;
+static const size_t LINE_SIZE = 192;
+
+static MpscRing<Logger::Record, Logger::RING_SIZE> ring;
+static std::atomic<uint32_t> writtenCount(0);
+static std::atomic<uint32_t> droppedCount(0);
+static uint32_t drainedCount = 0;
+static uint32_t maxDepth = 0;
+static uint32_t reportedDropped = 0;   // 已在串口上报过的丢弃数（仅日志任务访问）
+
+static const char LEVEL_TAGS[] = {'?', 'E', 'W', 'I', 'D'};
+
+void Logger::start()
+{
+    xTaskCreate(drainTask, "log", TASK_STACK_SIZE, nullptr, TASK_PRIORITY, nullptr);
+}
+
+void Logger::push(Level level, const char *format, const Arg *args, uint8_t count)
+{
+    Record record;
+    record.timestampMs = millis();
+    record.format = format;
+    record.level = level;
+    record.argCount = count;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        record.args[i] = args[i];
+    }
+
+    if (ring.push(record))
+    {
+        writtenCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::drainTask(void *)
+{
+    for (;;)
+    {
+        drain();
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_PERIOD_MS));
+    }
+}
+
+uint32_t Logger::drain()
+{
+    uint32_t depth = ring.size();
+    if (depth > maxDepth)
+    {
+        maxDepth = depth;
+    }
+
+    char line[LINE_SIZE];
+    uint32_t count = 0;
+    Record record;
+    while (ring.pop(record))
+    {
+        format(record, line, sizeof(line));
+        Serial.println(line);
+        count++;
+    }
+    drainedCount += count;
+
+    // 丢弃发生在队列满时，等队列腾空后再补一行提示
+    uint32_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped)
+    {
+        snprintf(line, sizeof(line), "[%10lu] W 日志队列已满，丢弃 %lu 条", (unsigned long)millis(),
+                 (unsigned long)(dropped - reportedDropped));
+        Serial.println(line);
+        reportedDropped = dropped;
+    }
+    return count;
+}
+
+// 逐个处理格式说明符：把单个说明符连同参数交给 snprintf，其余字符原样复制
+size_t Logger::format(const Record &record, char *buffer, size_t size)
+{
+    int level = (int)record.level;
+    int length = snprintf(buffer, size, "[%10lu] %c ", (unsigned long)record.timestampMs,
+                          LEVEL_TAGS[level < (int)sizeof(LEVEL_TAGS) ? level : 0]);
+    size_t pos = length < 0 ? 0 : (size_t)length;
+    uint8_t argIndex = 0;
+    const char *p = record.format;
+
+    while (*p && pos + 1 < size)
+    {
+        if (*p != '%')
+        {
+            buffer[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            buffer[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // 复制 "%[标志][宽度][.精度]转换符"，忽略长度修饰符（参数已统一为机器字）
+        char spec[16];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 3)
+        {
+            spec[specLength++] = *p++;
+        }
+        while (*p && strchr("hlzjt", *p))
+        {
+            p++;
+        }
+        char conversion = *p;
+        if (!conversion)
+        {
+            break;
+        }
+        p++;
+
+        Arg arg = argIndex < record.argCount ? record.args[argIndex] : 0;
+        argIndex++;
+        int written;
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(buffer + pos, size - pos, spec, (long)(intptr_t)arg);
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(buffer + pos, size - pos, spec, (unsigned long)arg);
+            break;
+        case 'c':
+            spec[specLength++] = 'c';
+            spec[specLength] = '\0';
+            written = snprintf(buffer + pos, size - pos, spec, (int)arg);
+            break;
+        case 'f':
+        case 'e':
+        case 'g':
+        {
+            uint32_t bits = (uint32_t)arg;
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(buffer + pos, size - pos, spec, (double)value);
+            break;
+        }
+        case 's':
+            spec[specLength++] = 's';
+            spec[specLength] = '\0';
+            written = snprintf(buffer + pos, size - pos, spec, arg ? (const char *)arg : "(null)");
+            break;
+        default:
+            written = snprintf(buffer + pos, size - pos, "%%%c", conversion);
+            break;
+        }
+
+        if (written > 0)
+        {
+            pos += (size_t)written;
+        }
+    }
+
+    if (pos >= size)
+    {
+        pos = size - 1; // 截断
+    }
+    buffer[pos] = '\0';
+    return pos;
+}
+
+Logger::Stats Logger::stats()
+{
+    Stats result;
+    result.written = writtenCount.load(std::memory_order_relaxed);
+    result.dropped = droppedCount.load(std::memory_order_relaxed);
+    result.drained = drainedCount;
+    result.maxDepth = maxDepth;
+    return result;
+}
+
+void Logger::resetStats()
+{
+    writtenCount = 0;
+    droppedCount = 0;
+    drainedCount = 0;
+    maxDepth = 0;
+    reportedDropped = 0;
+}
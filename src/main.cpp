@@ -6,9 +6,13 @@
 #include <NimBLEHIDDevice.h>
 #include "state_machine.h"
 #include "../include/led_controller.h"
-
-// 按键引脚定义
-#define BOOT_BUTTON_PIN 9 // BOOT 按键，低电平有效
+#include "../include/app_tasks.h"
+#include "../include/conn_params.h"
+#include "../include/logger.h"
+#include "../include/event_queue.h"
+#include "../include/advertising_controller.h"
+#include "../include/power_manager.h"
+#include "../include/settings_store.h"
 
 // HID 报告描述符 - 鼠标（包含滚轮和中键声明但不使用）
 static const uint8_t hid_report_descriptor[] = {
@@ -46,81 +50,65 @@ NimBLEServer *pServer = nullptr;
 NimBLEHIDDevice *hid = nullptr;
 NimBLECharacteristic *inputMouse = nullptr;
 bool deviceConnected = false;
-unsigned long buttonPressStartTime = 0;
-
-// 鼠标移动状态变量 - 模拟人类自然移动
-float currentVelocityX = 0.0;
-float currentVelocityY = 0.0;
-float targetVelocityX = 0.0;
-float targetVelocityY = 0.0;
-float moveAngle = 0.0;
-float moveRadius = 0.0;
-unsigned long lastMoveUpdate = 0;
-unsigned long patternChangeTimer = 0;
-unsigned int patternChangeInterval = 3000; // 每3秒改变移动模式
-int currentPattern = 0;                    // 0=随机漫步, 1=圆形轨迹, 2=8字形轨迹
-
-// 移动和停顿控制
-bool isMoving = false;
-unsigned long movePhaseTimer = 0;
-unsigned long pausePhaseTimer = 0;
-unsigned int moveDuration = 0; // 移动持续时间，随机设置
-unsigned int pauseDuration = 0; // 停顿持续时间，随机设置
-bool inMovePhase = true; // true=移动阶段, false=停顿阶段
-
-// 安卓拖动问题修复
-bool lastWasMoving = false;
-unsigned long lastReleaseReportTime = 0;
-const unsigned long RELEASE_REPORT_INTERVAL = 100; // 每100ms发送一次释放报告
-
-// LED 控制变量
-unsigned long lastBlinkTime = 0;
-bool ledState = false;
-int blinkCount = 0;
-
-// 鼠标运动状态记忆
-bool rememberedMouseMotionState = false; // false=禁用, true=启用
 
 // 回调类：连接状态改变
+// 回调在 NimBLE 主机任务中执行，只更新标志并投递事件，状态机由后台任务分发
 class ServerCallbacks : public NimBLEServerCallbacks
 {
-    void onConnect(NimBLEServer *pServer)
+    void onConnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo) override
     {
         deviceConnected = true;
-        Serial.println("BLE设备已连接");
-        Serial.println("客户端数量: " + String(pServer->getConnectedCount()));
-        Serial.println("尝试发送DeviceConnected事件到状态机");
-        BleMouseState::dispatch(DeviceConnected());
-        Serial.println("DeviceConnected事件已发送");
+        LOG_INFO("BLE设备已连接");
+        LOG_INFO("客户端数量: %d", pServer->getConnectedCount());
+        EventQueue::post(EventQueue::EventId::DEVICE_CONNECTED);
     }
 
-    void onDisconnect(NimBLEServer *pServer)
+    void onDisconnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo, int reason) override
     {
         deviceConnected = false;
-        Serial.println("BLE设备已断开连接");
-        BleMouseState::dispatch(DeviceDisconnected());
-        // 重新开始广播
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        pAdvertising->start();
+        ConnParams::onDisconnected();
+        LOG_INFO("BLE设备已断开连接，原因: 0x%x", reason);
+        // 状态机进入 Reconnect 后由广播控制器重新开始广播
+        EventQueue::post(EventQueue::EventId::DEVICE_DISCONNECTED);
+    }
+
+    void onConnParamsUpdate(NimBLEConnInfo &connInfo) override
+    {
+        ConnParams::onParamsUpdated(connInfo);
+        // 参数更新没有对应的事件；唤醒后台任务，PowerManager 按新的连接间隔重新估算射频占空比
+        AppTasks::wakeHousekeeping();
     }
 };
 
 void setup()
 {
     Serial.begin(115200);
-    Serial.println("启动中...");
+    // 日志任务优先创建：setup() 期间的记录由它在后台输出
+    Logger::start();
+    LOG_INFO("启动中...");
+
+    // 电源管理：空闲时降频和浅睡眠；由低负载时会自动断电的充电宝供电时以 -D POWER_KEEP_AWAKE 构建，始终全速运行
+#ifdef POWER_KEEP_AWAKE
+    PowerManager::setMode(PowerManager::Mode::PERFORMANCE);
+#endif
+    PowerManager::begin();
+
+    // 读取保存的设置（鼠标移动开关、报告速率和运动参数）；没有保存的设置时保持编译期默认值
+    if (SettingsStore::begin())
+    {
+        const SettingsStore::Settings &settings = SettingsStore::settings();
+        AppTasks::setReportRate(settings.reportRate);
+        AppTasks::setMotionConfig(settings.motion);
+    }
 
     // 初始化LED控制器
     LEDController::init();
     LEDController::setMode(LEDController::Mode::OFF);
-    Serial.println("LED控制器已初始化");
-
-    // 初始化随机数生成器
-    randomSeed(analogRead(0) + millis());
-    Serial.println("随机数生成器已初始化");
+    LOG_INFO("LED控制器已初始化");
 
-    // 初始化按键引脚
-    pinMode(BOOT_BUTTON_PIN, INPUT_PULLUP);
+    // 创建任务间队列、清空状态机事件队列并安装按键中断；
+    // 须在 BLE 启动之前完成，广播开始后连接回调随时可能投递事件
+    AppTasks::init();
 
     // 初始化 BLE
     NimBLEDevice::init("Magic Mouse");
@@ -159,283 +147,33 @@ void setup()
     pAdvertising->addServiceUUID(hid->getHidService()->getUUID());
     // 设置广播名称
     pAdvertising->setName("Magic Mouse");
-    pAdvertising->start();
-    Serial.println("广播已启动");
-    Serial.println("当前广播状态：" + String(pAdvertising->isAdvertising() ? "正在广播" : "未广播"));
-    Serial.println("HID服务已启动，设备准备就绪");
+    AdvertisingController::begin(pAdvertising);
+    AdvertisingController::ensure(micros());
+    LOG_INFO("广播已启动");
+    LOG_INFO("当前广播状态：%s", pAdvertising->isAdvertising() ? "正在广播" : "未广播");
+    LOG_INFO("HID服务已启动，设备准备就绪");
 
-    Serial.println("BLE 鼠标服务已启动");
-    Serial.println("服务器回调已设置，等待连接...");
+    LOG_INFO("BLE 鼠标服务已启动");
+    LOG_INFO("服务器回调已设置，等待连接...");
 
     // 初始化状态机
-    Serial.println("启动状态机...");
+    LOG_DEBUG("启动状态机...");
     BleMouseState::start();
-    Serial.println("状态机已启动");
+    LOG_INFO("状态机已启动");
 
-    // 发送初始化完成事件
-    Serial.println("发送初始化完成事件...");
+    // 发送初始化完成事件：任务尚未启动，此处是唯一的分发者，可以直接分发；
+    // 期间回调投递的连接事件留在队列中，进入 Reconnect 后由后台任务处理
+    LOG_DEBUG("发送初始化完成事件...");
     BleMouseState::dispatch(InitComplete());
-    Serial.println("初始化完成事件已发送");
+    LOG_DEBUG("初始化完成事件已发送");
+
+    // 启动运动和后台任务，此后状态机只在后台任务中分发事件
+    AppTasks::start();
+    LOG_INFO("任务已启动");
 }
 
 void loop()
 {
-    // 检查按键状态
-    bool buttonPressed = (digitalRead(BOOT_BUTTON_PIN) == LOW);
-
-    if (buttonPressed)
-    {
-        if (buttonPressStartTime == 0)
-        {
-            // 按键刚按下
-            buttonPressStartTime = millis();
-        }
-        else
-        {
-            // 按键持续按下
-            unsigned long pressDuration = millis() - buttonPressStartTime;
-
-            // 长按 5 秒进入配对模式
-            if (pressDuration >= 3000)
-            {
-                BleMouseState::dispatch(BootButtonLongPress());
-                // 等待按键释放以避免重复触发
-                while (digitalRead(BOOT_BUTTON_PIN) == LOW)
-                {
-                    delay(10);
-                }
-                buttonPressStartTime = 0;
-            }
-        }
-    }
-    else
-    {
-        if (buttonPressStartTime > 0)
-        {
-            // 按键刚释放
-            unsigned long pressDuration = millis() - buttonPressStartTime;
-
-            // 短按切换鼠标移动
-            if (pressDuration < 1000)
-            {
-                BleMouseState::dispatch(BootButtonShortPress());
-            }
-
-            buttonPressStartTime = 0;
-        }
-    }
-
-    // 定期检查连接状态并手动触发状态转换（如果回调未被触发）
-    static unsigned long lastConnectionCheck = 0;
-    if (millis() - lastConnectionCheck > 1000)
-    { // 每秒检查一次
-        int connectedCount = pServer ? pServer->getConnectedCount() : 0;
-        if (connectedCount > 0 && !deviceConnected)
-        {
-            // 检测到连接但状态未更新，手动触发连接事件
-            Serial.println("检测到连接但回调未触发，手动触发DeviceConnected事件");
-            Serial.println("当前连接数: " + String(connectedCount));
-            deviceConnected = true;
-            BleMouseState::dispatch(DeviceConnected());
-        }
-        else if (connectedCount == 0 && deviceConnected)
-        {
-            // 检测到断开连接但状态未更新
-            Serial.println("检测到断开连接，手动触发DeviceDisconnected事件");
-            deviceConnected = false;
-            BleMouseState::dispatch(DeviceDisconnected());
-        }
-        lastConnectionCheck = millis();
-    }
-
-    // 处理配对模式的 LED 闪烁
-    if (BleMouseState::is_in_state<Pairing>())
-    {
-        unsigned long currentTime = millis();
-        // 每秒闪烁 3 次，即每 333ms 闪烁一次
-        if (currentTime - lastBlinkTime >= 333)
-        {
-            ledState = !ledState;
-            digitalWrite(12, ledState ? HIGH : LOW); // LED_D4_PIN
-            digitalWrite(13, ledState ? HIGH : LOW); // LED_D5_PIN
-            lastBlinkTime = currentTime;
-        }
-    }
-
-    // 处理重连状态的 LED 闪烁
-    if (BleMouseState::is_in_state<Reconnect>())
-    {
-        unsigned long currentTime = millis();
-        // 每秒闪烁 1 次，即每 1000ms 闪烁一次
-        if (currentTime - lastBlinkTime >= 1000)
-        {
-            ledState = !ledState;
-            digitalWrite(12, ledState ? HIGH : LOW); // LED_D4_PIN
-            digitalWrite(13, ledState ? HIGH : LOW); // LED_D5_PIN
-            lastBlinkTime = currentTime;
-        }
-    }
-
-    // 处理鼠标移动状态 - 模拟人类自然移动
-    if (BleMouseState::is_in_state<MouseMotionEnable>())
-    {
-        unsigned long currentTime = millis();
-        float deltaTime = (currentTime - lastMoveUpdate) / 1000.0; // 转换为秒
-        lastMoveUpdate = currentTime;
-
-        // 管理移动和停顿周期
-        if (inMovePhase)
-        {
-            // 移动阶段
-            if (currentTime - movePhaseTimer > moveDuration)
-            {
-                // 切换到停顿阶段
-                inMovePhase = false;
-                pausePhaseTimer = currentTime;
-                // 随机设置停顿时间
-                pauseDuration = random(MIN_PAUSE_DURATION, MAX_PAUSE_DURATION);
-                Serial.println("切换到停顿阶段，停顿时长: " + String(pauseDuration) + "ms");
-
-                // 停止移动
-                currentVelocityX = 0.0;
-                currentVelocityY = 0.0;
-                targetVelocityX = 0.0;
-                targetVelocityY = 0.0;
-            }
-        }
-        else
-        {
-            // 停顿阶段
-            if (currentTime - pausePhaseTimer > pauseDuration)
-            {
-                // 切换到移动阶段
-                inMovePhase = true;
-                movePhaseTimer = currentTime;
-                // 随机设置移动时间
-                moveDuration = random(MIN_MOVE_DURATION, MAX_MOVE_DURATION);
-                Serial.println("切换到移动阶段，移动时长: " + String(moveDuration) + "ms");
-
-                // 可能改变移动模式
-                if (random(0, 100) < 30)
-                { // 30%概率改变模式
-                    currentPattern = random(0, 3);
-                    moveRadius = random(5.0, 15.0); // 增大随机移动幅度
-                    Serial.println("改变移动模式: " + String(currentPattern) + ", 幅度: " + String(moveRadius));
-                }
-            }
-        }
-
-        // 只在移动阶段计算和执行移动
-        if (inMovePhase)
-        {
-            // 每隔一段时间改变移动模式
-            if (currentTime - patternChangeTimer > patternChangeInterval)
-            {
-                currentPattern = random(0, 3); // 随机选择移动模式
-                patternChangeTimer = currentTime;
-                moveRadius = random(5.0, 15.0); // 增大随机移动幅度
-                Serial.println("切换到移动模式: " + String(currentPattern) + ", 幅度: " + String(moveRadius));
-            }
-
-            // 根据当前模式计算目标速度
-            float randomSpeed;
-            switch (currentPattern)
-            {
-            case 0:                             // 随机漫步模式
-                moveAngle += random(-0.3, 0.3); // 随机转向
-                randomSpeed = moveRadius * (0.5 + 0.5 * sin(currentTime * 0.001));
-                targetVelocityX = randomSpeed * cos(moveAngle);
-                targetVelocityY = randomSpeed * sin(moveAngle);
-                break;
-
-            case 1:                // 圆形轨迹模式
-                moveAngle += 0.05; // 缓慢旋转
-                targetVelocityX = moveRadius * cos(moveAngle);
-                targetVelocityY = moveRadius * sin(moveAngle);
-                break;
-
-            case 2: // 8字形轨迹模式
-                moveAngle += 0.03;
-                targetVelocityX = moveRadius * sin(moveAngle);
-                targetVelocityY = moveRadius * sin(moveAngle * 2) * 0.5;
-                break;
-            }
-
-            // 添加微小的随机扰动，模拟手部微小抖动
-            targetVelocityX += random(-100, 100) / 1000.0;
-            targetVelocityY += random(-100, 100) / 1000.0;
-
-            // 平滑过渡到目标速度（模拟人体动作的惯性）
-            float smoothFactor = 0.1;
-            currentVelocityX += (targetVelocityX - currentVelocityX) * smoothFactor;
-            currentVelocityY += (targetVelocityY - currentVelocityY) * smoothFactor;
-
-            // 限制最大速度
-            float maxSpeed = 20.0; // 增大最大速度限制
-            float currentSpeed = sqrt(currentVelocityX * currentVelocityX + currentVelocityY * currentVelocityY);
-            if (currentSpeed > maxSpeed)
-            {
-                currentVelocityX = (currentVelocityX / currentSpeed) * maxSpeed;
-                currentVelocityY = (currentVelocityY / currentSpeed) * maxSpeed;
-            }
-        }
-        else
-        {
-            // 停顿阶段，逐渐减速到0
-            currentVelocityX *= 0.9;
-            currentVelocityY *= 0.9;
-            targetVelocityX = 0.0;
-            targetVelocityY = 0.0;
-        }
-
-        // 转换为整数移动值
-        int8_t moveX = (int8_t)constrain(currentVelocityX, -127, 127);
-        int8_t moveY = (int8_t)constrain(currentVelocityY, -127, 127);
-
-        // 始终发送鼠标报告，确保状态正确（避免安卓拖动问题）
-        uint8_t buttons = 0;                                                   // 明确设置无点击状态（包括中键）
-        uint8_t mouseReport[4] = {buttons, (uint8_t)moveX, (uint8_t)moveY, 0}; // 滚轮始终为0
-
-        // 检测是否从移动状态变为静止状态
-        bool currentlyMoving = (abs(moveX) > 0 || abs(moveY) > 0);
-        if (lastWasMoving && !currentlyMoving) {
-            // 刚停止移动，立即发送释放报告
-            uint8_t releaseReport[4] = {0, 0, 0, 0}; // 完全释放状态
-            if (inputMouse && deviceConnected) {
-                inputMouse->setValue(releaseReport, sizeof(releaseReport));
-                inputMouse->notify();
-                lastReleaseReportTime = currentTime;
-            }
-        }
-        
-        // 在停顿阶段定期发送释放报告（安卓兼容性）
-        if (!currentlyMoving && (currentTime - lastReleaseReportTime > RELEASE_REPORT_INTERVAL)) {
-            uint8_t releaseReport[4] = {0, 0, 0, 0}; // 完全释放状态
-            if (inputMouse && deviceConnected) {
-                inputMouse->setValue(releaseReport, sizeof(releaseReport));
-                inputMouse->notify();
-                lastReleaseReportTime = currentTime;
-            }
-        }
-        
-        // 正常发送移动报告
-        if (inputMouse && deviceConnected)
-        {
-            inputMouse->setValue(mouseReport, sizeof(mouseReport));
-            inputMouse->notify();
-        }
-        
-        lastWasMoving = currentlyMoving;
-
-        // LED D4、D5 交替闪烁，每秒2次
-        if (currentTime - lastBlinkTime >= 250)
-        { // 每250ms切换一次
-            ledState = !ledState;
-            digitalWrite(12, ledState ? HIGH : LOW); // LED_D4_PIN
-            digitalWrite(13, ledState ? LOW : HIGH); // LED_D5_PIN
-            lastBlinkTime = currentTime;
-        }
-    }
-
-    delay(10);
-}
\ No newline at end of file
+    // 所有工作都在 AppTasks 创建的任务中完成，删除 Arduino 的 loop 任务
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,248 @@
+#include "motion_engine.h"
+#include "fixed_point.h"
+#include <Arduino.h>
+
+using namespace fixed;
+
+// 微秒换算为 Q24 秒：dtUs × 2^24 / 10^6 ≈ dtUs × 1099512 >> 16
+static int32_t microsToQ24Seconds(uint32_t dtUs)
+{
+    return (int32_t)(((uint64_t)dtUs * 1099512u) >> 16);
+}
+
+// 以 rate（Q16，1/秒）指数趋近经过 dt 秒后剩余的比例 e^(-rate·dt)，Q15
+static int16_t decayOver(int32_t rateQ16, int32_t dtQ24)
+{
+    return expNegQ15((int32_t)(((int64_t)rateQ16 * dtQ24) >> DT_SHIFT));
+}
+
+// 位移积分：速度 × 时间累加到余数，取出整数部分，小数部分留到下一次
+static int8_t integrate(int32_t velocity, int32_t dtQ24, int32_t &residual)
+{
+    residual += (int32_t)(((int64_t)velocity * dtQ24) >> DT_SHIFT);
+    int32_t counts = truncQ16(residual);
+    if (counts > 127 || counts < -127)
+    {
+        // 超出单份报告范围的部分直接丢弃，只保留小数部分
+        counts = constrain(counts, -127, 127);
+        residual -= truncQ16(residual) * Q16_ONE;
+        return (int8_t)counts;
+    }
+    residual -= counts * Q16_ONE;
+    return (int8_t)counts;
+}
+
+MotionEngine::MotionEngine() : MotionEngine(Config()) {}
+
+MotionEngine::MotionEngine(const Config &config) : stepIntervalUs(10000)
+{
+    tremor.seed(Prng::DEFAULT_SEED);
+    setConfig(config);
+    reset(0);
+}
+
+void MotionEngine::setConfig(const Config &config)
+{
+    cfg = config;
+    maxSpeedQ4 = (int32_t)(config.maxSpeed * 16.0f);
+    smoothRateQ16 = toQ16(config.smoothRate);
+    pauseDecayRateQ16 = toQ16(config.pauseDecayRate);
+    tremor.setConfig(config.tremor);
+}
+
+void MotionEngine::reset(uint32_t nowUs)
+{
+    s.velocityX = 0;
+    s.velocityY = 0;
+    s.targetVelocityX = 0;
+    s.targetVelocityY = 0;
+    s.angle = 0;
+    s.radius = 1000 * Q16_ONE; // 初始移动幅度（计数/秒）
+    s.residualX = 0;
+    s.residualY = 0;
+    s.lastStepUs = nowUs;
+    s.patternChangeUs = nowUs;
+    s.phaseStartUs = nowUs;
+    patternIndex = 0;
+    s.pattern = registry.id(0);
+    s.inMovePhase = true; // 从移动阶段开始
+    s.moveDurationMs = rng.range(cfg.minMoveMs, cfg.maxMoveMs);    // 随机移动时间
+    s.pauseDurationMs = rng.range(cfg.minPauseMs, cfg.maxPauseMs); // 随机停顿时间
+    segments.reset();
+    tremor.reset();
+    s.source = pickSource();
+    nextSource = s.source;
+    if (s.source == Source::PLANNER)
+    {
+        planSegment();
+    }
+    else
+    {
+        registry.begin(0, rng);
+    }
+}
+
+// 按权重抽取下一段移动的来源：规划器占 plannerWeight，模式策略占各模式权重之和；
+// 只有一种来源可选时不消耗随机数，只用模式或只用规划器时的随机序列与单独运行时相同
+MotionEngine::Source MotionEngine::pickSource()
+{
+    uint32_t patternWeight = registry.totalWeight();
+    if (cfg.plannerWeight == 0)
+    {
+        return Source::PATTERN;
+    }
+    if (patternWeight == 0)
+    {
+        return Source::PLANNER;
+    }
+    return rng.below(cfg.plannerWeight + patternWeight) < cfg.plannerWeight ? Source::PLANNER : Source::PATTERN;
+}
+
+// 规划 moveDurationMs 的一段移动，峰值速度记为幅度
+void MotionEngine::planSegment()
+{
+    s.radius = segments.plan(rng, s.moveDurationMs, stepIntervalUs, (int32_t)cfg.maxSpeed) * Q16_ONE;
+}
+
+MotionEngine::Report MotionEngine::step(uint32_t nowUs)
+{
+    Report report = {0, 0, EVENT_NONE};
+    uint32_t dtUs = nowUs - s.lastStepUs;
+    if (dtUs > MAX_STEP_US)
+    {
+        dtUs = MAX_STEP_US;
+    }
+    int32_t dtQ24 = microsToQ24Seconds(dtUs);
+    s.lastStepUs = nowUs;
+
+    // 管理移动和停顿周期
+    uint32_t phaseElapsedMs = (nowUs - s.phaseStartUs) / 1000;
+    if (s.inMovePhase)
+    {
+        if (phaseElapsedMs > s.moveDurationMs)
+        {
+            // 切换到停顿阶段，随机设置停顿时间并停止移动
+            s.inMovePhase = false;
+            s.phaseStartUs = nowUs;
+            s.pauseDurationMs = rng.range(cfg.minPauseMs, cfg.maxPauseMs);
+            s.velocityX = 0;
+            s.velocityY = 0;
+            s.targetVelocityX = 0;
+            s.targetVelocityY = 0;
+            s.residualX = 0;
+            s.residualY = 0;
+            report.events |= EVENT_PAUSE_STARTED;
+
+            nextSource = pickSource();
+            if (nextSource == Source::PLANNER)
+            {
+                // 停顿期间没有计算负担：此时就规划下一段，移动开始时只需弹出
+                s.moveDurationMs = rng.range(cfg.minMoveMs, cfg.maxMoveMs);
+                planSegment();
+            }
+        }
+    }
+    else
+    {
+        if (phaseElapsedMs > s.pauseDurationMs)
+        {
+            // 切换到移动阶段，随机设置移动时间（规划的一段已在停顿开始时选定）
+            s.inMovePhase = true;
+            s.phaseStartUs = nowUs;
+            report.events |= EVENT_MOVE_STARTED;
+            bool sourceChanged = nextSource != s.source;
+            s.source = nextSource;
+            if (s.source == Source::PLANNER)
+            {
+                report.events |= sourceChanged ? EVENT_PATTERN_CHANGED : EVENT_NONE;
+                return report;
+            }
+            s.moveDurationMs = rng.range(cfg.minMoveMs, cfg.maxMoveMs);
+
+            // 30%概率改变模式；上一段来自规划器时幅度是它的峰值速度，总是重新选择
+            if (sourceChanged || rng.below(100) < 30)
+            {
+                if (sourceChanged)
+                {
+                    s.patternChangeUs = nowUs;   // 规划的一段期间没有计时，从这里重新开始
+                }
+                pickPattern();
+                report.events |= EVENT_PATTERN_CHANGED;
+            }
+        }
+    }
+
+    if (s.inMovePhase && s.source == Source::PLANNER)
+    {
+        // 规划好的位移叠加抖动速度的积分
+        MotionPlanner::Delta delta = segments.pop(dtUs);
+        Tremor::Sample jitter = tremor.step(dtUs);
+        report.dx = (int8_t)constrain(delta.dx + integrate(jitter.x, dtQ24, s.residualX), -127, 127);
+        report.dy = (int8_t)constrain(delta.dy + integrate(jitter.y, dtQ24, s.residualY), -127, 127);
+        return report;
+    }
+
+    if (s.inMovePhase)
+    {
+        // 每隔一段时间改变移动模式
+        if ((nowUs - s.patternChangeUs) / 1000 > cfg.patternChangeIntervalMs)
+        {
+            pickPattern();
+            s.patternChangeUs = nowUs;
+            report.events |= EVENT_PATTERN_CHANGED;
+        }
+
+        computeTargetVelocity(nowUs / 1000, dtQ24);
+
+        // 叠加平滑的抖动速度，模拟手部微小抖动
+        Tremor::Sample jitter = tremor.step(dtUs);
+        s.targetVelocityX += jitter.x;
+        s.targetVelocityY += jitter.y;
+
+        // 平滑过渡到目标速度（模拟人体动作的惯性）：剩余差值按 e^(-rate·dt) 衰减
+        int16_t smoothQ15 = Q15_MAX - decayOver(smoothRateQ16, dtQ24);
+        s.velocityX += mulQ15(s.targetVelocityX - s.velocityX, smoothQ15);
+        s.velocityY += mulQ15(s.targetVelocityY - s.velocityY, smoothQ15);
+
+        // 限制最大速度：在 Q4 精度下比较模长，只有超限时才开方和相除
+        int64_t vx4 = s.velocityX >> 12;
+        int64_t vy4 = s.velocityY >> 12;
+        uint64_t speedSquared = (uint64_t)(vx4 * vx4 + vy4 * vy4);
+        if (speedSquared > (uint64_t)((int64_t)maxSpeedQ4 * maxSpeedQ4))
+        {
+            int32_t speedQ4 = (int32_t)isqrt64(speedSquared);
+            s.velocityX = (int32_t)((int64_t)s.velocityX * maxSpeedQ4 / speedQ4);
+            s.velocityY = (int32_t)((int64_t)s.velocityY * maxSpeedQ4 / speedQ4);
+        }
+    }
+    else
+    {
+        // 停顿阶段，逐渐减速到0
+        int16_t decayQ15 = decayOver(pauseDecayRateQ16, dtQ24);
+        s.velocityX = mulQ15(s.velocityX, decayQ15);
+        s.velocityY = mulQ15(s.velocityY, decayQ15);
+        s.targetVelocityX = 0;
+        s.targetVelocityY = 0;
+    }
+
+    // 按本次时间步长积分为整数移动值
+    report.dx = integrate(s.velocityX, dtQ24, s.residualX);
+    report.dy = integrate(s.velocityY, dtQ24, s.residualY);
+    return report;
+}
+
+void MotionEngine::computeTargetVelocity(uint32_t nowMs, int32_t dtQ24)
+{
+    PatternContext ctx = {s.radius, nowMs, dtQ24, s.angle, rng, 0, 0};
+    registry.step(patternIndex, ctx);
+    s.targetVelocityX = ctx.targetX;
+    s.targetVelocityY = ctx.targetY;
+}
+
+void MotionEngine::pickPattern()
+{
+    patternIndex = (uint8_t)registry.pick(rng);           // 按权重选择移动模式
+    s.pattern = registry.id(patternIndex);
+    s.radius = rng.range(500 * Q16_ONE, 1500 * Q16_ONE); // 随机移动幅度 500~1500 计数/秒
+    registry.begin(patternIndex, rng);
+}
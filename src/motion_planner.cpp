@@ -0,0 +1,170 @@
+#include "motion_planner.h"
+#include "fixed_point.h"
+#include <Arduino.h>
+
+using namespace fixed;
+
+// 控制点偏离连线的最大比例（相对终点距离）
+static const int32_t MAX_BEND_Q15 = toQ15(0.3);
+
+static uint32_t length(int32_t x, int32_t y)
+{
+    return isqrt64((uint64_t)((int64_t)x * x + (int64_t)y * y));
+}
+
+MotionPlanner::MotionPlanner()
+{
+    reset();
+}
+
+void MotionPlanner::reset()
+{
+    clear();
+    current = Segment();
+    entryUs = MIN_PERIOD_US;
+    posX = 0;
+    posY = 0;
+    counters = Stats();
+}
+
+void MotionPlanner::clear()
+{
+    head = 0;
+    count = 0;
+    waitedUs = 0;
+    carryX = 0;
+    carryY = 0;
+}
+
+int32_t MotionPlanner::plan(Prng &rng, uint32_t durationMs, uint32_t periodUs, int32_t maxSpeed)
+{
+    int32_t peak = rng.range(MIN_PEAK_SPEED, MAX_PEAK_SPEED + 1);
+    peak = peak < maxSpeed ? peak : maxSpeed;
+
+    // 直线时峰值速度为 1.875 × 距离 / 时长
+    int32_t distance = (int32_t)((int64_t)peak * durationMs * 8 / 15000);
+    uint16_t angle = (uint16_t)(rng.next() >> 16);
+    int32_t x3 = (int32_t)(((int64_t)distance * cosQ15(angle)) >> 15);
+    int32_t y3 = (int32_t)(((int64_t)distance * sinQ15(angle)) >> 15);
+
+    // 离起点太远时改走反方向
+    int64_t farX = posX + x3, farY = posY + y3;
+    int64_t nearX = posX - x3, nearY = posY - y3;
+    if (farX * farX + farY * farY > (int64_t)HOME_RADIUS * HOME_RADIUS &&
+        nearX * nearX + nearY * nearY < farX * farX + farY * farY)
+    {
+        x3 = -x3;
+        y3 = -y3;
+    }
+
+    // 两个控制点各自沿连线的法向偏移，同侧为弧线、异侧为 S 形
+    int32_t bend1 = rng.range(-MAX_BEND_Q15, MAX_BEND_Q15 + 1);
+    int32_t bend2 = rng.range(-MAX_BEND_Q15, MAX_BEND_Q15 + 1);
+    Segment segment;
+    segment.x1 = x3 / 3 - (int32_t)(((int64_t)y3 * bend1) >> 15);
+    segment.y1 = y3 / 3 + (int32_t)(((int64_t)x3 * bend1) >> 15);
+    segment.x2 = x3 * 2 / 3 - (int32_t)(((int64_t)y3 * bend2) >> 15);
+    segment.y2 = y3 * 2 / 3 + (int32_t)(((int64_t)x3 * bend2) >> 15);
+    segment.x3 = x3;
+    segment.y3 = y3;
+    segment.durationUs = durationMs * 1000;
+    segment.periodUs = periodUs;
+
+    // |B'(s)| 不超过最长控制边的 3 倍，s'(t) 的峰值为 1.875 / 时长：超过 maxSpeed 时整体缩小
+    uint32_t leg = length(segment.x1, segment.y1);
+    uint32_t leg2 = length(segment.x2 - segment.x1, segment.y2 - segment.y1);
+    uint32_t leg3 = length(x3 - segment.x2, y3 - segment.y2);
+    leg = leg > leg2 ? leg : leg2;
+    leg = leg > leg3 ? leg : leg3;
+    int64_t bound = segment.durationUs ? (int64_t)leg * 45 * 1000000 / (8 * (int64_t)segment.durationUs) : 0;
+    if (bound > maxSpeed)
+    {
+        int32_t *points[] = {&segment.x1, &segment.y1, &segment.x2, &segment.y2, &segment.x3, &segment.y3};
+        for (int32_t *point : points)
+        {
+            *point = (int32_t)((int64_t)*point * maxSpeed / bound);
+        }
+        peak = (int32_t)((int64_t)peak * maxSpeed / bound);
+        counters.scaled++;
+    }
+
+    generate(segment);
+    return peak;
+}
+
+void MotionPlanner::generate(const Segment &segment)
+{
+    uint32_t durationUs = segment.durationUs ? segment.durationUs : 1;
+    uint32_t period = segment.periodUs > MIN_PERIOD_US ? segment.periodUs : MIN_PERIOD_US;
+    uint32_t minPeriod = (durationUs + CAPACITY - 1) / CAPACITY;
+    clear();
+    current = segment;
+    entryUs = period > minPeriod ? period : minPeriod;
+    counters.segments++;
+
+    int32_t lastX = 0, lastY = 0;
+    for (uint32_t t = entryUs;; t += entryUs)
+    {
+        uint32_t clamped = t < durationUs ? t : durationUs;
+        // 沿路径的进度按最小加加速度曲线推进
+        int64_t s = smootherStepQ16((int32_t)(((int64_t)clamped << 16) / durationUs));
+        int64_t u = Q16_ONE - s;
+        int64_t s2 = (s * s) >> 16;
+        int64_t w1 = 3 * ((((u * u) >> 16) * s) >> 16);
+        int64_t w2 = 3 * ((u * s2) >> 16);
+        int64_t w3 = (s2 * s) >> 16;
+        int32_t x = (int32_t)((w1 * segment.x1 + w2 * segment.x2 + w3 * segment.x3 + (Q16_ONE / 2)) >> 16);
+        int32_t y = (int32_t)((w1 * segment.y1 + w2 * segment.y2 + w3 * segment.y3 + (Q16_ONE / 2)) >> 16);
+        const Delta &entry = push(x - lastX, y - lastY);
+        lastX += entry.dx;
+        lastY += entry.dy;
+        if (clamped == durationUs || count == CAPACITY)
+        {
+            break;
+        }
+    }
+}
+
+// 超出 int8 的条目截断，差额由下一条目的取整差补上
+const MotionPlanner::Delta &MotionPlanner::push(int32_t dx, int32_t dy)
+{
+    if (dx > 127 || dx < -127 || dy > 127 || dy < -127)
+    {
+        counters.clipped++;
+    }
+    Delta &entry = ring[(head + count) & (CAPACITY - 1)];
+    entry.dx = (int8_t)constrain(dx, -127, 127);
+    entry.dy = (int8_t)constrain(dy, -127, 127);
+    count++;
+    counters.entries++;
+    return entry;
+}
+
+MotionPlanner::Delta MotionPlanner::pop(uint32_t elapsedUs)
+{
+    int32_t sumX = carryX;
+    int32_t sumY = carryY;
+    waitedUs += elapsedUs;
+    while (count && waitedUs >= entryUs)
+    {
+        waitedUs -= entryUs;
+        const Delta &entry = ring[head];
+        sumX += entry.dx;
+        sumY += entry.dy;
+        head = (head + 1) & (CAPACITY - 1);
+        count--;
+    }
+    if (!count)
+    {
+        waitedUs = 0;
+    }
+
+    Delta delta;
+    delta.dx = (int8_t)constrain(sumX, -127, 127);
+    delta.dy = (int8_t)constrain(sumY, -127, 127);
+    carryX = sumX - delta.dx;
+    carryY = sumY - delta.dy;
+    posX += delta.dx;
+    posY += delta.dy;
+    return delta;
+}
@@ -0,0 +1,278 @@
+#include "power_manager.h"
+#include "advertising_controller.h"
+#include "conn_params.h"
+#include "logger.h"
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+static const char *const PHASE_NAMES[(int)PowerManager::Phase::COUNT] = {
+    "init", "idle", "reconnect", "pairing", "connected", "motion_disabled", "motion_enabled"};
+
+std::atomic<uint32_t> PowerManager::pendingWakeups(0);
+
+static esp_pm_lock_handle_t cpuLock = nullptr;     // ESP_PM_CPU_FREQ_MAX
+static esp_pm_lock_handle_t sleepLock = nullptr;   // ESP_PM_NO_LIGHT_SLEEP
+static bool dfs = false;
+static bool lightSleep = false;
+static PowerManager::Mode currentMode = PowerManager::Mode::BALANCED;
+static PowerManager::Level clientLevels[(int)PowerManager::Client::COUNT];
+static PowerManager::Level heldLevel = PowerManager::Level::SLEEP;
+static PowerManager::Phase currentPhase = PowerManager::Phase::INIT;
+static PowerManager::PhaseStats phaseStats[(int)PowerManager::Phase::COUNT];
+static int64_t lastUpdateUs = 0;   // 64 位时间：后台任务可能几小时不唤醒，micros() 约 71 分钟回绕
+static uint32_t radioPpm = 0;   // 上次更新时估算的射频占空比（百万分之一）
+
+void PowerManager::begin()
+{
+    // 重新配置前释放已持有的锁，之后按各模块的级别重新获取
+    if (sleepLock && heldLevel >= Level::AWAKE)
+    {
+        esp_pm_lock_release(sleepLock);
+    }
+    if (cpuLock && heldLevel == Level::FULL_SPEED)
+    {
+        esp_pm_lock_release(cpuLock);
+    }
+    heldLevel = Level::SLEEP;
+
+    esp_pm_config_esp32c3_t config = {};
+    config.max_freq_mhz = MAX_FREQ_MHZ;
+    config.min_freq_mhz = MIN_FREQ_MHZ;
+    config.light_sleep_enable = true;
+    esp_err_t err = esp_pm_configure(&config);
+    if (err == ESP_ERR_NOT_SUPPORTED)
+    {
+        // 未启用 tickless idle 时不能浅睡眠，只调频
+        config.light_sleep_enable = false;
+        err = esp_pm_configure(&config);
+    }
+    dfs = err == ESP_OK;
+    lightSleep = dfs && config.light_sleep_enable;
+
+    if (dfs && !cpuLock)
+    {
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "cpu_max", &cpuLock);
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "no_sleep", &sleepLock);
+    }
+    if (lightSleep)
+    {
+        // GPIO 唤醒源：引脚的中断类型和唤醒电平由 ButtonEngine 设置。C3 只能由电平唤醒，
+        // 而同一引脚只有一个中断类型，在这里设置会被按键中断的安装覆盖
+        esp_sleep_enable_gpio_wakeup();
+        // LEDC 使用 RTC8M 时钟，浅睡眠期间保持供电
+        esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_ON);
+    }
+
+    for (int i = 0; i < (int)Client::COUNT; i++)
+    {
+        clientLevels[i] = Level::SLEEP;
+    }
+    clientLevels[(int)Client::MODE] = currentMode == Mode::PERFORMANCE ? Level::FULL_SPEED : Level::SLEEP;
+    applyLevel();
+    currentPhase = Phase::INIT;
+    resetStats();
+
+    if (!dfs)
+    {
+        LOG_WARN("电源管理不可用（需要 CONFIG_PM_ENABLE），CPU 始终全速运行");
+    }
+    else
+    {
+        LOG_INFO("电源管理已启用：调频 %lu/%luMHz，浅睡眠%s", (unsigned long)MAX_FREQ_MHZ,
+                 (unsigned long)MIN_FREQ_MHZ, lightSleep ? "已启用" : "不可用（需要 tickless idle）");
+    }
+}
+
+bool PowerManager::dfsEnabled()
+{
+    return dfs;
+}
+
+bool PowerManager::lightSleepEnabled()
+{
+    return lightSleep;
+}
+
+void PowerManager::setMode(Mode mode)
+{
+    currentMode = mode;
+    require(Client::MODE, mode == Mode::PERFORMANCE ? Level::FULL_SPEED : Level::SLEEP);
+}
+
+PowerManager::Mode PowerManager::mode()
+{
+    return currentMode;
+}
+
+void PowerManager::require(Client client, Level level)
+{
+    if (clientLevels[(int)client] == level)
+    {
+        return;
+    }
+    update();
+    clientLevels[(int)client] = level;
+    applyLevel();
+}
+
+PowerManager::Level PowerManager::level()
+{
+    return heldLevel;
+}
+
+// 按所有模块中最高的级别获取或释放锁；每把锁最多持有一次
+void PowerManager::applyLevel()
+{
+    Level target = Level::SLEEP;
+    for (int i = 0; i < (int)Client::COUNT; i++)
+    {
+        if (clientLevels[i] > target)
+        {
+            target = clientLevels[i];
+        }
+    }
+    if (target == heldLevel)
+    {
+        return;
+    }
+
+    bool holdSleep = target >= Level::AWAKE;
+    bool heldSleep = heldLevel >= Level::AWAKE;
+    bool holdCpu = target == Level::FULL_SPEED;
+    bool heldCpu = heldLevel == Level::FULL_SPEED;
+    if (sleepLock && holdSleep != heldSleep)
+    {
+        holdSleep ? esp_pm_lock_acquire(sleepLock) : esp_pm_lock_release(sleepLock);
+    }
+    if (cpuLock && holdCpu != heldCpu)
+    {
+        holdCpu ? esp_pm_lock_acquire(cpuLock) : esp_pm_lock_release(cpuLock);
+    }
+    heldLevel = target;
+}
+
+void PowerManager::enterPhase(Phase phase)
+{
+    update();
+    currentPhase = phase;
+    phaseStats[(int)phase].entries++;
+}
+
+void PowerManager::update()
+{
+    int64_t nowUs = esp_timer_get_time();
+    uint64_t elapsedUs = (uint64_t)(nowUs - lastUpdateUs);
+    lastUpdateUs = nowUs;
+
+    PhaseStats &stats = phaseStats[(int)currentPhase];
+    stats.totalUs += elapsedUs;
+    if (heldLevel >= Level::AWAKE)
+    {
+        stats.noSleepUs += elapsedUs;
+    }
+    if (heldLevel == Level::FULL_SPEED)
+    {
+        stats.fullSpeedUs += elapsedUs;
+    }
+    stats.radioUs += elapsedUs * radioPpm / 1000000;
+    stats.wakeups += pendingWakeups.exchange(0, std::memory_order_relaxed);
+
+    // 广播和连接的变化最晚在后台任务的下一轮被采样
+    radioPpm = radioDutyPpm();
+}
+
+// 射频占空比：广播事件和连接事件各自的射频时间除以事件间隔；
+// 不发送报告时连接事件按从机延迟跳过
+uint32_t PowerManager::radioDutyPpm()
+{
+    uint32_t ppm = 0;
+    if (AdvertisingController::advertising())
+    {
+        ppm += (uint32_t)((uint64_t)ADV_EVENT_RADIO_US * 1000000 /
+                          AdvertisingController::eventIntervalUs(AdvertisingController::params()));
+    }
+    uint32_t intervalUs = ConnParams::intervalUs();
+    if (intervalUs)
+    {
+        uint32_t skipped = clientLevels[(int)Client::MOTION] == Level::SLEEP ? ConnParams::diagnostics().latency : 0;
+        ppm += (uint32_t)((uint64_t)CONN_EVENT_RADIO_US * 1000000 / ((uint64_t)intervalUs * (skipped + 1)));
+    }
+    return ppm < 1000000 ? ppm : 1000000;
+}
+
+PowerManager::PhaseStats PowerManager::stats(Phase phase)
+{
+    update();
+    return phaseStats[(int)phase];
+}
+
+PowerManager::PhaseStats PowerManager::total()
+{
+    update();
+    PhaseStats sum = {};
+    for (const PhaseStats &stats : phaseStats)
+    {
+        sum.entries += stats.entries;
+        sum.totalUs += stats.totalUs;
+        sum.noSleepUs += stats.noSleepUs;
+        sum.fullSpeedUs += stats.fullSpeedUs;
+        sum.radioUs += stats.radioUs;
+        sum.wakeups += stats.wakeups;
+    }
+    return sum;
+}
+
+void PowerManager::resetStats()
+{
+    for (PhaseStats &stats : phaseStats)
+    {
+        stats = PhaseStats();
+    }
+    pendingWakeups = 0;
+    lastUpdateUs = esp_timer_get_time();
+    radioPpm = radioDutyPpm();
+}
+
+PowerManager::Model PowerManager::defaultModel()
+{
+    Model model;
+    model.activeMa = 23.0f;
+    model.idleMaxMa = 16.0f;
+    model.idleMinMa = 9.0f;
+    model.lightSleepMa = 0.13f;
+    model.radioMa = 60.0f;
+    model.wakeupUs = 300;
+    model.dfs = dfs;
+    model.lightSleep = lightSleep;
+    return model;
+}
+
+// 基础电流按锁的持有情况分段计算，唤醒和射频在基础电流之上叠加
+PowerManager::Estimate PowerManager::estimate(const PhaseStats &stats, const Model &model)
+{
+    Estimate result = {0.0, 0.0, 0.0};
+    if (stats.totalUs == 0)
+    {
+        return result;
+    }
+    double floorMa = model.lightSleep ? model.lightSleepMa : (model.dfs ? model.idleMinMa : model.idleMaxMa);
+    double awakeMa = model.dfs ? model.idleMinMa : model.idleMaxMa;
+    double fullUs = (double)stats.fullSpeedUs;
+    double awakeUs = (double)(stats.noSleepUs - stats.fullSpeedUs);
+    double sleepUs = (double)(stats.totalUs - stats.noSleepUs);
+    double baseCharge = fullUs * model.idleMaxMa + awakeUs * awakeMa + sleepUs * floorMa;   // mA·us
+    double baseMa = baseCharge / stats.totalUs;
+
+    double wakeUs = (double)stats.wakeups * model.wakeupUs;
+    double charge = baseCharge + wakeUs * (model.activeMa - baseMa) + stats.radioUs * (double)model.radioMa;
+    result.averageMa = charge / stats.totalUs;
+    result.mAh = charge / 3600.0e6;
+    result.sleepFraction = model.lightSleep ? sleepUs / stats.totalUs : 0.0;
+    return result;
+}
+
+const char *PowerManager::name(Phase phase)
+{
+    return (int)phase < (int)Phase::COUNT ? PHASE_NAMES[(int)phase] : "?";
+}
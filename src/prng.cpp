@@ -0,0 +1,12 @@
+#include "prng.h"
+#include <esp_system.h>
+
+// 设备上射频开启后 esp_random() 为真随机数，鼠标移动只在连接后开启，此时取种子
+uint32_t Prng::hardwareSeed()
+{
+#ifdef PRNG_FIXED_SEED
+    return PRNG_FIXED_SEED;
+#else
+    return esp_random();
+#endif
+}
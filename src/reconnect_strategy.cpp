@@ -0,0 +1,95 @@
+#include "reconnect_strategy.h"
+#include "advertising_schedule.h"
+#include "logger.h"
+#include <NimBLEDevice.h>
+
+const uint32_t ReconnectStrategy::HISTOGRAM_LIMITS_MS[ReconnectStrategy::HISTOGRAM_BUCKETS - 1] = {
+    50, 100, 200, 500, 1000, 2000, 5000, 10000, 30000};
+
+uint32_t ReconnectStrategy::startUs = 0;
+bool ReconnectStrategy::connected = false;
+ReconnectStrategy::Stats ReconnectStrategy::counters;
+
+void ReconnectStrategy::begin(uint32_t originUs)
+{
+    startUs = originUs;
+    connected = false;
+    counters.attempts++;
+
+    // MAX_BONDS=1，只有一个绑定主机；把它放进过滤接受列表，其他设备的扫描和连接请求由控制器丢弃
+    if (NimBLEDevice::getNumBonds() > 0)
+    {
+        NimBLEAddress bondedPeer = NimBLEDevice::getBondedAddress(0);
+        if (!NimBLEDevice::onWhiteList(bondedPeer))
+        {
+            NimBLEDevice::whiteListAdd(bondedPeer);
+        }
+        AdvertisingSchedule::setPeer(bondedPeer);
+        AdvertisingSchedule::start(AdvertisingSchedule::ScheduleId::RECONNECT_BONDED, originUs);
+    }
+    else
+    {
+        AdvertisingSchedule::start(AdvertisingSchedule::ScheduleId::RECONNECT_OPEN, originUs);
+    }
+}
+
+void ReconnectStrategy::onConnected(uint32_t connectedUs)
+{
+    if (connected)
+    {
+        return;
+    }
+    connected = true;
+    uint32_t ms = (connectedUs - startUs) / 1000;
+    counters.reconnects++;
+    counters.histogram[bucket(ms)]++;
+    counters.totalMs += ms;
+    if (ms > counters.maxMs)
+    {
+        counters.maxMs = ms;
+    }
+    LOG_INFO("重连用时 %lu ms（%s 阶段）", (unsigned long)ms,
+             AdvertisingSchedule::stageName(AdvertisingSchedule::schedule(), AdvertisingSchedule::stage()));
+}
+
+void ReconnectStrategy::end()
+{
+    if (!connected)
+    {
+        counters.abandoned++;
+    }
+}
+
+void ReconnectStrategy::forgetBonds()
+{
+    int bonds = NimBLEDevice::getNumBonds();
+    for (int i = 0; i < bonds; i++)
+    {
+        NimBLEDevice::whiteListRemove(NimBLEDevice::getBondedAddress(i));
+    }
+    if (bonds > 0 && NimBLEDevice::deleteAllBonds())
+    {
+        counters.forgotten++;
+        LOG_INFO("已清除 %d 个绑定", bonds);
+    }
+}
+
+uint8_t ReconnectStrategy::bucket(uint32_t ms)
+{
+    uint8_t index = 0;
+    while (index < HISTOGRAM_BUCKETS - 1 && ms >= HISTOGRAM_LIMITS_MS[index])
+    {
+        index++;
+    }
+    return index;
+}
+
+ReconnectStrategy::Stats ReconnectStrategy::stats()
+{
+    return counters;
+}
+
+void ReconnectStrategy::resetStats()
+{
+    counters = Stats();
+}
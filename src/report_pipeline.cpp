@@ -0,0 +1,159 @@
+#include "report_pipeline.h"
+
+// 待发位移加上 delta 后限制在一份报告的范围内，返回丢弃的计数
+static uint32_t accumulate(int32_t &pending, int8_t delta)
+{
+    int32_t sum = pending + delta;
+    if (sum > 127)
+    {
+        pending = 127;
+        return sum - 127;
+    }
+    if (sum < -127)
+    {
+        pending = -127;
+        return -127 - sum;
+    }
+    pending = sum;
+    return 0;
+}
+
+// 各速率档位的基本发送间隔
+static const uint32_t RATE_INTERVALS_US[(int)ReportPipeline::RateMode::COUNT] = {
+    40000, // 25Hz
+    20000, // 50Hz
+    10000, // 100Hz
+    7500   // 133Hz，即 BLE 最短连接间隔
+};
+
+ReportPipeline::ReportPipeline(SendFunction send, void *context)
+    : ReportPipeline(send, context, Config()) {}
+
+ReportPipeline::ReportPipeline(SendFunction send, void *context, const Config &config)
+    : sendFunction(send), sendContext(context), cfg(config)
+{
+    resetStats();
+    reset();
+}
+
+void ReportPipeline::reset()
+{
+    pendingX = 0;
+    pendingY = 0;
+    lastSendUs = 0;
+    hasSent = false;
+    releasePending = false;
+    backoff = 0;
+    successStreak = 0;
+}
+
+uint32_t ReportPipeline::rateIntervalUs(RateMode mode)
+{
+    return RATE_INTERVALS_US[(int)mode];
+}
+
+uint32_t ReportPipeline::intervalUs() const
+{
+    uint32_t interval = rateIntervalUs(cfg.rateMode);
+    if (cfg.minIntervalUs > interval)
+    {
+        interval = cfg.minIntervalUs;
+    }
+    return interval << backoff;
+}
+
+void ReportPipeline::resetStats()
+{
+    counters = Stats();
+}
+
+bool ReportPipeline::submit(int8_t dx, int8_t dy, uint32_t nowUs)
+{
+    counters.submitted++;
+    bool moving = dx != 0 || dy != 0;
+    bool hasPending = pendingX != 0 || pendingY != 0;
+
+    if (moving)
+    {
+        if (hasPending)
+        {
+            counters.coalesced++;
+        }
+        counters.discarded += accumulate(pendingX, dx) + accumulate(pendingY, dy);
+        hasPending = true;
+    }
+
+    // 允许提前 1/8 个间隔发送，避免与发送间隔相同的调用周期因抖动隔一次才发
+    uint32_t interval = intervalUs();
+    bool due = !hasSent || nowUs - lastSendUs + interval / 8 >= interval;
+
+    if (hasPending)
+    {
+        if (!due)
+        {
+            if (!moving)
+            {
+                counters.dropped++;
+            }
+            return false;
+        }
+        if (!send((int8_t)pendingX, (int8_t)pendingY, nowUs))
+        {
+            // 协议栈没有接收：位移留在待发中，退避后再合并发送
+            return false;
+        }
+        pendingX = 0;
+        pendingY = 0;
+        releasePending = true;
+        return true;
+    }
+
+    // 没有待发位移：只在刚停止移动时或保活间隔到期时发送释放报告
+    if (releasePending && due)
+    {
+        releasePending = !send(0, 0, nowUs);
+        return !releasePending;
+    }
+    if (!releasePending && (!hasSent || nowUs - lastSendUs >= cfg.idleReportIntervalUs))
+    {
+        return send(0, 0, nowUs);
+    }
+
+    counters.dropped++;
+    return false;
+}
+
+bool ReportPipeline::send(int8_t dx, int8_t dy, uint32_t nowUs)
+{
+    uint8_t buttons = 0;                                          // 明确设置无点击状态（包括中键）
+    uint8_t report[4] = {buttons, (uint8_t)dx, (uint8_t)dy, 0}; // 滚轮始终为0
+    lastSendUs = nowUs;
+    hasSent = true;
+    bool delivered = sendFunction(report, sizeof(report), sendContext);
+    onSendResult(delivered);
+    return delivered;
+}
+
+// 失败立即升一级退避；在同一级别连续成功 rampUpSuccesses 次后降一级
+void ReportPipeline::onSendResult(bool delivered)
+{
+    if (!delivered)
+    {
+        counters.failed++;
+        successStreak = 0;
+        if (backoff < cfg.maxBackoffLevel)
+        {
+            backoff++;
+            counters.backoffs++;
+        }
+        return;
+    }
+
+    counters.sent++;
+    if (backoff > 0 && ++successStreak >= cfg.rampUpSuccesses)
+    {
+        backoff--;
+        successStreak = 0;
+        counters.rampUps++;
+    }
+}
@@ -0,0 +1,247 @@
+#include "settings_store.h"
+#include "logger.h"
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <string.h>
+
+static_assert(sizeof(SettingsStore::Record) == 20, "设置记录的布局不能改变，新增字段需提升 VERSION");
+
+static const char *const NVS_NAMESPACE = "mouse";
+static const char *const NVS_KEY = "settings";
+
+static nvs_handle_t handle = 0;
+static SettingsStore::Settings current = SettingsStore::defaults();
+static SettingsStore::Record stored;   // 最近一次读到或写入的记录
+static bool storedValid = false;
+static bool dirty = false;
+static uint32_t firstChangeMs = 0;     // 本轮第一次修改的时间
+static uint32_t lastChangeMs = 0;
+static SettingsStore::Stats counters;
+
+static uint16_t toQ8(float value)
+{
+    float scaled = value * 256.0f + 0.5f;
+    return scaled >= 65535.0f ? 65535 : (uint16_t)scaled;
+}
+
+bool SettingsStore::begin()
+{
+    uint32_t startUs = micros();
+    if (handle)
+    {
+        nvs_close(handle);
+        handle = 0;
+    }
+    current = defaults();
+    storedValid = false;
+    dirty = false;
+
+    // 分区已满或由新版本 IDF 格式化时按 IDF 的惯例擦除后重新初始化
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND)
+    {
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    if (err == ESP_OK)
+    {
+        err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    }
+    if (err != ESP_OK)
+    {
+        handle = 0;
+        LOG_ERROR("NVS 初始化失败: 0x%x，设置不会保存", err);
+        return false;
+    }
+
+    Record record;
+    size_t length = sizeof(record);
+    err = nvs_get_blob(handle, NVS_KEY, &record, &length);
+    bool loaded = err == ESP_OK && length == sizeof(record) && decode(record, current);
+    counters.lastLoadUs = micros() - startUs;
+    if (loaded)
+    {
+        stored = record;
+        storedValid = true;
+        counters.loads++;
+        LOG_INFO("已读取设置（版本 %u，%lu us）：鼠标移动%s，报告速率档位 %u", record.version,
+                 (unsigned long)counters.lastLoadUs, current.motionEnabled ? "启用" : "禁用",
+                 (unsigned)current.reportRate);
+    }
+    else if (err == ESP_ERR_NVS_NOT_FOUND)
+    {
+        LOG_INFO("没有保存的设置，使用默认值");
+    }
+    else
+    {
+        counters.rejected++;
+        LOG_WARN("设置记录无效（错误 0x%x，长度 %u），使用默认值", err, (unsigned)length);
+    }
+    return loaded;
+}
+
+const SettingsStore::Settings &SettingsStore::settings()
+{
+    return current;
+}
+
+void SettingsStore::setMotionEnabled(bool enabled)
+{
+    if (current.motionEnabled != enabled)
+    {
+        current.motionEnabled = enabled;
+        markDirty();
+    }
+}
+
+void SettingsStore::setReportRate(ReportPipeline::RateMode mode)
+{
+    if (current.reportRate != mode)
+    {
+        current.reportRate = mode;
+        markDirty();
+    }
+}
+
+// 每次修改推迟写入；连续修改时以第一次修改的时间为上限
+void SettingsStore::markDirty()
+{
+    uint32_t nowMs = millis();
+    if (!dirty)
+    {
+        dirty = true;
+        firstChangeMs = nowMs;
+    }
+    lastChangeMs = nowMs;
+    counters.changes++;
+}
+
+uint32_t SettingsStore::msUntilCommit(uint32_t nowMs, uint32_t maxWaitMs)
+{
+    if (!dirty)
+    {
+        return maxWaitMs;
+    }
+    int32_t quietMs = (int32_t)(lastChangeMs + COMMIT_DELAY_MS - nowMs);
+    int32_t limitMs = (int32_t)(firstChangeMs + MAX_COMMIT_DELAY_MS - nowMs);
+    int32_t remainingMs = quietMs < limitMs ? quietMs : limitMs;
+    if (remainingMs <= 0)
+    {
+        return 0;
+    }
+    return (uint32_t)remainingMs < maxWaitMs ? (uint32_t)remainingMs : maxWaitMs;
+}
+
+void SettingsStore::update(uint32_t nowMs)
+{
+    if (dirty && msUntilCommit(nowMs, 1) == 0)
+    {
+        commit();
+    }
+}
+
+bool SettingsStore::pending()
+{
+    return dirty;
+}
+
+// 写入失败不重试，下一次修改时再写入
+bool SettingsStore::commit()
+{
+    dirty = false;
+    Record record = encode(current);
+    if (storedValid && memcmp(&record, &stored, sizeof(record)) == 0)
+    {
+        counters.skipped++;
+        return true;
+    }
+    if (!handle)
+    {
+        counters.failures++;
+        return false;
+    }
+
+    uint32_t startUs = micros();
+    esp_err_t err = nvs_set_blob(handle, NVS_KEY, &record, sizeof(record));
+    if (err == ESP_OK)
+    {
+        err = nvs_commit(handle);
+    }
+    uint32_t elapsedUs = micros() - startUs;
+    if (err != ESP_OK)
+    {
+        counters.failures++;
+        LOG_WARN("保存设置失败: 0x%x", err);
+        return false;
+    }
+    stored = record;
+    storedValid = true;
+    counters.commits++;
+    if (elapsedUs > counters.maxCommitUs)
+    {
+        counters.maxCommitUs = elapsedUs;
+    }
+    LOG_DEBUG("设置已保存，%lu us", (unsigned long)elapsedUs);
+    return true;
+}
+
+SettingsStore::Stats SettingsStore::stats()
+{
+    return counters;
+}
+
+void SettingsStore::resetStats()
+{
+    counters = Stats();
+}
+
+SettingsStore::Settings SettingsStore::defaults()
+{
+    Settings settings;
+    settings.motionEnabled = false;
+    settings.reportRate = ReportPipeline::RateMode::HZ_100;
+    settings.motion = MotionEngine::Config();
+    return settings;
+}
+
+SettingsStore::Record SettingsStore::encode(const Settings &settings)
+{
+    const MotionEngine::Config &motion = settings.motion;
+    Record record = {};
+    record.version = VERSION;
+    record.flags = (settings.motionEnabled ? FLAG_MOTION_ENABLED : 0) | (motion.plannerWeight ? 0 : FLAG_PER_STEP_MOTION);
+    record.reportRate = (uint8_t)settings.reportRate;
+    record.maxSpeed = motion.maxSpeed >= 65535.0f ? 65535 : (uint16_t)(motion.maxSpeed + 0.5f);
+    record.smoothRateQ8 = toQ8(motion.smoothRate);
+    record.pauseDecayRateQ8 = toQ8(motion.pauseDecayRate);
+    record.patternChangeIntervalMs = motion.patternChangeIntervalMs;
+    record.minMoveMs = motion.minMoveMs;
+    record.maxMoveMs = motion.maxMoveMs;
+    record.minPauseMs = motion.minPauseMs;
+    record.maxPauseMs = motion.maxPauseMs;
+    return record;
+}
+
+bool SettingsStore::decode(const Record &record, Settings &settings)
+{
+    if (record.version != VERSION || (record.flags & ~(FLAG_MOTION_ENABLED | FLAG_PER_STEP_MOTION)) || record.reserved ||
+        record.reportRate >= (uint8_t)ReportPipeline::RateMode::COUNT || record.maxSpeed == 0 ||
+        record.smoothRateQ8 == 0 || record.pauseDecayRateQ8 == 0 || record.patternChangeIntervalMs == 0 ||
+        record.minMoveMs == 0 || record.minMoveMs > record.maxMoveMs || record.minPauseMs > record.maxPauseMs)
+    {
+        return false;
+    }
+    settings.motionEnabled = record.flags & FLAG_MOTION_ENABLED;
+    settings.reportRate = (ReportPipeline::RateMode)record.reportRate;
+    MotionEngine::Config &motion = settings.motion;
+    motion.maxSpeed = record.maxSpeed;
+    motion.smoothRate = record.smoothRateQ8 / 256.0f;
+    motion.pauseDecayRate = record.pauseDecayRateQ8 / 256.0f;
+    motion.patternChangeIntervalMs = record.patternChangeIntervalMs;
+    motion.minMoveMs = record.minMoveMs;
+    motion.maxMoveMs = record.maxMoveMs;
+    motion.minPauseMs = record.minPauseMs;
+    motion.maxPauseMs = record.maxPauseMs;
+    motion.plannerWeight = record.flags & FLAG_PER_STEP_MOTION ? 0 : MotionEngine::Config().plannerWeight;
+    return true;
+}
@@ -1,80 +1,74 @@
 #include "state_machine.h"
+#include "app_tasks.h"
+#include "advertising_controller.h"
+#include "advertising_schedule.h"
+#include "reconnect_strategy.h"
+#include "conn_params.h"
+#include "event_queue.h"
+#include "logger.h"
+#include "timer_service.h"
+#include "power_manager.h"
+#include "settings_store.h"
+#include "led_controller.h"
 #include <Arduino.h>
 #include <NimBLEDevice.h>
 #include <NimBLEServer.h>
 #include <NimBLEUtils.h>
 #include <NimBLEHIDDevice.h>
 
-// LED 引脚定义
-#define LED_D4_PIN 12 // 高电平有效
-#define LED_D5_PIN 13 // 高电平有效
-
 // 全局变量声明
 extern NimBLEServer *pServer;
 extern NimBLEHIDDevice *hid;
 extern NimBLECharacteristic *inputMouse;
 extern bool deviceConnected;
-extern unsigned long buttonPressStartTime;
-extern unsigned long lastBlinkTime;
-extern bool ledState;
-extern int blinkCount;
-
-// 鼠标移动状态变量外部声明
-extern float currentVelocityX;
-extern float currentVelocityY;
-extern float targetVelocityX;
-extern float targetVelocityY;
-extern float moveAngle;
-extern float moveRadius;
-extern unsigned long lastMoveUpdate;
-extern unsigned long patternChangeTimer;
-extern unsigned int patternChangeInterval;
-extern int currentPattern;
-
-// 鼠标运动状态记忆外部声明
-extern bool rememberedMouseMotionState;
-
-// 安卓拖动问题修复变量外部声明
-extern bool lastWasMoving;
-extern unsigned long lastReleaseReportTime;
-extern const unsigned long RELEASE_REPORT_INTERVAL;
-
-// 移动和停顿控制变量外部声明
-extern bool isMoving;
-extern unsigned long movePhaseTimer;
-extern unsigned long pausePhaseTimer;
-extern unsigned int moveDuration;
-extern unsigned int pauseDuration;
-extern bool inMovePhase;
-
-// 定义静态成员
-float MouseMotionEnable::angle = 0;
+
+// 已连接时双击切换到下一个报告速率档位，三击恢复默认的 100Hz
+static void cycleReportRate()
+{
+    int next = ((int)AppTasks::reportRate() + 1) % (int)ReportPipeline::RateMode::COUNT;
+    AppTasks::setReportRate((ReportPipeline::RateMode)next);
+    SettingsStore::setReportRate((ReportPipeline::RateMode)next);
+    LOG_INFO("双击按钮，报告速率切换到 %luHz",
+             (unsigned long)(1000000 / ReportPipeline::rateIntervalUs((ReportPipeline::RateMode)next)));
+}
+
+static void resetReportRate()
+{
+    AppTasks::setReportRate(ReportPipeline::RateMode::HZ_100);
+    SettingsStore::setReportRate(ReportPipeline::RateMode::HZ_100);
+    LOG_INFO("三击按钮，报告速率恢复为 100Hz");
+}
+
+void BleMouseState::react(AdvertisingStageTimeout const &)
+{
+    AdvertisingSchedule::advance();
+}
+
+void BleMouseState::react(AdvertisingRetry const &)
+{
+    AdvertisingController::retry();
+}
 
 // Init状态实现
 void Init::entry()
 {
-    Serial.println("进入初始化状态");
+    LOG_INFO("进入初始化状态");
+    PowerManager::enterPhase(PowerManager::Phase::INIT);
     // 初始化LED
-    pinMode(LED_D4_PIN, OUTPUT);
-    pinMode(LED_D5_PIN, OUTPUT);
-    digitalWrite(LED_D4_PIN, LOW);
-    digitalWrite(LED_D5_PIN, LOW);
+    LEDController::init();
+    LEDController::setMode(LEDController::Mode::OFF);
 
     // 初始化全局变量
     deviceConnected = false;
-    buttonPressStartTime = 0;
-    lastBlinkTime = 0;
-    ledState = false;
-    blinkCount = 0;
 
-    Serial.println("LED引脚初始化完成");
-    Serial.println("全局变量初始化完成");
-    Serial.println("等待初始化完成事件...");
+    LOG_DEBUG("LED初始化完成");
+    LOG_DEBUG("全局变量初始化完成");
+    LOG_DEBUG("等待初始化完成事件...");
 }
 
 void Init::react(InitComplete const &)
 {
-    Serial.println("接收到初始化完成事件，检查是否需要重新连接到已配对设备");
+    LOG_INFO("接收到初始化完成事件，检查是否需要重新连接到已配对设备");
     // 根据设计，在初始化完成后先进入Reconnect状态尝试连接之前配对的设备
     transit<Reconnect>();
 }
@@ -82,330 +76,302 @@ void Init::react(InitComplete const &)
 // Idle状态实现
 void Idle::entry()
 {
-    Serial.println("进入空闲状态 - 设备可被发现和连接");
-    digitalWrite(LED_D4_PIN, LOW);
-    digitalWrite(LED_D5_PIN, LOW);
+    LOG_INFO("进入空闲状态 - 设备可被发现和连接");
+    PowerManager::enterPhase(PowerManager::Phase::IDLE);
+    LEDController::setMode(LEDController::Mode::OFF);
 
-    // 确保设备处于可被发现状态
-    if (pServer)
+    // 确保设备以公开广播处于可被发现状态（重连阶段的定向或过滤广播在这里切换回来），
+    // 没有主机连接时广播间隔逐级放宽
+    if (AdvertisingSchedule::start(AdvertisingSchedule::ScheduleId::IDLE, EventQueue::dispatchingOriginUs()))
     {
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        if (!pAdvertising->isAdvertising())
-        {
-            pAdvertising->start();
-            Serial.println("启动广播，设备现在可被发现");
-        }
-        else
-        {
-            Serial.println("广播已在运行");
-        }
+        LOG_INFO("广播已启动，设备现在可被发现");
     }
 
     // 检查是否已有连接的设备
     if (pServer && pServer->getConnectedCount() > 0)
     {
-        Serial.println("检测到已有连接的设备，发送DeviceConnected事件");
-        BleMouseState::dispatch(DeviceConnected());
+        LOG_INFO("检测到已有连接的设备，发送DeviceConnected事件");
+        EventQueue::post(EventQueue::EventId::DEVICE_CONNECTED);
     }
     else
     {
-        Serial.println("空闲状态下设备可被连接...");
-        Serial.println("等待已配对设备自动连接或新设备连接...");
+        LOG_DEBUG("空闲状态下设备可被连接...");
+        LOG_DEBUG("等待已配对设备自动连接或新设备连接...");
     }
 }
 
 void Idle::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，进入配对模式");
+    LOG_INFO("长按按钮，进入配对模式");
     transit<Pairing>();
 }
 
 void Idle::react(BootButtonShortPress const &)
 {
-    Serial.println("在空闲状态下短按按钮，无操作");
+    LOG_DEBUG("在空闲状态下短按按钮，无操作");
     // 在空闲状态下短按无效
 }
 
 void Idle::react(DeviceConnected const &)
 {
-    Serial.println("在空闲状态下设备已连接，切换到连接状态");
+    LOG_INFO("在空闲状态下设备已连接，切换到连接状态");
     transit<Connected>();
-    // 进入Connected状态后立即触发状态恢复事件
-    BleMouseState::dispatch(RestoreMouseMotionState());
+    // 进入Connected状态后投递状态恢复事件，当前处理函数返回后分发
+    EventQueue::post(EventQueue::EventId::RESTORE_MOUSE_MOTION_STATE);
 }
 
 void Idle::react(DeviceDisconnected const &)
 {
-    Serial.println("设备断开连接，进入重连模式");
+    LOG_INFO("设备断开连接，进入重连模式");
     transit<Reconnect>();
 }
 
 void Idle::react(ConnectionTimeout const &)
 {
-    Serial.println("在空闲状态下连接超时，保持空闲状态");
+    LOG_DEBUG("在空闲状态下连接超时，保持空闲状态");
     // 保持在当前状态
 }
 
 void Idle::react(PairingTimeout const &)
 {
-    Serial.println("在空闲状态下配对超时，保持空闲状态");
+    LOG_DEBUG("在空闲状态下配对超时，保持空闲状态");
     // 保持在当前状态
 }
 
 void Idle::react(ConnectionFailed const &)
 {
-    Serial.println("在空闲状态下连接失败，保持空闲状态");
+    LOG_DEBUG("在空闲状态下连接失败，保持空闲状态");
     // 保持在当前状态
 }
 
 void Idle::react(InitComplete const &)
 {
-    Serial.println("在空闲状态下接收到初始化完成事件，保持空闲状态");
+    LOG_DEBUG("在空闲状态下接收到初始化完成事件，保持空闲状态");
     // 保持在当前状态
 }
 
 // Reconnect状态实现
 void Reconnect::entry()
 {
-    Serial.println("进入重连状态 - 尝试连接之前配对的设备");
-    digitalWrite(LED_D4_PIN, LOW);
-    digitalWrite(LED_D5_PIN, LOW);
-    reconnectStartTime = millis();
+    LOG_INFO("进入重连状态 - 尝试连接之前配对的设备");
+    PowerManager::enterPhase(PowerManager::Phase::RECONNECT);
+    // 每秒闪烁 1 次
+    LEDController::setMode(LEDController::Mode::SLOW_BLINK);
 
-    // 确保广播是开启的，以便已配对设备可以连接
-    if (pServer)
-    {
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        if (!pAdvertising->isAdvertising())
-        {
-            pAdvertising->start();
-            Serial.println("启动广播以等待已配对设备连接");
-        }
-    }
+    // 按阶段广播等待已绑定的主机重连（断开后从这里重新开始广播），从断开事件开始计时
+    ReconnectStrategy::begin(EventQueue::dispatchingOriginUs());
 
     // 开始重连逻辑
     startReconnection();
 }
 
+void Reconnect::exit()
+{
+    TimerService::cancel(TimerService::TimerId::RECONNECT_TIMEOUT);
+    ReconnectStrategy::end();
+}
+
 void Reconnect::react(DeviceConnected const &)
 {
-    Serial.println("在重连状态下设备已连接，切换到连接状态");
+    LOG_INFO("在重连状态下设备已连接，切换到连接状态");
+    ReconnectStrategy::onConnected(EventQueue::dispatchingOriginUs());
     transit<Connected>();
-    // 进入Connected状态后立即触发状态恢复事件
-    BleMouseState::dispatch(RestoreMouseMotionState());
+    // 进入Connected状态后投递状态恢复事件，当前处理函数返回后分发
+    EventQueue::post(EventQueue::EventId::RESTORE_MOUSE_MOTION_STATE);
 }
 
 void Reconnect::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，进入配对模式");
+    LOG_INFO("长按按钮，进入配对模式");
+    transit<Pairing>();
+}
+
+// 按住期间 3 秒的长按已经进入配对，只有长按事件丢失时才会在这里收到
+void Reconnect::react(BootButtonVeryLongPress const &)
+{
+    LOG_INFO("超长按按钮，清除绑定并进入配对模式");
+    ReconnectStrategy::forgetBonds();
     transit<Pairing>();
 }
 
 void Reconnect::react(ConnectionTimeout const &)
 {
-    Serial.println("重连超时，继续尝试重连");
+    LOG_DEBUG("重连超时，继续尝试重连");
     // 重连超时，继续尝试
     startReconnection();
 }
 
 void Reconnect::react(ConnectionFailed const &)
 {
-    Serial.println("连接失败，继续尝试连接");
+    LOG_DEBUG("连接失败，继续尝试连接");
     // 连接失败，继续尝试
     startReconnection();
 }
 
+// 每次开始重连窗口都重新计时，窗口结束时投递 ConnectionTimeout；
+// 广播阶段不随窗口重置，由广播计划按进入重连后的时间推进
 void Reconnect::startReconnection()
 {
-    Serial.println("尝试重新连接到之前配对的设备...");
-    // 在BLE HID设备中，通常我们只需要保持广播开启
-    // 已配对的设备会自动尝试连接
-    // 也可以考虑特定的重新连接逻辑
-}
-
-void Reconnect::checkTimeout()
-{
-    if (millis() - reconnectStartTime > Reconnect::RECONNECT_TIMEOUT)
-    {
-        BleMouseState::dispatch(ConnectionTimeout());
-    }
+    LOG_INFO("尝试重新连接到之前配对的设备（%s 阶段）...",
+             AdvertisingSchedule::stageName(AdvertisingSchedule::schedule(), AdvertisingSchedule::stage()));
+    TimerService::arm(TimerService::TimerId::RECONNECT_TIMEOUT, Reconnect::RECONNECT_TIMEOUT);
 }
 
 // Pairing状态实现
 void Pairing::entry()
 {
-    Serial.println("进入配对状态");
-    digitalWrite(LED_D4_PIN, LOW);
-    digitalWrite(LED_D5_PIN, LOW);
-    pairingStartTime = millis();
-    blinkCount = 0;
-    lastBlinkTime = millis();
-    ledState = false;
-
-    // 确保设备处于可被发现状态，允许新设备配对连接
-    if (pServer)
-    {
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        if (pAdvertising->isAdvertising())
-        {
-            pAdvertising->stop();
-            delay(100);
-        }
-        // 重新启动广播以允许新的配对请求
-        pAdvertising->start();
-        Serial.println("广播已启动，设备进入配对模式");
-    }
-    else
-    {
-        Serial.println("错误：pServer为nullptr，无法启动广播");
-    }
+    LOG_INFO("进入配对状态");
+    PowerManager::enterPhase(PowerManager::Phase::PAIRING);
+    // 每秒闪烁 3 次
+    LEDController::setMode(LEDController::Mode::FAST_BLINK);
+    TimerService::arm(TimerService::TimerId::PAIRING_TIMEOUT, Pairing::PAIRING_TIMEOUT);
 
-    // 重新开始BLE广播
+    // 重新开始BLE广播，允许新设备配对连接
     startPairing();
 }
 
+void Pairing::exit()
+{
+    TimerService::cancel(TimerService::TimerId::PAIRING_TIMEOUT);
+}
+
 void Pairing::react(DeviceConnected const &)
 {
-    Serial.println("在配对状态下设备已连接，切换到连接状态");
+    LOG_INFO("在配对状态下设备已连接，切换到连接状态");
     transit<Connected>();
-    // 进入Connected状态后立即触发状态恢复事件
-    BleMouseState::dispatch(RestoreMouseMotionState());
+    // 进入Connected状态后投递状态恢复事件，当前处理函数返回后分发
+    EventQueue::post(EventQueue::EventId::RESTORE_MOUSE_MOTION_STATE);
 }
 
 void Pairing::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，保持在配对模式");
+    LOG_DEBUG("长按按钮，保持在配对模式");
     // 已经在配对模式，保持当前状态
 }
 
+// 换到新主机：清除旧主机的绑定，配对窗口重新计时，超时后的重连不再只等旧主机
+void Pairing::react(BootButtonVeryLongPress const &)
+{
+    LOG_INFO("超长按按钮，清除绑定，重新开始配对计时");
+    ReconnectStrategy::forgetBonds();
+    TimerService::arm(TimerService::TimerId::PAIRING_TIMEOUT, Pairing::PAIRING_TIMEOUT);
+}
+
 void Pairing::react(DeviceDisconnected const &)
 {
-    Serial.println("设备断开连接，进入重连模式");
+    LOG_INFO("设备断开连接，进入重连模式");
     transit<Reconnect>();
 }
 
 void Pairing::react(PairingTimeout const &)
 {
-    Serial.println("配对超时，进入重连模式");
+    LOG_INFO("配对超时，进入重连模式");
     transit<Reconnect>();
 }
 
 void Pairing::react(ConnectionFailed const &)
 {
-    Serial.println("配对连接失败，进入重连模式");
+    LOG_INFO("配对连接失败，进入重连模式");
     transit<Reconnect>();
 }
 
 void Pairing::startPairing()
 {
-    Serial.println("开始蓝牙配对...");
-    Serial.println("确保BLE广播正在运行...");
-    // 重新开始BLE广播
-    if (pServer)
+    LOG_INFO("开始蓝牙配对...");
+    // 公开广播，允许新设备连接；停止当前广播后立即重新启动，不等待，启动失败时由广播控制器重试
+    if (AdvertisingSchedule::start(AdvertisingSchedule::ScheduleId::PAIRING, EventQueue::dispatchingOriginUs(), true))
     {
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        Serial.println("停止当前广播...");
-        pAdvertising->stop();
-        delay(1000);
-        Serial.println("启动新的广播...");
-        pAdvertising->start();
-        Serial.println("广播已启动，等待连接...");
+        LOG_INFO("广播已启动，等待连接...");
     }
     else
     {
-        Serial.println("错误：pServer为nullptr");
-    }
-}
-
-void Pairing::checkTimeout()
-{
-    if (millis() - pairingStartTime > Pairing::PAIRING_TIMEOUT)
-    {
-        BleMouseState::dispatch(PairingTimeout());
+        LOG_WARN("广播启动失败，稍后重试");
     }
 }
 
 // Connected状态实现
 void Connected::entry()
 {
-    Serial.println("进入连接状态 - LED常亮");
+    LOG_INFO("进入连接状态 - LED常亮");
+    PowerManager::enterPhase(PowerManager::Phase::CONNECTED);
     // LED常亮表示已连接
-    digitalWrite(LED_D4_PIN, HIGH);
-    digitalWrite(LED_D5_PIN, HIGH);
+    LEDController::setMode(LEDController::Mode::ON);
+
+    // 确保广播已停止，因为我们已经连接了；连接记入广播计划当前的阶段
+    if (AdvertisingSchedule::running())
+    {
+        LOG_INFO("设备已连接，停止广播");
+    }
+    AdvertisingSchedule::onConnected();
 
-    // 确保广播已停止，因为我们已经连接了
-    if (pServer)
+    // 记录中心设备选择的初始连接参数
+    if (pServer && pServer->getConnectedCount() > 0)
     {
-        NimBLEAdvertising *pAdvertising = pServer->getAdvertising();
-        if (pAdvertising->isAdvertising())
-        {
-            pAdvertising->stop();
-            Serial.println("设备已连接，停止广播");
-        }
+        ConnParams::onConnected(pServer->getPeerInfo(0));
     }
 
-    Serial.println("连接状态设置完成");
+    LOG_INFO("连接状态设置完成");
 }
 
 void Connected::react(BootButtonShortPress const &)
 {
-    Serial.println("在连接状态下短按按钮，切换到鼠标移动启用状态");
+    LOG_INFO("在连接状态下短按按钮，切换到鼠标移动启用状态");
     // 短按切换到鼠标移动启用状态
     transit<MouseMotionEnable>();
 }
 
 void Connected::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，进入配对模式");
+    LOG_INFO("长按按钮，进入配对模式");
     transit<Pairing>();
 }
 
 void Connected::react(DeviceConnected const &)
 {
     // 设备已经连接，保持当前状态
-    Serial.println("接收到设备已连接事件，保持连接状态");
+    LOG_DEBUG("接收到设备已连接事件，保持连接状态");
 }
 
 void Connected::react(DeviceDisconnected const &)
 {
-    Serial.println("设备断开连接，进入重连模式");
+    LOG_INFO("设备断开连接，进入重连模式");
     transit<Reconnect>();
 }
 
 void Connected::react(ConnectionTimeout const &)
 {
-    Serial.println("连接超时事件，保持连接状态");
+    LOG_DEBUG("连接超时事件，保持连接状态");
     // 默认处理，不执行状态转换
 }
 
 void Connected::react(PairingTimeout const &)
 {
-    Serial.println("配对超时事件，保持连接状态");
+    LOG_DEBUG("配对超时事件，保持连接状态");
     // 默认处理，不执行状态转换
 }
 
 void Connected::react(ConnectionFailed const &)
 {
-    Serial.println("连接失败事件，保持连接状态");
+    LOG_DEBUG("连接失败事件，保持连接状态");
     // 默认处理，不执行状态转换
 }
 
 void Connected::react(InitComplete const &)
 {
-    Serial.println("在连接状态下初始化完成，保持连接状态");
+    LOG_DEBUG("在连接状态下初始化完成，保持连接状态");
     // 默认处理，不执行状态转换
 }
 
 void Connected::react(RestoreMouseMotionState const &)
 {
-    if (rememberedMouseMotionState)
+    if (SettingsStore::settings().motionEnabled)
     {
-        Serial.println("恢复鼠标运动启用状态");
+        LOG_INFO("恢复鼠标运动启用状态");
         transit<MouseMotionEnable>();
     }
     else
     {
-        Serial.println("保持鼠标运动禁用状态");
+        LOG_INFO("保持鼠标运动禁用状态");
         transit<MouseMotionDisable>();
     }
 }
@@ -413,116 +379,125 @@ void Connected::react(RestoreMouseMotionState const &)
 // MouseMotionDisable状态实现
 void MouseMotionDisable::entry()
 {
-    Serial.println("进入鼠标移动禁用状态");
+    LOG_INFO("进入鼠标移动禁用状态");
+    PowerManager::enterPhase(PowerManager::Phase::MOTION_DISABLED);
     // LED常亮表示已连接，但鼠标移动功能禁用
-    digitalWrite(LED_D4_PIN, HIGH);
-    digitalWrite(LED_D5_PIN, HIGH);
+    LEDController::setMode(LEDController::Mode::ON);
 
-    // 确保鼠标报告不发送移动数据
-    if (inputMouse && deviceConnected)
-    {
-        uint8_t mouseReport[4] = {0, 0, 0, 0}; // 无移动的空报告
-        inputMouse->setValue(mouseReport, sizeof(mouseReport));
-    }
+    // 通知运动任务停止移动并清空报告
+    AppTasks::requestMotion(false);
+
+    // 不发送移动报告时使用长连接间隔和从机延迟
+    ConnParams::request(ConnParams::Profile::ECONOMY);
 }
 
 void MouseMotionDisable::react(BootButtonShortPress const &)
 {
-    Serial.println("在鼠标移动禁用状态下短按按钮，切换到鼠标移动启用状态");
-    rememberedMouseMotionState = true; // 记住鼠标运动已启用
+    LOG_INFO("在鼠标移动禁用状态下短按按钮，切换到鼠标移动启用状态");
+    SettingsStore::setMotionEnabled(true); // 记住鼠标运动已启用，重启后恢复
     transit<MouseMotionEnable>();
 }
 
+void MouseMotionDisable::react(BootButtonDoubleClick const &)
+{
+    cycleReportRate();
+}
+
+void MouseMotionDisable::react(BootButtonTripleClick const &)
+{
+    resetReportRate();
+}
+
 void MouseMotionDisable::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，进入配对模式");
+    LOG_INFO("长按按钮，进入配对模式");
     transit<Pairing>();
 }
 
 void MouseMotionDisable::react(DeviceConnected const &)
 {
-    Serial.println("在鼠标移动禁用状态下接收到设备已连接事件，保持当前状态");
+    LOG_DEBUG("在鼠标移动禁用状态下接收到设备已连接事件，保持当前状态");
     // 默认处理，不执行状态转换
 }
 
 void MouseMotionDisable::react(DeviceDisconnected const &)
 {
-    Serial.println("设备断开连接，进入重连模式");
+    LOG_INFO("设备断开连接，进入重连模式");
     transit<Reconnect>();
 }
 
 void MouseMotionDisable::react(ConnectionTimeout const &)
 {
-    Serial.println("在鼠标移动禁用状态下连接超时，保持当前状态");
+    LOG_DEBUG("在鼠标移动禁用状态下连接超时，保持当前状态");
     // 默认处理，不执行状态转换
 }
 
 void MouseMotionDisable::react(PairingTimeout const &)
 {
-    Serial.println("在鼠标移动禁用状态下配对超时，保持当前状态");
+    LOG_DEBUG("在鼠标移动禁用状态下配对超时，保持当前状态");
     // 默认处理，不执行状态转换
 }
 
 void MouseMotionDisable::react(ConnectionFailed const &)
 {
-    Serial.println("在鼠标移动禁用状态下连接失败，保持当前状态");
+    LOG_DEBUG("在鼠标移动禁用状态下连接失败，保持当前状态");
     // 默认处理，不执行状态转换
 }
 
 void MouseMotionDisable::react(InitComplete const &)
 {
-    Serial.println("在鼠标移动禁用状态下初始化完成，保持当前状态");
+    LOG_DEBUG("在鼠标移动禁用状态下初始化完成，保持当前状态");
     // 默认处理，不执行状态转换
 }
 
 // MouseMotionEnable状态实现
 void MouseMotionEnable::entry()
 {
-    Serial.println("进入鼠标移动启用状态");
-    // 初始化自然移动参数
-    angle = 0;
-    currentVelocityX = 0.0;
-    currentVelocityY = 0.0;
-    targetVelocityX = 0.0;
-    targetVelocityY = 0.0;
-    moveAngle = 0.0;
-    moveRadius = 10.0; // 增大初始移动幅度
-    lastMoveUpdate = millis();
-    patternChangeTimer = millis();
-    patternChangeInterval = 3000; // 每3秒改变移动模式
-    currentPattern = 0;           // 从随机漫步模式开始
-
-    // 初始化移动和停顿控制
-    isMoving = false;
-    inMovePhase = true; // 从移动阶段开始
-    movePhaseTimer = millis();
-    pausePhaseTimer = 0;
-    moveDuration = random(MIN_MOVE_DURATION, MAX_MOVE_DURATION);    // 随机移动时间
-    pauseDuration = random(MIN_PAUSE_DURATION, MAX_PAUSE_DURATION); // 随机停顿时间
-
-    // 初始化安卓拖动问题修复变量
-    lastWasMoving = false;
-    lastReleaseReportTime = 0;
-
-    Serial.println("自然鼠标移动模式已启动，初始移动时长: " + String(moveDuration) + "ms");
+    LOG_INFO("进入鼠标移动启用状态");
+    PowerManager::enterPhase(PowerManager::Phase::MOTION_ENABLED);
+    // LED D4、D5 交替闪烁，每秒2次
+    LEDController::setMode(LEDController::Mode::ALTERNATE);
+    // 通知运动任务重新开始自然移动（模式、速度和移动/停顿周期）
+    AppTasks::requestMotion(true);
+
+    // 请求低延迟连接间隔，使报告节拍接近 10ms 的运动节拍
+    ConnParams::request(ConnParams::Profile::LATENCY);
+
+    LOG_INFO("自然鼠标移动模式已启动");
+}
+
+void MouseMotionEnable::exit()
+{
+    // 离开该状态（断开、配对或禁用）时停止移动
+    AppTasks::requestMotion(false);
 }
 
 void MouseMotionEnable::react(BootButtonLongPress const &)
 {
-    Serial.println("长按按钮，进入配对模式");
+    LOG_INFO("长按按钮，进入配对模式");
     transit<Pairing>();
 }
 
 void MouseMotionEnable::react(BootButtonShortPress const &)
 {
-    Serial.println("在鼠标移动启用状态下短按按钮，切换到鼠标移动禁用状态");
-    rememberedMouseMotionState = false; // 记住鼠标运动已禁用
+    LOG_INFO("在鼠标移动启用状态下短按按钮，切换到鼠标移动禁用状态");
+    SettingsStore::setMotionEnabled(false); // 记住鼠标运动已禁用，重启后恢复
     transit<MouseMotionDisable>();
 }
 
+void MouseMotionEnable::react(BootButtonDoubleClick const &)
+{
+    cycleReportRate();
+}
+
+void MouseMotionEnable::react(BootButtonTripleClick const &)
+{
+    resetReportRate();
+}
+
 void MouseMotionEnable::react(DeviceDisconnected const &)
 {
-    Serial.println("设备断开连接，进入重连模式");
+    LOG_INFO("设备断开连接，进入重连模式");
     transit<Reconnect>();
 }
 
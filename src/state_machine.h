@@ -1,16 +1,16 @@
 #pragma once
 
 #include <tinyfsm.hpp>
-
-// 随机时间范围常量
-const unsigned int MIN_MOVE_DURATION = 1000;   // 最小移动时间 1秒
-const unsigned int MAX_MOVE_DURATION = 4000;   // 最大移动时间 4秒
-const unsigned int MIN_PAUSE_DURATION = 500;   // 最小停顿时间 0.5秒
-const unsigned int MAX_PAUSE_DURATION = 3000;  // 最大停顿时间 3秒
+#include <stdint.h>
 
 // 事件定义
+// 按键手势：派生事件在状态未单独处理时按基类事件处理（双击、三击按短按）；
+// 超长按在按住期间先产生一次长按（进入 Pairing），Pairing 和 Reconnect 用它清除绑定，其他状态不处理，避免长按的动作执行两次
 struct BootButtonShortPress : tinyfsm::Event {};
-struct BootButtonLongPress : tinyfsm::Event {};
+struct BootButtonDoubleClick : BootButtonShortPress {};
+struct BootButtonTripleClick : BootButtonShortPress {};
+struct BootButtonLongPress : tinyfsm::Event {};        // 按住 3 秒
+struct BootButtonVeryLongPress : tinyfsm::Event {};    // 按住 8 秒：清除绑定
 struct DeviceConnected : tinyfsm::Event {};
 struct DeviceDisconnected : tinyfsm::Event {};
 struct ConnectionTimeout : tinyfsm::Event {};
@@ -18,6 +18,8 @@ struct PairingTimeout : tinyfsm::Event {};
 struct ConnectionFailed : tinyfsm::Event {};
 struct InitComplete : tinyfsm::Event {};
 struct RestoreMouseMotionState : tinyfsm::Event {}; // 内部事件：恢复鼠标运动状态
+struct AdvertisingStageTimeout : tinyfsm::Event {}; // 内部事件：广播计划进入下一阶段
+struct AdvertisingRetry : tinyfsm::Event {};        // 内部事件：广播启动失败或意外结束后重新启动
 
 // 基状态类
 class BleMouseState : public tinyfsm::Fsm<BleMouseState> {
@@ -25,7 +27,10 @@ public:
     virtual void entry() {}
     virtual void exit() {}
     virtual void react(BootButtonShortPress const &) {}
+    virtual void react(BootButtonDoubleClick const &event) { react(static_cast<BootButtonShortPress const &>(event)); }
+    virtual void react(BootButtonTripleClick const &event) { react(static_cast<BootButtonShortPress const &>(event)); }
     virtual void react(BootButtonLongPress const &) {}
+    virtual void react(BootButtonVeryLongPress const &) {}
     virtual void react(DeviceConnected const &) {}
     virtual void react(DeviceDisconnected const &) {}
     virtual void react(ConnectionTimeout const &) {}
@@ -33,6 +38,10 @@ public:
     virtual void react(ConnectionFailed const &) {}
     virtual void react(InitComplete const &) {}
     virtual void react(RestoreMouseMotionState const &) {}
+    // 广播计划由启动它的状态拥有，离开该状态时随广播一起结束，所以各状态共用同一个处理
+    virtual void react(AdvertisingStageTimeout const &);
+    // 广播控制器的重试同样与状态无关：需要广播的状态在离开时 stop()，之后到达的重试被忽略
+    virtual void react(AdvertisingRetry const &);
 };
 
 // 状态类定义
@@ -56,34 +65,32 @@ public:
 };
 
 class Reconnect : public BleMouseState {
-private:
-    unsigned long reconnectStartTime;
 public:
     void entry() override;
+    void exit() override;
     void react(DeviceConnected const &) override;
     void react(BootButtonLongPress const &) override;
+    void react(BootButtonVeryLongPress const &) override;
     void react(ConnectionTimeout const &) override;
     void react(ConnectionFailed const &) override;
 private:
     void startReconnection();
-    void checkTimeout();
-    static constexpr unsigned long RECONNECT_TIMEOUT = 30000; // 30秒超时
+    static constexpr uint32_t RECONNECT_TIMEOUT = 30000; // 30秒超时，到期后开始下一个重连窗口
 };
 
 class Pairing : public BleMouseState {
-private:
-    unsigned long pairingStartTime;
 public:
     void entry() override;
+    void exit() override;
     void react(DeviceConnected const &) override;
     void react(DeviceDisconnected const &) override;
     void react(BootButtonLongPress const &) override;
+    void react(BootButtonVeryLongPress const &) override;
     void react(PairingTimeout const &) override;
     void react(ConnectionFailed const &) override;
 private:
     void startPairing();
-    void checkTimeout();
-    static constexpr unsigned long PAIRING_TIMEOUT = 60000; // 60秒超时
+    static constexpr uint32_t PAIRING_TIMEOUT = 60000; // 60秒超时，到期后回到重连
 };
 
 class Connected : public BleMouseState {
@@ -104,6 +111,8 @@ class MouseMotionDisable : public BleMouseState {
 public:
     void entry() override;
     void react(BootButtonShortPress const &) override;
+    void react(BootButtonDoubleClick const &) override;
+    void react(BootButtonTripleClick const &) override;
     void react(BootButtonLongPress const &) override;
     void react(DeviceConnected const &) override;
     void react(DeviceDisconnected const &) override;
@@ -114,11 +123,12 @@ public:
 };
 
 class MouseMotionEnable : public BleMouseState {
-private:
-    static float angle;
 public:
     void entry() override;
+    void exit() override;
     void react(BootButtonShortPress const &) override;
+    void react(BootButtonDoubleClick const &) override;
+    void react(BootButtonTripleClick const &) override;
     void react(BootButtonLongPress const &) override;
     void react(DeviceDisconnected const &) override;
 };
@@ -0,0 +1,109 @@
+#include "timer_service.h"
+#include "logger.h"
+
+struct TimerSlot {
+    const char *name;
+    EventQueue::EventId event;
+    esp_timer_handle_t handle;
+    uint64_t deadlineUs;   // 仅调用 arm() 的任务读写
+    TimerService::TimerStats stats;
+};
+
+static const uint64_t RETRY_US = 10000;
+
+static TimerSlot slots[(int)TimerService::TimerId::COUNT] = {
+    {"pairing_timeout", EventQueue::EventId::PAIRING_TIMEOUT, nullptr, 0, {}},
+    {"reconnect_timeout", EventQueue::EventId::CONNECTION_TIMEOUT, nullptr, 0, {}},
+    {"adv_stage", EventQueue::EventId::ADVERTISING_STAGE_TIMEOUT, nullptr, 0, {}},
+    {"adv_retry", EventQueue::EventId::ADVERTISING_RETRY, nullptr, 0, {}},
+};
+
+void TimerService::begin()
+{
+    for (int i = 0; i < (int)TimerId::COUNT; i++)
+    {
+        if (slots[i].handle)
+        {
+            continue;
+        }
+        esp_timer_create_args_t args = {};
+        args.callback = onExpire;
+        args.arg = &slots[i];
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = slots[i].name;
+        if (esp_timer_create(&args, &slots[i].handle) != ESP_OK)
+        {
+            LOG_ERROR("创建定时器 %s 失败", slots[i].name);
+        }
+    }
+}
+
+void TimerService::arm(TimerId id, uint32_t timeoutMs)
+{
+    TimerSlot &slot = slots[(int)id];
+    if (!slot.handle)
+    {
+        LOG_ERROR("定时器 %s 未创建", slot.name);
+        return;
+    }
+    esp_timer_stop(slot.handle); // 未运行时返回 ESP_ERR_INVALID_STATE，忽略
+    slot.deadlineUs = esp_timer_get_time() + (uint64_t)timeoutMs * 1000;
+    esp_timer_start_once(slot.handle, (uint64_t)timeoutMs * 1000);
+    slot.stats.armed++;
+}
+
+void TimerService::cancel(TimerId id)
+{
+    TimerSlot &slot = slots[(int)id];
+    if (slot.handle && esp_timer_stop(slot.handle) == ESP_OK)
+    {
+        slot.stats.cancelled++;
+    }
+}
+
+bool TimerService::active(TimerId id)
+{
+    TimerSlot &slot = slots[(int)id];
+    return slot.handle && esp_timer_is_active(slot.handle);
+}
+
+uint32_t TimerService::remainingMs(TimerId id)
+{
+    if (!active(id))
+    {
+        return 0;
+    }
+    int64_t remainingUs = (int64_t)slots[(int)id].deadlineUs - esp_timer_get_time();
+    return remainingUs > 0 ? (uint32_t)((remainingUs + 999) / 1000) : 0;
+}
+
+// 在 esp_timer 任务中调用，只投递事件；队列满时稍后重试，超时事件不能丢失
+void TimerService::onExpire(void *arg)
+{
+    TimerSlot &slot = *(TimerSlot *)arg;
+    if (!EventQueue::post(slot.event))
+    {
+        slot.stats.retries++;
+        esp_timer_start_once(slot.handle, RETRY_US);
+        return;
+    }
+    slot.stats.expired++;
+}
+
+TimerService::TimerStats TimerService::stats(TimerId id)
+{
+    return slots[(int)id].stats;
+}
+
+void TimerService::resetStats()
+{
+    for (TimerSlot &slot : slots)
+    {
+        slot.stats = TimerStats();
+    }
+}
+
+const char *TimerService::name(TimerId id)
+{
+    return (int)id < (int)TimerId::COUNT ? slots[(int)id].name : "?";
+}
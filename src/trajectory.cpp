@@ -0,0 +1,173 @@
+#include "trajectory.h"
+#include <string.h>
+
+static const uint8_t MAGIC[4] = {'M', 'T', 'R', 'J'};
+
+bool Trajectory::parseHeader(const uint8_t *data, size_t length, Header &header)
+{
+    if (length < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        return false;
+    }
+    memcpy(header.magic, data, sizeof(MAGIC));
+    header.version = data[4];
+    header.reserved = data[5];
+    header.unitUs = (uint16_t)(data[6] | data[7] << 8);
+    header.length = (uint32_t)data[8] | (uint32_t)data[9] << 8 | (uint32_t)data[10] << 16 | (uint32_t)data[11] << 24;
+    return header.version == VERSION && header.unitUs != 0;
+}
+
+void Trajectory::writeHeader(const Header &header, uint8_t *out)
+{
+    memcpy(out, MAGIC, sizeof(MAGIC));
+    out[4] = header.version;
+    out[5] = header.reserved;
+    out[6] = (uint8_t)header.unitUs;
+    out[7] = (uint8_t)(header.unitUs >> 8);
+    for (int i = 0; i < 4; i++)
+    {
+        out[8 + i] = (uint8_t)(header.length >> (8 * i));
+    }
+}
+
+// 读取 varint：返回消耗的字节数，不完整返回 0，超过 5 字节返回 -1
+static int readVarint(const uint8_t *data, size_t length, uint32_t &value)
+{
+    value = 0;
+    for (size_t i = 0; i < 5; i++)
+    {
+        if (i >= length)
+        {
+            return 0;
+        }
+        value |= (uint32_t)(data[i] & 0x7F) << (7 * i);
+        if (!(data[i] & 0x80))
+        {
+            return (int)i + 1;
+        }
+    }
+    return -1;
+}
+
+int Trajectory::decodeRecord(const uint8_t *data, size_t length, Record &record)
+{
+    uint32_t head;
+    int used = readVarint(data, length, head);
+    if (used <= 0)
+    {
+        return used;
+    }
+    record.kind = (Kind)(head & 3);
+    record.dt = head >> 2;
+    switch (record.kind)
+    {
+    case DELTA:
+        if ((size_t)used + 2 > length)
+        {
+            return 0;
+        }
+        record.dx = (int8_t)data[used];
+        record.dy = (int8_t)data[used + 1];
+        return used + 2;
+    case REPEAT:
+    {
+        int countUsed = readVarint(data + used, length - used, record.count);
+        if (countUsed <= 0)
+        {
+            return countUsed;
+        }
+        return record.count ? used + countUsed : -1;
+    }
+    case END:
+        return used;
+    default:
+        return -1;
+    }
+}
+
+Trajectory::Encoder::Encoder(uint8_t *buffer, size_t capacity, uint16_t unitUs)
+    : out(buffer), capacity(capacity), used(HEADER_SIZE), overflow(capacity < HEADER_SIZE), unit(unitUs),
+      lastUnits(0), lastDt(0), lastDx(0), lastDy(0), repeatCount(0), hasLast(false), counters()
+{
+}
+
+// 时间按绝对时刻量化到时间单位，dt 的舍入误差不会累积
+void Trajectory::Encoder::add(uint32_t timeUs, int8_t dx, int8_t dy)
+{
+    if (dx == 0 && dy == 0)
+    {
+        return;
+    }
+    counters.samples++;
+    uint32_t units = (timeUs + unit / 2) / unit;
+    uint32_t dt = units - lastUnits;
+    lastUnits = units;
+
+    if (hasLast && repeatCount < 0xFFFF && dt == lastDt && dx == lastDx && dy == lastDy)
+    {
+        repeatCount++;
+        return;
+    }
+    flushRepeat();
+    putVarint(dt << 2 | DELTA);
+    putByte((uint8_t)dx);
+    putByte((uint8_t)dy);
+    counters.deltas++;
+    lastDt = dt;
+    lastDx = dx;
+    lastDy = dy;
+    hasLast = true;
+}
+
+// 只重复一次时直接写 DELTA 更短
+void Trajectory::Encoder::flushRepeat()
+{
+    if (repeatCount == 1)
+    {
+        putVarint(lastDt << 2 | DELTA);
+        putByte((uint8_t)lastDx);
+        putByte((uint8_t)lastDy);
+        counters.deltas++;
+    }
+    else if (repeatCount > 1)
+    {
+        putVarint(lastDt << 2 | REPEAT);
+        putVarint(repeatCount);
+        counters.repeats++;
+    }
+    repeatCount = 0;
+}
+
+size_t Trajectory::Encoder::finish(uint32_t endUs)
+{
+    flushRepeat();
+    uint32_t endUnits = (endUs + unit / 2) / unit;
+    putVarint((endUnits > lastUnits ? endUnits - lastUnits : 0) << 2 | END);
+    if (overflow)
+    {
+        return 0;
+    }
+    Header header = {{0}, VERSION, 0, unit, (uint32_t)(used - HEADER_SIZE)};
+    writeHeader(header, out);
+    return used;
+}
+
+void Trajectory::Encoder::putByte(uint8_t value)
+{
+    if (used >= capacity)
+    {
+        overflow = true;
+        return;
+    }
+    out[used++] = value;
+}
+
+void Trajectory::Encoder::putVarint(uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        putByte((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    putByte((uint8_t)value);
+}
@@ -0,0 +1,259 @@
+#include "trajectory_player.h"
+#include <string.h>
+
+TrajectoryPlayer::TrajectoryPlayer()
+    : read(nullptr), context(nullptr), header(), opened(false), failed(false), loadIndex(0), loadOffset(0),
+      readIndex(0), readPos(0), lastStepUs(0), playUs(0), eventUs(0), pending(), hasPending(false), repeatLeft(0),
+      repeatDt(0), lastDx(0), lastDy(0), carryX(0), carryY(0), counters()
+{
+    for (Block &block : blocks)
+    {
+        block.length = 0;
+        block.last = false;
+        block.ready = false;
+    }
+}
+
+bool TrajectoryPlayer::open(ReadFunction readFunction, void *readContext, uint32_t capacity)
+{
+    close();
+    uint8_t raw[Trajectory::HEADER_SIZE];
+    if (!readFunction || capacity < Trajectory::HEADER_SIZE ||
+        readFunction(0, raw, sizeof(raw), readContext) != sizeof(raw) ||
+        !Trajectory::parseHeader(raw, sizeof(raw), header) || header.length == 0 ||
+        header.length > capacity - Trajectory::HEADER_SIZE)
+    {
+        header = Trajectory::Header();
+        return false;
+    }
+    read = readFunction;
+    context = readContext;
+    opened = true;
+    fill();
+    return true;
+}
+
+void TrajectoryPlayer::close()
+{
+    opened = false;
+    failed = false;
+    for (Block &block : blocks)
+    {
+        block.ready = false;
+    }
+    loadIndex = 0;
+    loadOffset = 0;
+    readIndex = 0;
+    readPos = 0;
+    playUs = 0;
+    eventUs = 0;
+    hasPending = false;
+    repeatLeft = 0;
+    lastDx = 0;
+    lastDy = 0;
+    carryX = 0;
+    carryY = 0;
+    counters = Stats();
+}
+
+void TrajectoryPlayer::fill()
+{
+    if (!opened)
+    {
+        return;
+    }
+    for (;;)
+    {
+        Block &block = blocks[loadIndex & 1];
+        if (block.ready.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        uint32_t remaining = header.length - loadOffset;
+        size_t length = remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+        if (read(Trajectory::HEADER_SIZE + loadOffset, block.data, length, context) != length)
+        {
+            counters.readErrors++;
+            return;
+        }
+        block.length = (uint16_t)length;
+        block.last = loadOffset + length == header.length;
+        loadOffset = block.last ? 0 : loadOffset + length;
+        loadIndex++;
+        counters.blocks++;
+        block.ready.store(true, std::memory_order_release);
+    }
+}
+
+bool TrajectoryPlayer::needsFill() const
+{
+    return opened && (!blocks[0].ready.load(std::memory_order_relaxed) ||
+                      !blocks[1].ready.load(std::memory_order_relaxed));
+}
+
+// 当前块已解码完，交还给生产者
+void TrajectoryPlayer::release()
+{
+    blocks[readIndex & 1].ready.store(false, std::memory_order_release);
+    readIndex++;
+    readPos = 0;
+}
+
+// 解码下一条记录；跨块的记录先拼接到临时缓冲区，下一个块未就绪时返回 false 且不移动位置
+bool TrajectoryPlayer::fetch(Trajectory::Record &record)
+{
+    Block &current = blocks[readIndex & 1];
+    if (!current.ready.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    size_t available = current.length - readPos;
+    int used;
+    if (available >= Trajectory::MAX_RECORD_SIZE || current.last)
+    {
+        used = Trajectory::decodeRecord(current.data + readPos, available, record);
+        if (used <= 0)
+        {
+            failed = true;   // 最后一块中不完整的记录也是格式错误
+            counters.formatErrors++;
+            return false;
+        }
+        readPos += used;
+        if (readPos == current.length)
+        {
+            release();
+        }
+    }
+    else
+    {
+        Block &next = blocks[(readIndex + 1) & 1];
+        if (!next.ready.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        uint8_t joined[Trajectory::MAX_RECORD_SIZE];
+        size_t fromNext = Trajectory::MAX_RECORD_SIZE - available;
+        fromNext = fromNext < next.length ? fromNext : next.length;
+        memcpy(joined, current.data + readPos, available);
+        memcpy(joined + available, next.data, fromNext);
+        used = Trajectory::decodeRecord(joined, available + fromNext, record);
+        if (used <= 0)
+        {
+            failed = true;
+            counters.formatErrors++;
+            return false;
+        }
+        if ((size_t)used < available)
+        {
+            readPos += used;
+        }
+        else
+        {
+            release();
+            readPos = (uint16_t)(used - available);
+            if (readPos == next.length)
+            {
+                release();   // 记录正好结束在下一块的末尾（最后一块很短时）
+            }
+        }
+    }
+    // END 之后必须正好是记录区的末尾
+    if (record.kind == Trajectory::END && readPos != 0)
+    {
+        failed = true;
+        counters.formatErrors++;
+        return false;
+    }
+    return true;
+}
+
+void TrajectoryPlayer::resume(uint32_t nowUs)
+{
+    lastStepUs = nowUs;
+}
+
+TrajectoryPlayer::Output TrajectoryPlayer::step(uint32_t nowUs)
+{
+    Output output = {0, 0};
+    if (!opened || failed)
+    {
+        return output;
+    }
+    uint32_t elapsedUs = nowUs - lastStepUs;
+    lastStepUs = nowUs;
+    // 下一条记录还没读入：播放时间不前进，就绪后从这里继续，不会集中补发
+    if (!repeatLeft && !hasPending)
+    {
+        if (!fetch(pending))
+        {
+            counters.underruns += failed ? 0 : 1;
+            return output;
+        }
+        hasPending = true;
+    }
+    playUs += elapsedUs < MAX_STEP_US ? elapsedUs : MAX_STEP_US;
+
+    int32_t sumX = carryX;
+    int32_t sumY = carryY;
+    const uint32_t unit = header.unitUs;
+    for (;;)
+    {
+        if (repeatLeft)
+        {
+            uint64_t dueUs = eventUs + (uint64_t)repeatDt * unit;
+            if (dueUs > playUs)
+            {
+                break;
+            }
+            eventUs = dueUs;
+            sumX += lastDx;
+            sumY += lastDy;
+            repeatLeft--;
+            continue;
+        }
+        if (!hasPending)
+        {
+            if (!fetch(pending))
+            {
+                break;   // 下一次 step() 时再读取
+            }
+            hasPending = true;
+        }
+        uint64_t dueUs = eventUs + (uint64_t)pending.dt * unit;
+        if (dueUs > playUs)
+        {
+            break;
+        }
+        hasPending = false;
+        counters.records++;
+        if (pending.kind == Trajectory::END)
+        {
+            // 一遍结束：以循环点为新一遍的零点
+            playUs -= dueUs;
+            eventUs = 0;
+            counters.loops++;
+            continue;
+        }
+        eventUs = dueUs;
+        if (pending.kind == Trajectory::DELTA)
+        {
+            lastDx = pending.dx;
+            lastDy = pending.dy;
+        }
+        else
+        {
+            repeatLeft = pending.count - 1;
+            repeatDt = pending.dt;
+        }
+        sumX += lastDx;
+        sumY += lastDy;
+    }
+
+    int32_t outX = sumX > 127 ? 127 : (sumX < -127 ? -127 : sumX);
+    int32_t outY = sumY > 127 ? 127 : (sumY < -127 ? -127 : sumY);
+    carryX = sumX - outX;
+    carryY = sumY - outY;
+    output.dx = (int8_t)outX;
+    output.dy = (int8_t)outY;
+    return output;
+}
@@ -0,0 +1,77 @@
+#include "tremor.h"
+#include "fixed_point.h"
+
+using namespace fixed;
+
+// 梯度表：±1/8 ~ ±1 均匀分布，不含 0（0 梯度会让该晶格点附近的输出长时间为零）
+static const int16_t GRADIENTS[16] = {
+    -32767, -28672, -24576, -20480, -16384, -12288, -8192, -4096,
+    4096,   8192,   12288,  16384,  20480,  24576,  28672,  32767,
+};
+
+// 晶格序号与种子的整数哈希，取高 4 位作为梯度表下标
+static int32_t gradient(uint32_t index, uint32_t seed)
+{
+    uint32_t h = index * 0x9E3779B1u ^ seed;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return GRADIENTS[h >> 28];
+}
+
+// 1D Perlin：n(f) = lerp(g0·f, g1·(f − 1), fade)，最大值 0.5，乘 2 归一到 [-1, 1]（Q15）
+static int32_t interpolate(const int32_t gradients[2], int32_t f, int32_t fade)
+{
+    int32_t a = (gradients[0] * f) >> 16;
+    int32_t b = (gradients[1] * (f - Q16_ONE)) >> 16;
+    int32_t n = 2 * (a + (int32_t)(((int64_t)(b - a) * fade) >> 16));
+    return n > Q15_MAX ? Q15_MAX : (n < -Q15_MAX ? -Q15_MAX : n);
+}
+
+Tremor::Tremor() : Tremor(Config()) {}
+
+Tremor::Tremor(const Config &config)
+{
+    setConfig(config);
+    seed(0);
+}
+
+void Tremor::setConfig(const Config &config)
+{
+    cfg = config;
+    amplitudeQ16 = toQ16(config.amplitude);
+    ratePerUs = (uint32_t)(config.frequency * 4294.967296f + 0.5f);   // 2^32 / 10^6
+}
+
+void Tremor::seed(uint32_t value)
+{
+    seedX = value * 0x85EBCA6Bu + 0x27D4EB2Fu;
+    seedY = value * 0xC2B2AE35u + 0x165667B1u;
+    reset();
+}
+
+void Tremor::loadCell(uint32_t index)
+{
+    cell = index;
+    cellValid = true;
+    gradientX[0] = gradient(index, seedX);
+    gradientX[1] = gradient(index + 1, seedX);
+    gradientY[0] = gradient(index, seedY);
+    gradientY[1] = gradient(index + 1, seedY);
+}
+
+Tremor::Sample Tremor::step(uint32_t dtUs)
+{
+    phase += (uint64_t)ratePerUs * dtUs;
+    uint32_t index = (uint32_t)(phase >> 32);
+    if (!cellValid || index != cell)
+    {
+        loadCell(index);
+    }
+    int32_t f = (int32_t)((phase >> 16) & 0xFFFF);   // 晶格内的位置，Q16
+    int32_t fade = smootherStepQ16(f);
+    Sample sample;
+    sample.x = mulQ15(amplitudeQ16, (int16_t)interpolate(gradientX, f, fade));
+    sample.y = mulQ15(amplitudeQ16, (int16_t)interpolate(gradientY, f, fade));
+    return sample;
+}
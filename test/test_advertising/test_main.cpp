@@ -0,0 +1,97 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include "../../src/state_machine.h"
+#include "../../include/advertising_controller.h"
+#include "../../include/app_tasks.h"
+#include "../../include/event_queue.h"
+#include "../../include/logger.h"
+#include "../../include/timer_service.h"
+
+// 广播控制器：启动失败后的重试经 AdvertisingRetry 事件在状态机中完成，与 stop() 不会交错
+
+typedef EventQueue::EventId EventId;
+
+// 以 10ms 为步长推进虚拟时间，每步由后台任务分发
+static void runForMs(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += 10)
+    {
+        hostsim::advanceMillis(10);
+        AppTasks::housekeepingStep(0);
+    }
+    Logger::drain();
+}
+
+void setUp()
+{
+    hostsim::reset();
+    setup(); // InitComplete -> Reconnect
+    EventQueue::resetStats();
+    AdvertisingController::resetStats();
+    Logger::drain();
+}
+
+void tearDown()
+{
+    EventQueue::clear();
+    Logger::drain();
+}
+
+// 协议栈忙：前 3 次启动失败，每 RETRY_MS 重试一次，期间状态机照常分发
+static void test_busy_start_retried()
+{
+    hostsim::failAdvertisingStarts(3);
+    EventQueue::post(EventId::BOOT_LONG_PRESS);
+    runForMs(10);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_FALSE(AdvertisingController::advertising());
+    TEST_ASSERT_TRUE(TimerService::active(TimerService::TimerId::ADVERTISING_RETRY));
+
+    runForMs(4 * AdvertisingController::RETRY_MS);
+    TEST_ASSERT_TRUE(AdvertisingController::advertising());
+    TEST_ASSERT_EQUAL_UINT32(3, AdvertisingController::stats().retries);
+    TEST_ASSERT_EQUAL_UINT32(3, EventQueue::stats().events[(int)EventId::ADVERTISING_RETRY].dispatched);
+    TEST_ASSERT_FALSE(TimerService::active(TimerService::TimerId::ADVERTISING_RETRY));
+}
+
+// 重试事件已经投递、尚未分发时 stop()：分发时不再启动广播
+static void test_stop_before_retry_dispatched()
+{
+    hostsim::failAdvertisingStarts(1);
+    EventQueue::post(EventId::BOOT_LONG_PRESS);
+    runForMs(10);
+    TEST_ASSERT_FALSE(AdvertisingController::advertising());
+
+    hostsim::advanceMillis(AdvertisingController::RETRY_MS);   // 定时器到期，只投递事件
+    TEST_ASSERT_FALSE(AdvertisingController::advertising());
+    AdvertisingController::stop();
+    AppTasks::housekeepingStep(0);
+    Logger::drain();
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue::stats().events[(int)EventId::ADVERTISING_RETRY].dispatched);
+    TEST_ASSERT_FALSE(AdvertisingController::advertising());
+    TEST_ASSERT_EQUAL_UINT32(0, AdvertisingController::stats().retries);
+}
+
+// stop() 取消尚未到期的重试
+static void test_stop_cancels_pending_retry()
+{
+    hostsim::failAdvertisingStarts(1);
+    EventQueue::post(EventId::BOOT_LONG_PRESS);
+    runForMs(10);
+    TEST_ASSERT_TRUE(TimerService::active(TimerService::TimerId::ADVERTISING_RETRY));
+    AdvertisingController::stop();
+    TEST_ASSERT_FALSE(TimerService::active(TimerService::TimerId::ADVERTISING_RETRY));
+    runForMs(100);
+    TEST_ASSERT_FALSE(AdvertisingController::advertising());
+    TEST_ASSERT_EQUAL_UINT32(0, EventQueue::stats().events[(int)EventId::ADVERTISING_RETRY].dispatched);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_busy_start_retried);
+    RUN_TEST(test_stop_before_retry_dispatched);
+    RUN_TEST(test_stop_cancels_pending_retry);
+    return UNITY_END();
+}
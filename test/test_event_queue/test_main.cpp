@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../../src/state_machine.h"
+#include "../../include/event_queue.h"
+#include "../../include/logger.h"
+
+// 状态机事件队列：容量、满时丢弃计数，以及多个生产者线程并发投递时不丢失、不重复
+// 选用的事件在 Reconnect 状态下都不引起状态转换，只检验队列本身
+
+typedef EventQueue::EventId EventId;
+
+void setUp()
+{
+    hostsim::reset();
+    setup(); // InitComplete -> Reconnect
+    EventQueue::dispatchAll();
+    EventQueue::resetStats();
+    Logger::drain();
+}
+
+void tearDown()
+{
+    hostsim::setRealTime(false);
+    EventQueue::clear();
+    Logger::resetStats();
+    Logger::drain();
+}
+
+// 容量为 QUEUE_SIZE：再投递一个失败并计入 dropped，分发后又可以投递
+static void test_full_queue_drops()
+{
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    for (size_t i = 0; i < EventQueue::QUEUE_SIZE; i++)
+    {
+        TEST_ASSERT_TRUE(EventQueue::post(EventId::PAIRING_TIMEOUT));
+    }
+    TEST_ASSERT_FALSE(EventQueue::post(EventId::PAIRING_TIMEOUT));
+    EventQueue::Stats stats = EventQueue::stats();
+    TEST_ASSERT_EQUAL_UINT32(EventQueue::QUEUE_SIZE, stats.posted);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dropped);
+
+    TEST_ASSERT_EQUAL_UINT32(EventQueue::QUEUE_SIZE, EventQueue::dispatchAll());
+    TEST_ASSERT_TRUE(EventQueue::post(EventId::PAIRING_TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue::dispatchAll());
+    stats = EventQueue::stats();
+    TEST_ASSERT_EQUAL_UINT32(EventQueue::QUEUE_SIZE + 1, stats.events[(int)EventId::PAIRING_TIMEOUT].dispatched);
+    TEST_ASSERT_EQUAL_UINT32(EventQueue::QUEUE_SIZE, stats.maxDepth);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+}
+
+// 4 个生产者线程各投递一种事件，队列满时让出 CPU 后重试，测试线程作为唯一消费者持续分发：
+// 每种事件的分发数必须等于投递数，队列满只导致重试
+static void test_concurrent_producers()
+{
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    const EventId ids[] = {
+        EventId::BOOT_SHORT_PRESS,
+        EventId::DEVICE_DISCONNECTED,
+        EventId::PAIRING_TIMEOUT,
+        EventId::INIT_COMPLETE,
+    };
+    const int producers = sizeof(ids) / sizeof(ids[0]);
+    const uint32_t perProducer = 20000;
+
+    hostsim::setRealTime(true);
+    std::atomic<int> running(producers);
+    std::vector<uint32_t> accepted(producers, 0);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+                             {
+                                 for (uint32_t i = 0; i < perProducer; i++)
+                                 {
+                                     while (!EventQueue::post(ids[p]))
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                     accepted[p]++;
+                                 }
+                                 running--; });
+    }
+    while (running.load() > 0)
+    {
+        EventQueue::dispatchAll();
+        Logger::drain();
+    }
+    EventQueue::dispatchAll();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    hostsim::setRealTime(false);
+
+    EventQueue::Stats stats = EventQueue::stats();
+    for (int p = 0; p < producers; p++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(perProducer, accepted[p]);
+        TEST_ASSERT_EQUAL_UINT32(accepted[p], stats.events[(int)ids[p]].dispatched);
+    }
+    TEST_ASSERT_EQUAL_UINT32(producers * perProducer, stats.posted);
+    TEST_ASSERT_EQUAL_UINT32(stats.posted, stats.dispatched);
+    TEST_ASSERT_LESS_OR_EQUAL(EventQueue::QUEUE_SIZE, stats.maxDepth);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_full_queue_drops);
+    RUN_TEST(test_concurrent_producers);
+    return UNITY_END();
+}
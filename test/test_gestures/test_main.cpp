@@ -0,0 +1,133 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include "../../src/state_machine.h"
+#include "../../include/app_tasks.h"
+#include "../../include/advertising_schedule.h"
+#include "../../include/button_engine.h"
+#include "../../include/event_queue.h"
+#include "../../include/logger.h"
+#include "../../include/reconnect_strategy.h"
+#include "../../include/timer_service.h"
+#include <NimBLEDevice.h>
+
+// 按键手势到状态转换：超长按不再重复长按的动作，在配对和重连中清除绑定
+
+typedef EventQueue::EventId EventId;
+
+// 以 100ms 为步长推进虚拟时间，每步由后台任务分发到期事件
+static void runForMs(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += 100)
+    {
+        hostsim::advanceMillis(ms - elapsed < 100 ? ms - elapsed : 100);
+        AppTasks::housekeepingStep(0);
+    }
+    Logger::drain();
+}
+
+static void postAndDispatch(EventId id)
+{
+    EventQueue::post(id);
+    AppTasks::housekeepingStep(0);
+    Logger::drain();
+}
+
+// 从已连接、未开启移动开始
+void setUp()
+{
+    hostsim::reset();
+    setup();
+    ReconnectStrategy::resetStats();
+    hostsim::connect();
+    AppTasks::housekeepingStep(0);
+    Logger::drain();
+}
+
+void tearDown()
+{
+    hostsim::disconnect();
+    AppTasks::housekeepingStep(0);
+    EventQueue::clear();
+    Logger::drain();
+}
+
+// 按住 8 秒：3 秒时的长按进入配对，8 秒时的超长按清除绑定并重新开始配对计时，
+// 配对超时后的重连使用公开广播
+static void test_very_long_press_forgets_bonds()
+{
+    hostsim::setBonded(true);
+    postAndDispatch(EventId::BOOT_LONG_PRESS);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+
+    runForMs(5000);
+    postAndDispatch(EventId::BOOT_VERY_LONG_PRESS);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_EQUAL_INT(0, NimBLEDevice::getNumBonds());
+    TEST_ASSERT_FALSE(NimBLEDevice::onWhiteList(hostsim::bondedAddress()));
+    TEST_ASSERT_EQUAL_UINT32(1, ReconnectStrategy::stats().forgotten);
+    TEST_ASSERT_GREATER_THAN(59000, TimerService::remainingMs(TimerService::TimerId::PAIRING_TIMEOUT));
+
+    runForMs(60000);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_TRUE(AdvertisingSchedule::schedule() == AdvertisingSchedule::ScheduleId::RECONNECT_OPEN);
+}
+
+// 长按事件丢失时，重连中的超长按同样清除绑定并进入配对
+static void test_very_long_press_in_reconnect()
+{
+    hostsim::setBonded(true);
+    hostsim::disconnect();
+    AppTasks::housekeepingStep(0);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_TRUE(AdvertisingSchedule::schedule() == AdvertisingSchedule::ScheduleId::RECONNECT_BONDED);
+
+    postAndDispatch(EventId::BOOT_VERY_LONG_PRESS);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_EQUAL_INT(0, NimBLEDevice::getNumBonds());
+    TEST_ASSERT_EQUAL_UINT32(0, NimBLEDevice::getWhiteListCount());
+}
+
+// 已连接时单独的超长按不处理
+static void test_very_long_press_alone_is_ignored()
+{
+    bool motion = BleMouseState::is_in_state<MouseMotionEnable>();
+    TEST_ASSERT_TRUE(motion || BleMouseState::is_in_state<MouseMotionDisable>());
+    postAndDispatch(EventId::BOOT_VERY_LONG_PRESS);
+    TEST_ASSERT_FALSE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<MouseMotionEnable>() == motion);
+}
+
+// 浅睡眠唤醒：按键中断安装后引脚仍是电平触发并允许唤醒，松开时等低电平、按下时等高电平；
+// 带抖动的按下和松开仍各识别一次，按住 3 秒产生长按
+static void test_wakeup_level_follows_button()
+{
+    TEST_ASSERT_EQUAL_INT(LOW, hostsim::gpioWakeupLevel(BOOT_BUTTON_PIN));
+    ButtonEngine::resetStats();
+
+    hostsim::bouncePin(BOOT_BUTTON_PIN, LOW, 4, 3000);
+    hostsim::advanceMillis(50);
+    TEST_ASSERT_TRUE(ButtonEngine::pressed());
+    TEST_ASSERT_EQUAL_INT(HIGH, hostsim::gpioWakeupLevel(BOOT_BUTTON_PIN));
+
+    hostsim::advanceMillis(ButtonEngine::HOLD_LEVELS_MS[0]);
+    hostsim::bouncePin(BOOT_BUTTON_PIN, HIGH, 4, 3000);
+    hostsim::advanceMillis(50);
+    TEST_ASSERT_FALSE(ButtonEngine::pressed());
+    TEST_ASSERT_EQUAL_INT(LOW, hostsim::gpioWakeupLevel(BOOT_BUTTON_PIN));
+
+    ButtonEngine::Stats stats = ButtonEngine::stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.transitions);
+    TEST_ASSERT_EQUAL_UINT32(18, stats.edges);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.gestures[(int)ButtonEngine::Gesture::LONG_PRESS]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_very_long_press_forgets_bonds);
+    RUN_TEST(test_very_long_press_in_reconnect);
+    RUN_TEST(test_very_long_press_alone_is_ignored);
+    RUN_TEST(test_wakeup_level_follows_button);
+    return UNITY_END();
+}
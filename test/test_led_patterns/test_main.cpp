@@ -0,0 +1,140 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include "../../include/led_controller.h"
+
+// LED 图案：播放 10s 后把 LEDC 时间线与图案表逐步比对，每步的开始时间、目标占空比和渐变时间都要一致
+
+typedef LEDController::Mode Mode;
+
+static const uint32_t RUN_MS = 10000;
+
+static uint32_t toDuty(uint8_t brightness)
+{
+    return ((uint32_t)brightness << 2) | (brightness >> 6);
+}
+
+// 一次性推进虚拟时钟（相当于期间没有任何任务运行），之后逐个引脚检查时间线
+static void checkTimeline(const LEDController::Pattern &pattern, uint64_t startUs)
+{
+    hostsim::advanceMillis(RUN_MS);
+
+    // 在 RUN_MS 内开始（含终点）的步骤数
+    uint32_t expectedSteps = 1;
+    uint64_t elapsedMs = 0;
+    while (pattern.count > 1)
+    {
+        elapsedMs += pattern.steps[(expectedSteps - 1) % pattern.count].durationMs;
+        if (elapsedMs > RUN_MS)
+        {
+            break;
+        }
+        expectedSteps++;
+    }
+
+    const uint8_t pins[] = {LED_D4_PIN, LED_D5_PIN};
+    for (uint8_t pin : pins)
+    {
+        uint64_t expectedUs = startUs;
+        uint32_t steps = 0;
+        for (size_t i = 0; i < hostsim::ledcEventCount(); i++)
+        {
+            hostsim::LedcEvent event = hostsim::ledcEvent(i);
+            if (event.pin != pin)
+            {
+                continue;
+            }
+            const LEDController::Step &step = pattern.steps[steps % pattern.count];
+            TEST_ASSERT_EQUAL_UINT32(expectedUs, event.timeUs);
+            TEST_ASSERT_EQUAL_UINT32(toDuty(pin == LED_D4_PIN ? step.d4 : step.d5), event.targetDuty);
+            TEST_ASSERT_EQUAL_UINT32(step.fade ? step.durationMs : 0u, event.fadeMs);
+            expectedUs += step.durationMs * 1000ull;
+            steps++;
+        }
+        TEST_ASSERT_EQUAL_UINT32(expectedSteps, steps);
+    }
+}
+
+static void checkMode(Mode mode)
+{
+    uint64_t startUs = hostsim::nowMicros();
+    LEDController::setMode(mode);
+    TEST_ASSERT_TRUE(LEDController::getMode() == mode);
+    checkTimeline(LEDController::pattern(mode), startUs);
+}
+
+void setUp()
+{
+    hostsim::reset();
+    LEDController::init();
+    hostsim::clearLedcTimeline();
+}
+
+void tearDown() {}
+
+static void test_off() { checkMode(Mode::OFF); }
+static void test_on() { checkMode(Mode::ON); }
+static void test_slow_blink() { checkMode(Mode::SLOW_BLINK); }
+static void test_fast_blink() { checkMode(Mode::FAST_BLINK); }
+static void test_alternate() { checkMode(Mode::ALTERNATE); }
+static void test_heartbeat() { checkMode(Mode::HEARTBEAT); }
+
+// 切换模式时从新图案的第一步开始，旧图案的步骤定时器不再触发
+static void test_switch_restarts_pattern()
+{
+    LEDController::setMode(Mode::HEARTBEAT);
+    hostsim::advanceMillis(170);
+    hostsim::clearLedcTimeline();
+    checkMode(Mode::SLOW_BLINK);
+}
+
+// 自定义步骤有自己的模式，不冒充 SLOW_BLINK/ALTERNATE/ON
+static void test_custom_blink()
+{
+    uint64_t startUs = hostsim::nowMicros();
+    LEDController::blinkSync(200);
+    TEST_ASSERT_TRUE(LEDController::getMode() == Mode::CUSTOM);
+    const LEDController::Pattern &pattern = LEDController::pattern(Mode::CUSTOM);
+    TEST_ASSERT_EQUAL_UINT32(2, pattern.count);
+    TEST_ASSERT_EQUAL_UINT32(200, pattern.steps[0].durationMs);
+    checkTimeline(pattern, startUs);
+}
+
+static void test_custom_alternate()
+{
+    uint64_t startUs = hostsim::nowMicros();
+    LEDController::blinkAlternate(150);
+    TEST_ASSERT_TRUE(LEDController::getMode() == Mode::CUSTOM);
+    checkTimeline(LEDController::pattern(Mode::CUSTOM), startUs);
+}
+
+// setState() 停止图案：之后只有一次设置，没有步骤回调
+static void test_custom_state()
+{
+    LEDController::blinkAlternate(100);
+    hostsim::advanceMillis(50);
+    hostsim::clearLedcTimeline();
+    uint64_t startUs = hostsim::nowMicros();
+    LEDController::setState(true, false);
+    TEST_ASSERT_TRUE(LEDController::getMode() == Mode::CUSTOM);
+    TEST_ASSERT_EQUAL_UINT32(1, LEDController::pattern(Mode::CUSTOM).count);
+    checkTimeline(LEDController::pattern(Mode::CUSTOM), startUs);
+    TEST_ASSERT_EQUAL_UINT32(toDuty(255), hostsim::ledcDuty(LED_D4_PIN));
+    TEST_ASSERT_EQUAL_UINT32(0, hostsim::ledcDuty(LED_D5_PIN));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_off);
+    RUN_TEST(test_on);
+    RUN_TEST(test_slow_blink);
+    RUN_TEST(test_fast_blink);
+    RUN_TEST(test_alternate);
+    RUN_TEST(test_heartbeat);
+    RUN_TEST(test_switch_restarts_pattern);
+    RUN_TEST(test_custom_blink);
+    RUN_TEST(test_custom_alternate);
+    RUN_TEST(test_custom_state);
+    return UNITY_END();
+}
@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <host_sim.h>
+#include "../../include/motion_engine.h"
+
+// 移动段的来源调度：规划器与模式策略按权重分享移动段，任一方权重为 0 时只用另一方
+
+typedef MotionEngine::Source Source;
+
+struct Schedule {
+    uint32_t segments[2];       // 按来源统计的移动段
+    uint32_t patternChanges;
+    uint32_t badRadius;         // 来自模式策略的一段开始时幅度不在 500~1500 计数/秒内
+};
+
+// 以 10ms 为步长运行 1 小时
+static Schedule run(MotionEngine &engine)
+{
+    Schedule result = {};
+    engine.seed(12345);
+    engine.reset(0);
+    result.segments[(int)engine.state().source]++;
+    for (uint32_t i = 1; i <= 360000; i++)
+    {
+        MotionEngine::Report report = engine.step(i * 10000);
+        const MotionEngine::State &state = engine.state();
+        result.patternChanges += (report.events & MotionEngine::EVENT_PATTERN_CHANGED) != 0;
+        if (report.events & MotionEngine::EVENT_MOVE_STARTED)
+        {
+            result.segments[(int)state.source]++;
+            bool inRange = state.radius >= 500 * fixed::Q16_ONE && state.radius <= 1500 * fixed::Q16_ONE;
+            result.badRadius += state.source == Source::PATTERN && !inRange;
+        }
+    }
+    return result;
+}
+
+static void onlyPlanner(MotionEngine &engine)
+{
+    for (size_t i = 0; i < ActivePatterns::COUNT; i++)
+    {
+        engine.setPatternWeight(engine.patterns().id(i), 0);
+    }
+}
+
+void setUp()
+{
+    hostsim::reset();
+}
+
+void tearDown() {}
+
+// 默认配置：两种来源都会出现，规划器的段数占比接近 plannerWeight / 总权重
+static void test_default_mixes_planner_and_patterns()
+{
+    MotionEngine engine;
+    Schedule result = run(engine);
+    uint32_t total = result.segments[0] + result.segments[1];
+    double expected = (double)engine.config().plannerWeight /
+                      (engine.config().plannerWeight + engine.patterns().totalWeight());
+    TEST_ASSERT_GREATER_THAN(500, total);
+    TEST_ASSERT_FLOAT_WITHIN(0.06, expected, (double)result.segments[(int)Source::PLANNER] / total);
+    TEST_ASSERT_EQUAL_UINT32(0, result.badRadius);
+}
+
+// plannerWeight 为 0：只用模式策略
+static void test_zero_planner_weight_uses_patterns_only()
+{
+    MotionEngine::Config config;
+    config.plannerWeight = 0;
+    MotionEngine engine(config);
+    Schedule result = run(engine);
+    TEST_ASSERT_EQUAL_UINT32(0, result.segments[(int)Source::PLANNER]);
+    TEST_ASSERT_GREATER_THAN(500, result.segments[(int)Source::PATTERN]);
+    TEST_ASSERT_GREATER_THAN(0, result.patternChanges);
+}
+
+// 模式权重全为 0：每段都由规划器提供，没有模式切换
+static void test_zero_pattern_weights_use_planner_only()
+{
+    MotionEngine engine;
+    onlyPlanner(engine);
+    Schedule result = run(engine);
+    TEST_ASSERT_EQUAL_UINT32(0, result.segments[(int)Source::PATTERN]);
+    TEST_ASSERT_GREATER_THAN(500, result.segments[(int)Source::PLANNER]);
+    TEST_ASSERT_EQUAL_UINT32(0, result.patternChanges);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_default_mixes_planner_and_patterns);
+    RUN_TEST(test_zero_planner_weight_uses_patterns_only);
+    RUN_TEST(test_zero_pattern_weights_use_planner_only);
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+#include "../../include/report_pipeline.h"
+
+// 报告整形：链路持续拥塞时待发位移不会溢出，停止后不会拖出积压的移动
+
+typedef ReportPipeline::RateMode RateMode;
+
+// 每 failEvery 次 notify() 失败一次，记录成功发送的报告
+struct Link {
+    uint32_t calls;
+    uint32_t failEvery;
+    int32_t minDx;
+    int32_t maxDx;
+    uint32_t moving;   // 成功发送的非零报告
+};
+
+static bool lossySend(const uint8_t *report, size_t length, void *context)
+{
+    Link *link = (Link *)context;
+    TEST_ASSERT_EQUAL_UINT32(4, length);
+    if (link->failEvery && ++link->calls % link->failEvery == 0)
+    {
+        return false;
+    }
+    int32_t dx = (int8_t)report[1];
+    link->minDx = dx < link->minDx ? dx : link->minDx;
+    link->maxDx = dx > link->maxDx ? dx : link->maxDx;
+    link->moving += report[1] != 0 || report[2] != 0;
+    return true;
+}
+
+static Link link;
+
+void setUp()
+{
+    link = Link();
+    link.minDx = 127;
+    link.maxDx = -127;
+}
+
+void tearDown() {}
+
+// 25Hz 档位，每 40ms 提交 dx=60，每 4 次 notify() 失败 1 次：退避后发送间隔变长，
+// 每个间隔的位移超过一份报告，原先的 int16 待发量持续累积直至回绕成反向移动
+static void test_sustained_backoff_does_not_wrap()
+{
+    link.failEvery = 4;
+    ReportPipeline pipeline(lossySend, &link);
+    pipeline.setRateMode(RateMode::HZ_25);
+    uint32_t nowUs = 0;
+    for (uint32_t i = 0; i < 15 * 60 * 25; i++)   // 15 分钟
+    {
+        nowUs += 40000;
+        pipeline.submit(60, 0, nowUs);
+    }
+    TEST_ASSERT_GREATER_THAN(0, pipeline.backoffLevel());
+    TEST_ASSERT_GREATER_THAN(0, pipeline.stats().failed);
+    TEST_ASSERT_GREATER_THAN(0, pipeline.stats().discarded);
+    TEST_ASSERT_GREATER_THAN(0, link.minDx);
+    TEST_ASSERT_LESS_OR_EQUAL(127, link.maxDx);
+}
+
+// 停止提交位移后待发量在一份报告内：最多再发送一份移动报告（失败时重发），随后是释放报告
+static void test_stop_drains_within_one_report()
+{
+    link.failEvery = 4;
+    ReportPipeline pipeline(lossySend, &link);
+    pipeline.setRateMode(RateMode::HZ_25);
+    uint32_t nowUs = 0;
+    for (uint32_t i = 0; i < 60 * 25; i++)
+    {
+        nowUs += 40000;
+        pipeline.submit(60, 0, nowUs);
+    }
+    uint32_t moving = link.moving;
+    for (uint32_t i = 0; i < 10 * 25; i++)
+    {
+        nowUs += 40000;
+        pipeline.submit(0, 0, nowUs);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(moving + 1, link.moving);
+    TEST_ASSERT_EQUAL_INT(0, link.minDx < 0);
+}
+
+// 链路通畅时合并后的位移全部送达，不丢弃
+static void test_no_discard_on_clear_link()
+{
+    ReportPipeline pipeline(lossySend, &link);
+    pipeline.setRateMode(RateMode::HZ_25);
+    uint32_t nowUs = 0;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        nowUs += 10000;
+        pipeline.submit(30, -30, nowUs);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline.stats().discarded);
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline.stats().failed);
+    TEST_ASSERT_EQUAL_INT(120, link.maxDx);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sustained_backoff_does_not_wrap);
+    RUN_TEST(test_stop_drains_within_one_report);
+    RUN_TEST(test_no_discard_on_clear_link);
+    return UNITY_END();
+}
@@ -0,0 +1,289 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "../../src/state_machine.h"
+#include "../../include/app_tasks.h"
+#include "../../include/event_queue.h"
+#include "../../include/logger.h"
+#include "../../include/settings_store.h"
+
+// 持久化设置：NVS 替身以文件为后备，hostsim::reset() 后从文件重新加载，相当于断电重启；
+// 检查记录的编解码、推迟合并的写入，以及按键切换后断电重启能恢复状态
+
+typedef ReportPipeline::RateMode RateMode;
+
+static std::string nvsFilePath()
+{
+    const char *dir = getenv("TMPDIR");
+    return std::string(dir && *dir ? dir : "/tmp") + "/ble_mouse_test_nvs.bin";
+}
+
+// 推进到最后一次修改 COMMIT_DELAY_MS 之后，由 update() 写入
+static void commitPending()
+{
+    hostsim::advanceMillis(SettingsStore::COMMIT_DELAY_MS);
+    SettingsStore::update(millis());
+}
+
+static void powerCycle()
+{
+    hostsim::reset();
+    SettingsStore::begin();
+    Logger::drain();
+}
+
+// 每个用例从空的 NVS 文件开始
+void setUp()
+{
+    remove(nvsFilePath().c_str());
+    hostsim::setNvsFile(nvsFilePath().c_str());
+    hostsim::reset();
+    SettingsStore::resetStats();
+}
+
+void tearDown()
+{
+    hostsim::disconnect();
+    AppTasks::setReportRate(RateMode::HZ_100);
+    hostsim::setNvsFile(nullptr);
+    hostsim::reset();
+    remove(nvsFilePath().c_str());
+    Logger::drain();
+}
+
+static void test_defaults_without_record()
+{
+    TEST_ASSERT_FALSE(SettingsStore::begin());
+    SettingsStore::Record record = SettingsStore::encode(SettingsStore::settings());
+    SettingsStore::Record defaults = SettingsStore::encode(SettingsStore::defaults());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&record, &defaults, sizeof(record)));
+    Logger::drain();
+}
+
+static void test_round_trip_after_power_loss()
+{
+    SettingsStore::begin();
+    SettingsStore::setMotionEnabled(true);
+    SettingsStore::setReportRate(RateMode::HZ_50);
+    commitPending();
+    TEST_ASSERT_FALSE(SettingsStore::pending());
+
+    powerCycle();
+    TEST_ASSERT_EQUAL_UINT32(1, SettingsStore::stats().loads);
+    TEST_ASSERT_TRUE(SettingsStore::settings().motionEnabled);
+    TEST_ASSERT_TRUE(SettingsStore::settings().reportRate == RateMode::HZ_50);
+}
+
+// 编码后再解码得到同样的记录
+static void test_record_round_trip()
+{
+    SettingsStore::Settings settings = SettingsStore::defaults();
+    settings.motionEnabled = true;
+    settings.reportRate = RateMode::HZ_50;
+    settings.motion.plannerWeight = 0;
+    SettingsStore::Record record = SettingsStore::encode(settings);
+    SettingsStore::Settings decoded;
+    TEST_ASSERT_TRUE(SettingsStore::decode(record, decoded));
+    SettingsStore::Record again = SettingsStore::encode(decoded);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&record, &again, sizeof(record)));
+    TEST_ASSERT_EQUAL_UINT32(0, decoded.motion.plannerWeight);
+}
+
+// 版本不符、未知标志位或参数越界的记录被丢弃
+static void test_invalid_records_rejected()
+{
+    SettingsStore::Settings decoded;
+    SettingsStore::Record valid = SettingsStore::encode(SettingsStore::defaults());
+
+    SettingsStore::Record record = valid;
+    record.version = SettingsStore::VERSION + 1;
+    TEST_ASSERT_FALSE(SettingsStore::decode(record, decoded));
+    record = valid;
+    record.flags |= 0x80;
+    TEST_ASSERT_FALSE(SettingsStore::decode(record, decoded));
+    record = valid;
+    record.reportRate = (uint8_t)RateMode::COUNT;
+    TEST_ASSERT_FALSE(SettingsStore::decode(record, decoded));
+    record = valid;
+    record.maxSpeed = 0;
+    TEST_ASSERT_FALSE(SettingsStore::decode(record, decoded));
+    record = valid;
+    record.minMoveMs = record.maxMoveMs + 1;
+    TEST_ASSERT_FALSE(SettingsStore::decode(record, decoded));
+}
+
+// 修改推迟 COMMIT_DELAY_MS 写入，期间断电会丢失
+static void test_commit_deferred()
+{
+    SettingsStore::begin();
+    uint32_t writes = hostsim::nvsWriteCount();
+    SettingsStore::setMotionEnabled(true);
+    TEST_ASSERT_TRUE(SettingsStore::pending());
+    TEST_ASSERT_EQUAL_UINT32(SettingsStore::COMMIT_DELAY_MS, SettingsStore::msUntilCommit(millis(), 60000));
+
+    hostsim::advanceMillis(SettingsStore::COMMIT_DELAY_MS - 1);
+    SettingsStore::update(millis());
+    TEST_ASSERT_TRUE(SettingsStore::pending());
+    TEST_ASSERT_EQUAL_UINT32(writes, hostsim::nvsWriteCount());
+
+    hostsim::advanceMillis(1);
+    SettingsStore::update(millis());
+    TEST_ASSERT_FALSE(SettingsStore::pending());
+    TEST_ASSERT_EQUAL_UINT32(writes + 1, hostsim::nvsWriteCount());
+}
+
+// 改回已保存的值：到期时与记录相同，跳过写入
+static void test_toggle_back_skips_write()
+{
+    SettingsStore::begin();
+    SettingsStore::setMotionEnabled(true);
+    commitPending();
+    uint32_t writes = hostsim::nvsWriteCount();
+    SettingsStore::setMotionEnabled(false);
+    SettingsStore::setMotionEnabled(true);
+    commitPending();
+    TEST_ASSERT_EQUAL_UINT32(writes, hostsim::nvsWriteCount());
+    TEST_ASSERT_EQUAL_UINT32(1, SettingsStore::stats().skipped);
+}
+
+// 不停修改时最迟在第一次修改 MAX_COMMIT_DELAY_MS 后写入
+static void test_max_commit_delay()
+{
+    SettingsStore::begin();
+    uint32_t writes = hostsim::nvsWriteCount();
+    uint32_t firstMs = millis();
+    bool enabled = false;
+    while (hostsim::nvsWriteCount() == writes)
+    {
+        TEST_ASSERT_LESS_OR_EQUAL(SettingsStore::MAX_COMMIT_DELAY_MS, millis() - firstMs);
+        enabled = !enabled;
+        SettingsStore::setReportRate(enabled ? RateMode::HZ_50 : RateMode::HZ_100);
+        hostsim::advanceMillis(1000);
+        SettingsStore::update(millis());
+    }
+    TEST_ASSERT_EQUAL_UINT32(SettingsStore::MAX_COMMIT_DELAY_MS, millis() - firstMs);
+}
+
+// 已连接时按设备上的调度运行固件：每 presses 次短按为一轮，每分钟一轮，共 10 分钟；
+// 返回修改到写入之间的最长时间，结束时等待写入完成
+static uint32_t runPresses(uint8_t presses, uint16_t pressGapMs)
+{
+    const uint32_t runMs = 600000;
+    uint64_t startUs = hostsim::nowMicros();
+    uint64_t endUs = startUs + (runMs + SettingsStore::MAX_COMMIT_DELAY_MS + 1000) * 1000ull;
+    uint64_t pendingSinceUs = 0;
+    uint32_t maxUnsavedMs = 0;
+    while (hostsim::nowMicros() < endUs)
+    {
+        uint64_t elapsedMs = (hostsim::nowMicros() - startUs) / 1000;
+        uint32_t inMinuteMs = elapsedMs % 60000;
+        if (elapsedMs < runMs && inMinuteMs % pressGapMs == 0 && inMinuteMs / pressGapMs < presses)
+        {
+            EventQueue::post(EventQueue::EventId::BOOT_SHORT_PRESS);
+        }
+        AppTasks::housekeepingStep(0);
+        if (elapsedMs % 10 == 0)
+        {
+            AppTasks::motionStep();
+        }
+        Logger::drain();
+
+        if (SettingsStore::pending() && !pendingSinceUs)
+        {
+            pendingSinceUs = hostsim::nowMicros();
+        }
+        else if (!SettingsStore::pending() && pendingSinceUs)
+        {
+            uint32_t unsavedMs = (uint32_t)((hostsim::nowMicros() - pendingSinceUs) / 1000);
+            maxUnsavedMs = unsavedMs > maxUnsavedMs ? unsavedMs : maxUnsavedMs;
+            pendingSinceUs = 0;
+        }
+        hostsim::advanceMillis(1);
+    }
+    return maxUnsavedMs;
+}
+
+static void startConnected()
+{
+    setup();
+    hostsim::connect();
+    AppTasks::housekeepingStep(0);
+    Logger::drain();
+    SettingsStore::resetStats();
+}
+
+// 每分钟连按 5 次：每轮只写入一次，断电重启后恢复最后的开关状态（共 50 次切换，最后为关闭）
+static void test_burst_toggles_coalesced()
+{
+    startConnected();
+    uint32_t writes = hostsim::nvsWriteCount();
+    uint32_t maxUnsavedMs = runPresses(5, 400);
+    SettingsStore::Stats stats = SettingsStore::stats();
+    TEST_ASSERT_EQUAL_UINT32(50, stats.changes);
+    TEST_ASSERT_EQUAL_UINT32(10, hostsim::nvsWriteCount() - writes);
+    TEST_ASSERT_LESS_OR_EQUAL(SettingsStore::MAX_COMMIT_DELAY_MS, maxUnsavedMs);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<MouseMotionDisable>());
+
+    hostsim::reset();
+    startConnected();
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<MouseMotionDisable>());
+}
+
+// 每 2 秒切换一次：COMMIT_DELAY_MS 内总有新的修改，由 MAX_COMMIT_DELAY_MS 限制未保存的时间
+static void test_fidget_bounded_by_max_delay()
+{
+    startConnected();
+    uint32_t writes = hostsim::nvsWriteCount();
+    uint32_t maxUnsavedMs = runPresses(30, 2000);
+    SettingsStore::Stats stats = SettingsStore::stats();
+    TEST_ASSERT_EQUAL_UINT32(300, stats.changes);
+    TEST_ASSERT_LESS_OR_EQUAL(600000 / SettingsStore::MAX_COMMIT_DELAY_MS + 1, hostsim::nvsWriteCount() - writes);
+    TEST_ASSERT_LESS_OR_EQUAL(SettingsStore::MAX_COMMIT_DELAY_MS, maxUnsavedMs);
+    bool motion = BleMouseState::is_in_state<MouseMotionEnable>();
+
+    hostsim::reset();
+    startConnected();
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<MouseMotionEnable>() == motion);
+}
+
+// 已连接时双击切换报告速率：写入后断电重启，恢复同一档位
+static void test_report_rate_restored()
+{
+    startConnected();
+    EventQueue::post(EventQueue::EventId::BOOT_DOUBLE_CLICK);
+    EventQueue::post(EventQueue::EventId::BOOT_DOUBLE_CLICK);
+    AppTasks::housekeepingStep(0);
+    RateMode rate = AppTasks::reportRate();
+    TEST_ASSERT_TRUE(rate != RateMode::HZ_100);
+    for (uint32_t ms = 0; ms <= SettingsStore::COMMIT_DELAY_MS; ms += 100)
+    {
+        hostsim::advanceMillis(100);
+        AppTasks::housekeepingStep(0);
+    }
+    TEST_ASSERT_FALSE(SettingsStore::pending());
+
+    hostsim::reset();
+    AppTasks::setReportRate(RateMode::HZ_100);
+    startConnected();
+    TEST_ASSERT_TRUE(AppTasks::reportRate() == rate);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_without_record);
+    RUN_TEST(test_round_trip_after_power_loss);
+    RUN_TEST(test_record_round_trip);
+    RUN_TEST(test_invalid_records_rejected);
+    RUN_TEST(test_commit_deferred);
+    RUN_TEST(test_toggle_back_skips_write);
+    RUN_TEST(test_max_commit_delay);
+    RUN_TEST(test_burst_toggles_coalesced);
+    RUN_TEST(test_fidget_bounded_by_max_delay);
+    RUN_TEST(test_report_rate_restored);
+    return UNITY_END();
+}
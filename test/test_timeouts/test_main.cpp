@@ -0,0 +1,120 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <host_sim.h>
+#include "../../src/state_machine.h"
+#include "../../include/app_tasks.h"
+#include "../../include/event_queue.h"
+#include "../../include/logger.h"
+#include "../../include/timer_service.h"
+
+// 状态超时：在虚拟时间中快进经过重连窗口、配对超时、配对中连接和断开重连，逐项检查状态和定时器
+
+typedef TimerService::TimerId TimerId;
+typedef EventQueue::EventId EventId;
+
+// 以 100ms 为步长推进虚拟时间，每步由后台任务分发到期事件
+static void runForMs(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += 100)
+    {
+        hostsim::advanceMillis(ms - elapsed < 100 ? ms - elapsed : 100);
+        AppTasks::housekeepingStep(0);
+    }
+    Logger::drain();
+}
+
+static uint32_t dispatched(EventId id)
+{
+    return EventQueue::stats().events[(int)id].dispatched;
+}
+
+static void postAndDispatch(EventId id)
+{
+    EventQueue::post(id);
+    AppTasks::housekeepingStep(0);
+    Logger::drain();
+}
+
+// 每个用例从刚启动的固件开始：InitComplete -> Reconnect
+void setUp()
+{
+    hostsim::reset();
+    setup();
+    EventQueue::resetStats();
+    TimerService::resetStats();
+    Logger::drain();
+}
+
+void tearDown()
+{
+    EventQueue::clear();
+    Logger::drain();
+}
+
+// Reconnect：每 30 秒一个重连窗口，超时后重新计时，不离开 Reconnect
+static void test_reconnect_window_rearms()
+{
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_TRUE(TimerService::active(TimerId::RECONNECT_TIMEOUT));
+    runForMs(29900);
+    TEST_ASSERT_EQUAL_UINT32(0, dispatched(EventId::CONNECTION_TIMEOUT));
+    runForMs(200);
+    TEST_ASSERT_EQUAL_UINT32(1, dispatched(EventId::CONNECTION_TIMEOUT));
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_GREATER_THAN(29000, TimerService::remainingMs(TimerId::RECONNECT_TIMEOUT));
+    runForMs(90000);
+    TEST_ASSERT_EQUAL_UINT32(4, dispatched(EventId::CONNECTION_TIMEOUT));
+}
+
+// Pairing：离开 Reconnect 取消重连定时器，60 秒未连接回到 Reconnect
+static void test_pairing_timeout_returns_to_reconnect()
+{
+    postAndDispatch(EventId::BOOT_LONG_PRESS);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_FALSE(TimerService::active(TimerId::RECONNECT_TIMEOUT));
+    TEST_ASSERT_TRUE(TimerService::active(TimerId::PAIRING_TIMEOUT));
+    runForMs(TimerService::remainingMs(TimerId::PAIRING_TIMEOUT) - 500);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Pairing>());
+    runForMs(1000);
+    TEST_ASSERT_EQUAL_UINT32(1, dispatched(EventId::PAIRING_TIMEOUT));
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_TRUE(TimerService::active(TimerId::RECONNECT_TIMEOUT));
+}
+
+// 配对期间连接：配对定时器被取消，之后不再产生超时事件
+static void test_connect_cancels_timeouts()
+{
+    postAndDispatch(EventId::BOOT_LONG_PRESS);
+    runForMs(10000);
+    hostsim::connect();
+    runForMs(100);
+    TEST_ASSERT_FALSE(BleMouseState::is_in_state<Pairing>());
+    TEST_ASSERT_FALSE(TimerService::active(TimerId::PAIRING_TIMEOUT));
+    TEST_ASSERT_FALSE(TimerService::active(TimerId::RECONNECT_TIMEOUT));
+    uint32_t pairingTimeouts = dispatched(EventId::PAIRING_TIMEOUT);
+    uint32_t reconnectTimeouts = dispatched(EventId::CONNECTION_TIMEOUT);
+    runForMs(120000);
+    TEST_ASSERT_EQUAL_UINT32(pairingTimeouts, dispatched(EventId::PAIRING_TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(reconnectTimeouts, dispatched(EventId::CONNECTION_TIMEOUT));
+}
+
+// 断开后回到 Reconnect 重新计时
+static void test_disconnect_rearms_reconnect()
+{
+    hostsim::connect();
+    runForMs(100);
+    hostsim::disconnect();
+    runForMs(100);
+    TEST_ASSERT_TRUE(BleMouseState::is_in_state<Reconnect>());
+    TEST_ASSERT_GREATER_THAN(29000, TimerService::remainingMs(TimerId::RECONNECT_TIMEOUT));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_reconnect_window_rearms);
+    RUN_TEST(test_pairing_timeout_returns_to_reconnect);
+    RUN_TEST(test_connect_cancels_timeouts);
+    RUN_TEST(test_disconnect_rearms_reconnect);
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+#include <unity.h>
+#include <string.h>
+#include <vector>
+#include "../../include/trajectory.h"
+#include "../../include/trajectory_player.h"
+
+// 轨迹格式与流式播放：编码后逐条解码得到原样本；记录区长度对 BLOCK_SIZE 取余为 1~9、
+// 每个块边界都被一条记录跨越时，播放器完整播放多遍且没有格式错误
+
+static const uint16_t UNIT_US = Trajectory::DEFAULT_UNIT_US;
+static const size_t BLOCK = TrajectoryPlayer::BLOCK_SIZE;
+
+struct Sample {
+    uint32_t timeUs;
+    int8_t dx;
+    int8_t dy;
+};
+
+struct Recording {
+    std::vector<Sample> samples;
+    uint32_t endUs;
+    std::vector<uint8_t> file;
+    std::vector<size_t> starts;   // 每条记录在记录区中的起始位置（含 END）
+};
+
+// 记录长度对应的 dt（时间单位数）：varint(dt << 2 | kind) 为 1/2/3 字节
+static uint32_t dtForVarint(size_t bytes)
+{
+    return bytes == 1 ? 1 : (bytes == 2 ? 32 : 4096);
+}
+
+// 构造记录区正好 length 字节、没有记录从块边界开始的录制：DELTA 为 3~5 字节，END 为 1~3 字节。
+// 相邻位移交替为 (1,-1)、(2,-2)，编码器不会合并为 REPEAT
+static bool plan(size_t length, Recording &recording)
+{
+    for (size_t endSize = 3; endSize >= 1; endSize--)
+    {
+        size_t endStart = length - endSize;
+        if (endStart % BLOCK == 0)
+        {
+            continue;
+        }
+        // reach[p]：从 0 到 p 可以由 3~5 字节的 DELTA 拼成且不从块边界开始（0 除外）时为到达 p 的记录长度
+        std::vector<uint8_t> reach(endStart + 1, 0);
+        reach[0] = 1;
+        for (size_t p = 0; p < endStart; p++)
+        {
+            if (!reach[p] || (p && p % BLOCK == 0))
+            {
+                continue;
+            }
+            for (size_t size = 3; size <= 5 && p + size <= endStart; size++)
+            {
+                reach[p + size] = reach[p + size] ? reach[p + size] : (uint8_t)size;
+            }
+        }
+        if (!reach[endStart])
+        {
+            continue;
+        }
+        std::vector<size_t> sizes;
+        for (size_t p = endStart; p > 0; p -= reach[p])
+        {
+            sizes.insert(sizes.begin(), reach[p]);
+        }
+        uint32_t units = 0;
+        size_t pos = 0;
+        for (size_t i = 0; i < sizes.size(); i++)
+        {
+            units += dtForVarint(sizes[i] - 2);
+            int8_t d = (int8_t)(1 + (i & 1));
+            Sample sample = {units * UNIT_US, d, (int8_t)-d};
+            recording.samples.push_back(sample);
+            recording.starts.push_back(pos);
+            pos += sizes[i];
+        }
+        recording.starts.push_back(pos);
+        recording.endUs = (units + dtForVarint(endSize)) * UNIT_US;
+        return true;
+    }
+    return false;
+}
+
+static Recording record(size_t length)
+{
+    Recording recording;
+    TEST_ASSERT_TRUE(plan(length, recording));
+    recording.file.resize(Trajectory::HEADER_SIZE + length + 16);
+    Trajectory::Encoder encoder(recording.file.data(), recording.file.size(), UNIT_US);
+    for (const Sample &sample : recording.samples)
+    {
+        encoder.add(sample.timeUs, sample.dx, sample.dy);
+    }
+    recording.file.resize(encoder.finish(recording.endUs));
+    TEST_ASSERT_TRUE(encoder.ok());
+    TEST_ASSERT_EQUAL_UINT32(Trajectory::HEADER_SIZE + length, recording.file.size());
+    TEST_ASSERT_EQUAL_UINT32(recording.samples.size(), encoder.stats().deltas);
+    return recording;
+}
+
+struct MemorySource {
+    const std::vector<uint8_t> *file;
+};
+
+static size_t readMemory(uint32_t offset, uint8_t *buffer, size_t length, void *context)
+{
+    const std::vector<uint8_t> &file = *((MemorySource *)context)->file;
+    if (offset + length > file.size())
+    {
+        return 0;
+    }
+    memcpy(buffer, file.data() + offset, length);
+    return length;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// 顺序解码：每条记录的位置、时间和位移与录制一致，END 正好结束在记录区末尾
+static void checkDecode(const Recording &recording)
+{
+    Trajectory::Header header;
+    TEST_ASSERT_TRUE(Trajectory::parseHeader(recording.file.data(), recording.file.size(), header));
+    TEST_ASSERT_EQUAL_UINT32(UNIT_US, header.unitUs);
+    const uint8_t *data = recording.file.data() + Trajectory::HEADER_SIZE;
+    size_t pos = 0;
+    uint32_t units = 0;
+    for (size_t i = 0; i <= recording.samples.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(recording.starts[i], pos);
+        Trajectory::Record decoded;
+        int used = Trajectory::decodeRecord(data + pos, header.length - pos, decoded);
+        TEST_ASSERT_GREATER_THAN(0, used);
+        pos += used;
+        units += decoded.dt;
+        if (i == recording.samples.size())
+        {
+            TEST_ASSERT_EQUAL_INT(Trajectory::END, decoded.kind);
+            TEST_ASSERT_EQUAL_UINT32(recording.endUs, units * UNIT_US);
+            break;
+        }
+        TEST_ASSERT_EQUAL_INT(Trajectory::DELTA, decoded.kind);
+        TEST_ASSERT_EQUAL_UINT32(recording.samples[i].timeUs, units * UNIT_US);
+        TEST_ASSERT_EQUAL_INT(recording.samples[i].dx, decoded.dx);
+        TEST_ASSERT_EQUAL_INT(recording.samples[i].dy, decoded.dy);
+    }
+    TEST_ASSERT_EQUAL_UINT32(header.length, pos);
+}
+
+// 播放三遍：每一步推进一个时间单位，每遍输出的位移之和等于录制的总和
+static void checkPlayback(const Recording &recording)
+{
+    int32_t expectedX = 0;
+    for (const Sample &sample : recording.samples)
+    {
+        expectedX += sample.dx;
+    }
+    MemorySource source = {&recording.file};
+    TrajectoryPlayer player;
+    TEST_ASSERT_TRUE(player.open(readMemory, &source, (uint32_t)recording.file.size()));
+    player.resume(0);
+    uint32_t nowUs = 0;
+    int32_t sumX = 0;
+    int32_t sumY = 0;
+    uint32_t loops = 0;
+    for (uint32_t i = 0; loops < 3 && i < 3 * (recording.endUs / UNIT_US + 10); i++)
+    {
+        nowUs += UNIT_US;
+        TrajectoryPlayer::Output output = player.step(nowUs);
+        sumX += output.dx;
+        sumY += output.dy;
+        if (player.stats().loops != loops)
+        {
+            loops = player.stats().loops;
+            TEST_ASSERT_EQUAL_INT(expectedX * (int32_t)loops, sumX);
+            TEST_ASSERT_EQUAL_INT(-sumX, sumY);
+        }
+        player.fill();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, player.stats().formatErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, player.stats().underruns);
+    TEST_ASSERT_EQUAL_UINT32(3, player.stats().loops);
+    TEST_ASSERT_EQUAL_UINT32(3 * (recording.samples.size() + 1), player.stats().records);
+}
+
+static void roundTrip(size_t blocks)
+{
+    for (size_t tail = 1; tail <= Trajectory::MAX_RECORD_SIZE - 1; tail++)
+    {
+        Recording recording = record(blocks * BLOCK + tail);
+        for (size_t boundary = BLOCK; boundary <= blocks * BLOCK; boundary += BLOCK)
+        {
+            // 没有记录从边界开始：边界落在一条记录中间
+            for (size_t start : recording.starts)
+            {
+                TEST_ASSERT_TRUE(start != boundary);
+            }
+        }
+        checkDecode(recording);
+        checkPlayback(recording);
+    }
+}
+
+// 记录区 257~265 字节：最后一块只有 1~9 字节，跨越边界的记录（含 END）结束在最后一块中
+static void test_round_trip_two_blocks()
+{
+    roundTrip(1);
+}
+
+// 记录区 513~521 字节：两个块边界都被记录跨越
+static void test_round_trip_three_blocks()
+{
+    roundTrip(2);
+}
+
+// END 之后还有数据是格式错误：播放停止，不会把多余的字节当成下一遍
+static void test_trailing_bytes_rejected()
+{
+    Recording recording = record(BLOCK + 4);
+    std::vector<uint8_t> file = recording.file;
+    file.push_back(0x04);   // dt=1 的 DELTA 的开头
+    file.push_back(1);
+    file.push_back(1);
+    Trajectory::Header header;
+    TEST_ASSERT_TRUE(Trajectory::parseHeader(file.data(), file.size(), header));
+    header.length = (uint32_t)(file.size() - Trajectory::HEADER_SIZE);
+    Trajectory::writeHeader(header, file.data());
+    MemorySource source = {&file};
+    TrajectoryPlayer player;
+    TEST_ASSERT_TRUE(player.open(readMemory, &source, (uint32_t)file.size()));
+    player.resume(0);
+    uint32_t nowUs = 0;
+    for (uint32_t i = 0; i < 2 * recording.endUs / UNIT_US; i++)
+    {
+        nowUs += UNIT_US;
+        player.step(nowUs);
+        player.fill();
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, player.stats().formatErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, player.stats().loops);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_two_blocks);
+    RUN_TEST(test_round_trip_three_blocks);
+    RUN_TEST(test_trailing_bytes_rejected);
+    return UNITY_END();
+}
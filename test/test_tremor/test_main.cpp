@@ -0,0 +1,158 @@
+#include <unity.h>
+#include <host_sim.h>
+#include <math.h>
+#include <vector>
+#include "../../include/fixed_point.h"
+#include "../../include/tremor.h"
+
+// 手部抖动：按 100Hz 采样 10 分钟，检查平滑（自相关）、两轴独立、带限（频谱）和幅度
+
+static const uint32_t PERIOD_US = 10000;
+static const size_t COUNT = 60000;
+
+struct Signal {
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+static Signal sample(float frequency, uint32_t seed)
+{
+    Tremor::Config config;
+    config.frequency = frequency;
+    Tremor tremor(config);
+    tremor.seed(seed);
+    Signal signal;
+    signal.x.resize(COUNT);
+    signal.y.resize(COUNT);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        Tremor::Sample s = tremor.step(PERIOD_US);
+        signal.x[i] = fixed::q16ToFloat(s.x);
+        signal.y[i] = fixed::q16ToFloat(s.y);
+    }
+    return signal;
+}
+
+static double autocorrelation(const std::vector<double> &x, size_t lag)
+{
+    double sum = 0, energy = 0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        energy += x[i] * x[i];
+        if (i + lag < x.size())
+        {
+            sum += x[i] * x[i + lag];
+        }
+    }
+    return energy > 0 ? sum / energy : 0;
+}
+
+// 4096 点 DFT 中高于 limitHz 的能量占比
+static double powerAbove(const std::vector<double> &x, double limitHz)
+{
+    const size_t window = 4096;
+    const double sampleRate = 1e6 / PERIOD_US;
+    double low = 0, high = 0;
+    for (size_t k = 1; k < window / 2; k++)
+    {
+        double re = 0, im = 0;
+        for (size_t n = 0; n < window; n++)
+        {
+            double angle = 2 * M_PI * k * n / window;
+            re += x[n] * cos(angle);
+            im -= x[n] * sin(angle);
+        }
+        double power = re * re + im * im;
+        (k * sampleRate / window > limitHz ? high : low) += power;
+    }
+    return high / (low + high);
+}
+
+void setUp()
+{
+    hostsim::reset();
+}
+
+void tearDown() {}
+
+// 相邻采样高度相关：白噪声的 r(1) 约为 0
+static void checkSmooth(float frequency)
+{
+    Signal signal = sample(frequency, 12345);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 1.0, autocorrelation(signal.x, 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 1.0, autocorrelation(signal.y, 1));
+}
+
+static void test_smooth_3hz() { checkSmooth(3.0f); }
+static void test_smooth_6hz() { checkSmooth(6.0f); }
+static void test_smooth_12hz() { checkSmooth(12.0f); }
+
+// 能量集中在晶格频率附近及以下：高于 2 倍晶格频率的不超过 5%
+static void checkBandLimited(float frequency)
+{
+    Signal signal = sample(frequency, 12345);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 0.0, powerAbove(signal.x, 2 * frequency));
+}
+
+static void test_band_limited_3hz() { checkBandLimited(3.0f); }
+static void test_band_limited_6hz() { checkBandLimited(6.0f); }
+static void test_band_limited_12hz() { checkBandLimited(12.0f); }
+
+// 两个轴使用不同的种子，互相关接近 0
+static void test_axes_uncorrelated()
+{
+    Signal signal = sample(6.0f, 12345);
+    double cross = 0, energyX = 0, energyY = 0;
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        cross += signal.x[i] * signal.y[i];
+        energyX += signal.x[i] * signal.x[i];
+        energyY += signal.y[i] * signal.y[i];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 0.0, cross / sqrt(energyX * energyY));
+}
+
+// 峰值不超过配置的幅度，且不是恒为 0
+static void test_peak_within_amplitude()
+{
+    Tremor::Config config;
+    Signal signal = sample(config.frequency, 12345);
+    double peak = 0;
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        peak = fabs(signal.x[i]) > peak ? fabs(signal.x[i]) : peak;
+        peak = fabs(signal.y[i]) > peak ? fabs(signal.y[i]) : peak;
+    }
+    TEST_ASSERT_TRUE(peak <= config.amplitude);
+    TEST_ASSERT_TRUE(peak > config.amplitude / 4);
+}
+
+// 相同的种子得到相同的序列，不同的种子不同
+static void test_seed_repeats()
+{
+    Signal a = sample(6.0f, 777);
+    Signal b = sample(6.0f, 777);
+    Signal c = sample(6.0f, 778);
+    size_t differ = 0;
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(a.x[i] == b.x[i] && a.y[i] == b.y[i]);
+        differ += a.x[i] != c.x[i];
+    }
+    TEST_ASSERT_GREATER_THAN(COUNT / 2, differ);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_smooth_3hz);
+    RUN_TEST(test_smooth_6hz);
+    RUN_TEST(test_smooth_12hz);
+    RUN_TEST(test_band_limited_3hz);
+    RUN_TEST(test_band_limited_6hz);
+    RUN_TEST(test_band_limited_12hz);
+    RUN_TEST(test_axes_uncorrelated);
+    RUN_TEST(test_peak_within_amplitude);
+    RUN_TEST(test_seed_repeats);
+    return UNITY_END();
+}